@@ -0,0 +1,71 @@
+package com.cthulhu;
+
+/**
+ * open addressing string table keyed on slices of a char array,
+ * a string is only created the first time a name is seen
+ */
+public class Interner {
+    String[] names = new String[256];
+    int[] hashes = new int[256];
+    int count = 0;
+
+    static int hash(char[] buf, int off, int len) {
+        int h = 0;
+        for (int i = 0; i < len; i++)
+            h = 31 * h + buf[off + i];
+        return h;
+    }
+
+    static boolean same(String name, char[] buf, int off, int len) {
+        if (name.length() != len)
+            return false;
+
+        for (int i = 0; i < len; i++)
+            if (name.charAt(i) != buf[off + i])
+                return false;
+
+        return true;
+    }
+
+    public String intern(char[] buf, int off, int len) {
+        int h = hash(buf, off, len);
+        int mask = names.length - 1;
+        int i = h & mask;
+
+        while (names[i] != null) {
+            if (hashes[i] == h && same(names[i], buf, off, len))
+                return names[i];
+            i = (i + 1) & mask;
+        }
+
+        String name = new String(buf, off, len);
+        names[i] = name;
+        hashes[i] = h;
+
+        if (++count * 2 > names.length)
+            grow();
+
+        return name;
+    }
+
+    void grow() {
+        String[] oldNames = names;
+        int[] oldHashes = hashes;
+
+        names = new String[oldNames.length * 2];
+        hashes = new int[oldNames.length * 2];
+
+        int mask = names.length - 1;
+        for (int i = 0; i < oldNames.length; i++) {
+            if (oldNames[i] == null)
+                continue;
+
+            int j = oldHashes[i] & mask;
+            while (names[j] != null)
+                j = (j + 1) & mask;
+
+            names[j] = oldNames[i];
+            hashes[j] = oldHashes[i];
+        }
+    }
+}
@@ -4,36 +4,92 @@ import com.cthulhu.tokens.*;
 
 import java.io.IOException;
 import java.io.Reader;
+import java.io.StringReader;
 import java.math.BigInteger;
-import java.util.function.Function;
 
 public class Lexer {
+    public enum Kind {
+        EOF, IDENT, INT, KEY, STRING, INVALID
+    }
+
+    interface CharClass {
+        boolean test(char c);
+    }
+
+    static final int WINDOW = 0x4000;
+
     public Lexer(Reader source) {
         this.in = source;
-        this.ahead = read();
+    }
+
+    /* the C lexer when libctjni is on java.library.path, this one otherwise */
+    public static Lexer open(String text) {
+        return NativeLexer.AVAILABLE ? new NativeLexer(text) : new Lexer(new StringReader(text));
     }
 
     Reader in;
-    char ahead;
 
-    char read() {
+    /* source window, buf[mark..end) is kept across refills */
+    char[] buf = new char[WINDOW];
+    int mark = 0;
+    int pos = 0;
+    int end = 0;
+    boolean eof = false;
+
+    Interner names = new Interner();
+
+    /* the current token, only valid until the next call to advance */
+    Kind kind;
+    String ident;
+    long value;
+    BigInteger big;
+    Key key;
+    String error;
+
+    boolean refill() {
+        if (eof)
+            return false;
+
+        int keep = end - mark;
+        if (mark == 0 && end == buf.length) {
+            char[] grown = new char[buf.length * 2];
+            System.arraycopy(buf, 0, grown, 0, keep);
+            buf = grown;
+        } else {
+            System.arraycopy(buf, mark, buf, 0, keep);
+        }
+
+        pos -= mark;
+        end = keep;
+        mark = 0;
+
         try {
-            int temp = in.read();
-            return (temp == -1) ? 0 : (char)temp;
+            int n = in.read(buf, end, buf.length - end);
+            if (n <= 0) {
+                eof = true;
+                return false;
+            }
+            end += n;
+            return true;
         } catch (IOException err) {
-            return 0;
+            eof = true;
+            return false;
         }
     }
 
-    char get() {
-        char c = ahead;
-        ahead = read();
+    char peek() {
+        if (pos == end && !refill())
+            return 0;
 
-        return c;
+        return buf[pos];
     }
 
-    char peek() {
-        return ahead;
+    char get() {
+        char c = peek();
+        if (pos < end)
+            pos++;
+
+        return c;
     }
 
     boolean eat(char c) {
@@ -44,26 +100,32 @@ public class Lexer {
         return false;
     }
 
+    static boolean isNewline(char c) {
+        return c == '\n' || c == '\r';
+    }
+
+    /* skip whitespace and comments, a # starts a comment anywhere like the C lexer */
     char skip() {
-        char c = get();
+        while (true) {
+            mark = pos;
+            char c = get();
 
-        while (Character.isWhitespace(c)) {
-            c = get();
+            if (c == '#') {
+                while (c != 0 && !isNewline(c)) {
+                    mark = pos;
+                    c = get();
+                }
+            }
 
-            if (c == '#')
-                do { c = get(); } while (c != 0 && !System.lineSeparator().contains(Character.toString(c)));
+            if (c == 0 || !Character.isWhitespace(c))
+                return c;
         }
-        
-        return c;
     }
 
-    String collect(char init, Function<Character, Boolean> func) {
-        String out = init == 0 ? "" : Character.toString(init);
-        
-        while (func.apply(peek())) 
-            out += get();
-
-        return out;
+    /* consume everything matching func, the text is buf[mark..pos) */
+    void collect(CharClass func) {
+        while (func.test(peek()))
+            get();
     }
 
     static boolean isIdent1(char c) {
@@ -75,73 +137,160 @@ public class Lexer {
     }
 
     static boolean isXDigit(char c) {
-        return Character.isDigit(c) || ('a' <= c && c >= 'f') || ('A' <= c && c >= 'F');
+        return Character.isDigit(c) || ('a' <= c && c <= 'f') || ('A' <= c && c <= 'F');
+    }
+
+    static boolean isBinary(char c) {
+        return c == '0' || c == '1';
     }
 
-    Token ident(char c) {
-        String buf = collect(c, Lexer::isIdent2);
+    Kind ident() {
+        collect(Lexer::isIdent2);
 
-        if (Key.keys.containsKey(buf)) {
-            return Key.keys.get(buf);
-        } else {
-            return new IdentToken(buf);
+        ident = names.intern(buf, mark, pos - mark);
+
+        Token<Key> tok = Key.keys.get(ident);
+        if (tok != null) {
+            key = tok.data;
+            return Kind.KEY;
         }
+
+        return Kind.IDENT;
     }
 
-    Token base(char c, int radix, Function<Character, Boolean> func) {
-        String buf = collect(c, func);
+    Kind invalid(String msg) {
+        error = msg;
+        return Kind.INVALID;
+    }
 
-        try {
-            return new IntToken(buf, radix);
-        } catch (NumberFormatException err) {
-            return new InvalidToken();
+    /* parse buf[mark..pos) into value, only falling back to a BigInteger on overflow */
+    Kind base(int radix, CharClass func) {
+        collect(func);
+
+        int len = pos - mark;
+        if (len == 0)
+            return invalid(null);
+
+        long limit = Long.MAX_VALUE / radix;
+        long out = 0;
+        big = null;
+
+        for (int i = mark; i < pos; i++) {
+            int d = Character.digit(buf[i], radix);
+            if (d < 0)
+                return invalid(null);
+
+            if (out > limit || out * radix > Long.MAX_VALUE - d) {
+                big = new BigInteger(new String(buf, mark, len), radix);
+                return Kind.INT;
+            }
+
+            out = out * radix + d;
         }
+
+        value = out;
+        return Kind.INT;
     }
 
-    Token basex() {
+    Kind basex() {
         if (eat('x')) {
-            return base('\0', 16, Lexer::isXDigit);
+            mark = pos;
+            return base(16, Lexer::isXDigit);
         } else if (eat('b')) {
-            return base('\0', 2, c -> c == '0' || c == '1');
+            mark = pos;
+            return base(2, Lexer::isBinary);
         } else if (Character.isDigit(peek())) {
-            return base(get(), 10, Character::isDigit);
+            mark = pos;
+            return base(10, Character::isDigit);
         } else {
-            return new IntToken("0", 10);
+            big = null;
+            value = 0;
+            return Kind.INT;
         }
     }
 
-    Token num(char c) {
+    Kind num(char c) {
         return switch (c) {
             case '0' -> basex();
-            default -> base(c, 10, Character::isDigit);
+            default -> base(10, Character::isDigit);
         };
     }
 
-    Token str() {
-        return null;
+    Kind str() {
+        return Kind.STRING;
     }
 
-    Token symbol(char c) {
-        return (switch (c) {
-            case '!' -> (eat('=') ? Key.NEQ : Key.NOT).tok();
-            case '=' -> eat('=') ? Key.keys.get(Key.EQ) : new InvalidToken("=");
-            default -> new InvalidToken(Character.toString(c));
-        });
+    Kind symbol(char c) {
+        switch (c) {
+        case '!':
+            key = eat('=') ? Key.NEQ : Key.NOT;
+            return Kind.KEY;
+        case '=':
+            if (eat('=')) {
+                key = Key.EQ;
+                return Kind.KEY;
+            }
+            return invalid("=");
+        default:
+            return invalid(Character.toString(c));
+        }
     }
 
-    public Token next() {
+    /**
+     * lex the next token into the cursor without allocating,
+     * only new identifiers and integers too large for a long allocate
+     */
+    public Kind advance() {
         char c = skip();
 
         if (c == 0) {
-            return new EOFToken();
+            kind = Kind.EOF;
         } else if (isIdent1(c)) {
-            return ident(c);
+            kind = ident();
         } else if (Character.isDigit(c)) {
-            return num(c);
+            kind = num(c);
         } else if (c == '"') {
-            return str();
+            kind = str();
         } else {
-            return symbol(c);
+            kind = symbol(c);
         }
+
+        return kind;
+    }
+
+    public Kind kind() {
+        return kind;
+    }
+
+    /* the interned name of the current identifier or keyword */
+    public String name() {
+        return ident;
+    }
+
+    public Key key() {
+        return key;
+    }
+
+    public boolean fitsLong() {
+        return big == null;
+    }
+
+    public long longValue() {
+        return value;
+    }
+
+    public BigInteger bigValue() {
+        return big != null ? big : BigInteger.valueOf(value);
+    }
+
+    public Token next() {
+        return switch (advance()) {
+            case EOF -> new EOFToken();
+            case IDENT -> new IdentToken(ident);
+            case INT -> big != null ? new IntToken(big) : new IntToken(value);
+            case KEY -> key.tok();
+            case STRING -> null;
+            case INVALID -> new InvalidToken(error);
+        };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,208 @@
+package com.cthulhu;
+
+import com.cthulhu.tokens.*;
+
+import java.io.Reader;
+import java.lang.ref.Cleaner;
+import java.math.BigInteger;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * the same cursor as Lexer but backed by the C lexer in libctjni,
+ * tokens come back as CtPacked records a batch at a time
+ * so there is one native call per BATCH tokens rather than per token
+ */
+public class NativeLexer extends Lexer {
+    /* must match CtTokenKind */
+    static final int TK_INVALID = 0;
+    static final int TK_END = 1;
+    static final int TK_IDENT = 2;
+    static final int TK_STRING = 3;
+    static final int TK_INT = 4;
+    static final int TK_CHAR = 5;
+    static final int TK_KEY = 6;
+
+    /* must match CtPacked */
+    static final int RECORD = 24;
+    static final int KIND = 0;
+    static final int FLAGS = 1;
+    static final int KEY = 2;
+    static final int OFFSET = 4;
+    static final int LEN = 8;
+    static final int VALUE = 16;
+
+    static final int PACKED_ERROR = 0x1;
+    static final int PACKED_BIG = 0x8;
+    static final int[] RADIX = { 2, 10, 16 };
+
+    static final int BATCH = 1024;
+
+    public static final boolean AVAILABLE = load();
+
+    /* CtKey spellings, keys this side doesnt know about are null */
+    static String[] spellings;
+    static Key[] keys;
+
+    static native int record();
+    static native String[] keys();
+    static native long open(ByteBuffer source, int len);
+    static native int next(long handle, ByteBuffer out);
+    static native void close(long handle);
+
+    static boolean load() {
+        try {
+            System.loadLibrary("ctjni");
+        } catch (UnsatisfiedLinkError err) {
+            return false;
+        }
+
+        /* a library built from different headers is as good as no library */
+        if (record() != RECORD)
+            return false;
+
+        spellings = keys();
+        keys = new Key[spellings.length];
+        for (int i = 0; i < spellings.length; i++) {
+            KeyToken tok = Key.keys.get(spellings[i]);
+            keys[i] = tok != null ? tok.data : null;
+        }
+
+        return true;
+    }
+
+    static final Cleaner cleaner = Cleaner.create();
+
+    /* everything the native side points at, kept apart so the cleaner doesnt hold the lexer */
+    static class State implements Runnable {
+        ByteBuffer source;
+        long handle;
+
+        public void run() {
+            if (handle != 0)
+                close(handle);
+            handle = 0;
+        }
+    }
+
+    byte[] bytes;
+    State state = new State();
+    Cleaner.Cleanable cleanable;
+
+    ByteBuffer records = ByteBuffer.allocateDirect(RECORD * BATCH).order(ByteOrder.nativeOrder());
+    int count = 0;
+    int index = 0;
+
+    public NativeLexer(String text) {
+        super(Reader.nullReader());
+
+        bytes = text.getBytes(StandardCharsets.UTF_8);
+        state.source = ByteBuffer.allocateDirect(Math.max(bytes.length, 1));
+        state.source.put(bytes).flip();
+        state.handle = open(state.source, bytes.length);
+        cleanable = cleaner.register(this, state);
+    }
+
+    /* release the native lexer now instead of whenever the cleaner gets to it */
+    public void close() {
+        cleanable.clean();
+    }
+
+    boolean fill() {
+        if (state.handle == 0)
+            return false;
+
+        records.clear();
+        count = next(state.handle, records);
+        index = 0;
+
+        return count > 0;
+    }
+
+    /* intern source bytes [offset..offset+len), ascii is widened straight into buf */
+    String text(int offset, int len) {
+        if (buf.length < len)
+            buf = new char[len * 2];
+
+        for (int i = 0; i < len; i++) {
+            byte b = bytes[offset + i];
+            if (b < 0) {
+                char[] wide = new String(bytes, offset, len, StandardCharsets.UTF_8).toCharArray();
+                return names.intern(wide, 0, wide.length);
+            }
+            buf[i] = (char)b;
+        }
+
+        return names.intern(buf, 0, len);
+    }
+
+    /* records only carry the low 64 bits so anything big or flagged is reparsed here */
+    Kind integer(int at) {
+        int flags = records.get(at + FLAGS);
+        value = records.getLong(at + VALUE);
+        big = null;
+
+        if ((flags & (PACKED_ERROR | PACKED_BIG)) == 0 && value >= 0)
+            return Kind.INT;
+
+        int radix = RADIX[(flags >> 1) & 0x3];
+        int offset = records.getInt(at + OFFSET);
+        int end = offset + records.getInt(at + LEN);
+
+        if (radix != 10)
+            offset += 2;
+
+        int start = offset;
+        while (offset < end && Character.digit(bytes[offset], radix) >= 0)
+            offset++;
+
+        big = new BigInteger(new String(bytes, start, offset - start, StandardCharsets.US_ASCII), radix);
+        return Kind.INT;
+    }
+
+    @Override
+    public Kind advance() {
+        if (index == count && !fill()) {
+            kind = Kind.EOF;
+            return kind;
+        }
+
+        int at = index++ * RECORD;
+        int offset = records.getInt(at + OFFSET);
+        int len = records.getInt(at + LEN);
+
+        switch (records.get(at + KIND)) {
+        case TK_END:
+            state.run();
+            kind = Kind.EOF;
+            break;
+        case TK_IDENT:
+            ident = text(offset, len);
+            kind = Kind.IDENT;
+            break;
+        case TK_INT:
+            kind = integer(at);
+            break;
+        case TK_CHAR:
+            value = records.getLong(at + VALUE);
+            big = null;
+            kind = Kind.INT;
+            break;
+        case TK_STRING:
+            kind = Kind.STRING;
+            break;
+        case TK_KEY:
+            int id = records.getShort(at + KEY) & 0xffff;
+            key = id < keys.length ? keys[id] : null;
+            ident = id < spellings.length ? spellings[id] : null;
+            kind = key != null ? Kind.KEY : invalid(ident);
+            break;
+        default:
+            kind = invalid(null);
+            break;
+        }
+
+        return kind;
+    }
+}
@@ -5,7 +5,51 @@ import java.math.BigInteger;
 import com.cthulhu.Token;
 
 public class IntToken extends Token<BigInteger> {
+    long value;
+
+    /* only set when the value doesnt fit in a long */
+    BigInteger big;
+
+    public IntToken(long value) {
+        this.value = value;
+    }
+
+    public IntToken(BigInteger big) {
+        super(big);
+
+        if (big.bitLength() < 64) {
+            this.value = big.longValue();
+        } else {
+            this.big = big;
+        }
+    }
+
     public IntToken(String str, int radix) {
-        super(new BigInteger(str, radix));
+        this(new BigInteger(str, radix));
+    }
+
+    public boolean fitsLong() {
+        return big == null;
+    }
+
+    public long longValue() {
+        return value;
+    }
+
+    public BigInteger value() {
+        return big != null ? big : BigInteger.valueOf(value);
+    }
+
+    @Override
+    public boolean equals(Object other) {
+        if (other instanceof Long l)
+            return fitsLong() && l == value;
+
+        return value().equals(other);
+    }
+
+    @Override
+    public String toString() {
+        return big != null ? big.toString() : Long.toString(value);
     }
-}
\ No newline at end of file
+}
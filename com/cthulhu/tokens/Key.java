@@ -22,11 +22,12 @@ public enum Key {
         this.id = i;
     }
 
-    public Token tok() {
-        return new KeyToken(this);
+    /* keys carry no position so every use shares one token */
+    public KeyToken tok() {
+        return keys.get(id);
     }
 
     public static Map<String, KeyToken> keys = Arrays.asList(Key.values())
         .stream()
         .collect(Collectors.toMap(it -> it.id, it -> new KeyToken(it)));
-}
\ No newline at end of file
+}
@@ -0,0 +1,313 @@
+package com.tests;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.StringReader;
+import java.lang.management.ManagementFactory;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+import com.cthulhu.Lexer;
+import com.cthulhu.NativeLexer;
+
+/**
+ * feeds the same generated sources to the java lexer and the C lexer
+ * (through old/tests/tokens.c) and diffs the normalized token streams.
+ *
+ * Conform <tokens>          check every profile over a spread of seeds
+ * Conform <tokens> --bench  print throughput and allocation for both
+ */
+public class Conform {
+    /* what a corpus is mostly made of */
+    enum Profile { MIXED, NAMES, NUMBERS, COMMENTS }
+
+    static final String[] FIRST = { "a", "q", "z", "A", "Q", "Z", "é", "π", "Ж", "変" };
+    static final String ALNUM = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    static final String HEX = "0123456789abcdefABCDEF";
+    static final String[] KEYS = { "def", "struct" };
+    static final String[] SYMBOLS = { "!", "!=", "==", "$" };
+    static final String[] SPACES = { " ", "  ", "\t", "\n", "\r\n" };
+
+    /* CT_MAX_BITS, the C lexer reports anything wider */
+    static final int MAX_BITS = 4096;
+    static final String NOTE = " abc xyz 123 ;:!=$#\"' éπ";
+
+    /**
+     * only shapes both lexers claim to handle. every name has an underscore
+     * so it cant collide with a keyword only the C lexer knows, and strings
+     * are left out since the java lexer doesnt read them yet
+     */
+    static class Corpus {
+        final Random rand;
+        final Profile profile;
+        final StringBuilder out = new StringBuilder();
+
+        /* the last thing written was a name, number or keyword */
+        boolean word = false;
+
+        Corpus(Profile profile, long seed) {
+            this.profile = profile;
+            this.rand = new Random(seed);
+        }
+
+        String pick(String[] from) {
+            return from[rand.nextInt(from.length)];
+        }
+
+        void chars(String from, int len) {
+            for (int i = 0; i < len; i++)
+                out.append(from.charAt(rand.nextInt(from.length())));
+        }
+
+        void name() {
+            out.append(pick(FIRST));
+            chars(ALNUM, rand.nextInt(8));
+            out.append('_');
+            chars(ALNUM + "_", rand.nextInt(4));
+        }
+
+        /* up to a few digits past what fits in 64 bits */
+        void number() {
+            switch (rand.nextInt(4)) {
+            case 0:
+                out.append('0');
+                break;
+            case 1:
+                out.append((char)('1' + rand.nextInt(9)));
+                chars("0123456789", rand.nextInt(23));
+                break;
+            case 2:
+                out.append("0x").append(HEX.charAt(1 + rand.nextInt(HEX.length() - 1)));
+                chars(HEX, rand.nextInt(18));
+                break;
+            default:
+                out.append("0b1");
+                chars("01", rand.nextInt(67));
+                break;
+            }
+        }
+
+        void comment() {
+            out.append('#');
+            chars(NOTE, rand.nextInt(24));
+            out.append('\n');
+        }
+
+        void separate(boolean next) {
+            int roll = rand.nextInt(10);
+
+            if (profile == Profile.COMMENTS && roll < 4) {
+                comment();
+            } else if (roll == 0) {
+                comment();
+            } else if (roll == 1 && word != next) {
+                /* a name right up against a symbol */
+            } else {
+                out.append(pick(SPACES));
+            }
+        }
+
+        void token() {
+            int roll = rand.nextInt(10);
+            boolean next;
+
+            switch (profile) {
+            case NAMES: roll = roll < 7 ? 0 : roll; break;
+            case NUMBERS: roll = roll < 7 ? 3 : roll; break;
+            default: break;
+            }
+
+            next = roll < 8;
+            separate(next);
+
+            if (roll < 3) {
+                name();
+            } else if (roll < 6) {
+                number();
+            } else if (roll < 8) {
+                out.append(pick(KEYS));
+            } else {
+                out.append(pick(SYMBOLS));
+            }
+
+            word = next;
+        }
+
+        String generate(int size) {
+            /* a comment at the very start has tripped up the java lexer before */
+            if (rand.nextBoolean())
+                comment();
+
+            while (out.length() < size)
+                token();
+
+            return out.toString();
+        }
+    }
+
+    static String normalize(Lexer lex, Lexer.Kind kind) {
+        return switch (kind) {
+            case EOF -> "end";
+            case IDENT -> "ident " + lex.name();
+            case KEY -> "key " + lex.key().id;
+            case STRING -> "string";
+            case INVALID -> "invalid";
+            case INT -> lex.bigValue().bitLength() > MAX_BITS ? "int overflow" : "int " + lex.bigValue();
+        };
+    }
+
+    static List<String> java(Lexer lex) {
+        var out = new ArrayList<String>();
+        Lexer.Kind kind;
+
+        do {
+            kind = lex.advance();
+            out.add(normalize(lex, kind));
+        } while (kind != Lexer.Kind.EOF);
+
+        return out;
+    }
+
+    static List<String> run(String... command) throws IOException, InterruptedException {
+        var proc = new ProcessBuilder(command).redirectError(ProcessBuilder.Redirect.INHERIT).start();
+        var out = new ArrayList<String>();
+
+        try (var in = new BufferedReader(new InputStreamReader(proc.getInputStream(), StandardCharsets.UTF_8))) {
+            String line;
+            while ((line = in.readLine()) != null)
+                out.add(line);
+        }
+
+        if (proc.waitFor() != 0)
+            throw new IOException(command[0] + " exited with " + proc.exitValue());
+
+        return out;
+    }
+
+    /* print the first difference with a few tokens either side, true if they match */
+    static boolean diff(String what, List<String> expect, List<String> actual) {
+        int len = Math.min(expect.size(), actual.size());
+        int i = 0;
+
+        while (i < len && expect.get(i).equals(actual.get(i)))
+            i++;
+
+        if (i == len && expect.size() == actual.size())
+            return true;
+
+        System.out.printf("%s: token %d differs%n", what, i);
+        for (int j = Math.max(0, i - 3); j < Math.min(i + 4, Math.max(expect.size(), actual.size())); j++) {
+            System.out.printf("  %s %-32s %s%n", j == i ? ">" : " ",
+                j < expect.size() ? expect.get(j) : "-",
+                j < actual.size() ? actual.get(j) : "-");
+        }
+
+        return false;
+    }
+
+    static boolean check(String tokens) throws IOException, InterruptedException {
+        Path file = Files.createTempFile("conform", ".ct");
+        boolean ok = true;
+
+        try {
+            for (Profile profile : Profile.values()) {
+                for (long seed = 1; seed <= 8; seed++) {
+                    String text = new Corpus(profile, seed).generate(1 << 16);
+                    String what = profile + " seed " + seed;
+
+                    Files.writeString(file, text, StandardCharsets.UTF_8);
+
+                    List<String> c = run(tokens, file.toString());
+                    ok &= diff(what + " (c vs java)", c, java(new Lexer(new StringReader(text))));
+
+                    if (NativeLexer.AVAILABLE)
+                        ok &= diff(what + " (c vs jni)", c, java(new NativeLexer(text)));
+                }
+            }
+        } finally {
+            Files.deleteIfExists(file);
+        }
+
+        return ok;
+    }
+
+    /* bytes allocated by this thread, or -1 if the vm cant tell us */
+    static long allocated() {
+        var bean = ManagementFactory.getThreadMXBean();
+        if (bean instanceof com.sun.management.ThreadMXBean it)
+            return it.getCurrentThreadAllocatedBytes();
+        return -1;
+    }
+
+    interface Source {
+        Lexer open(String text);
+    }
+
+    /* the java vm only tracks bytes so allocations are reported as bytes per token */
+    static void time(String name, String text, long bytes, int reps, Source source) {
+        for (int i = 0; i < 2; i++) {
+            var lex = source.open(text);
+            while (lex.advance() != Lexer.Kind.EOF) {}
+        }
+
+        long tokens = 0;
+        long before = allocated();
+        long start = System.nanoTime();
+
+        for (int i = 0; i < reps; i++) {
+            var lex = source.open(text);
+            while (lex.advance() != Lexer.Kind.EOF)
+                tokens++;
+        }
+
+        long elapsed = System.nanoTime() - start;
+        long used = allocated() - before;
+
+        System.out.printf("%s: %d tokens, %.1f MB/s, %.2f bytes/token%n",
+            name, tokens, bytes * reps / (elapsed / 1e3),
+            before < 0 ? Double.NaN : (double)used / Math.max(tokens, 1));
+    }
+
+    static void bench(String tokens) throws IOException, InterruptedException {
+        Path file = Files.createTempFile("bench", ".ct");
+        int reps = 5;
+
+        try {
+            for (Profile profile : Profile.values()) {
+                String text = new Corpus(profile, 0).generate(8 << 20);
+                long bytes = text.getBytes(StandardCharsets.UTF_8).length;
+
+                Files.writeString(file, text, StandardCharsets.UTF_8);
+                System.out.printf("%s, %d bytes%n", profile, bytes);
+
+                time("java", text, bytes, reps, it -> new Lexer(new StringReader(it)));
+
+                if (NativeLexer.AVAILABLE)
+                    time("jni", text, bytes, reps, NativeLexer::new);
+
+                for (String line : run(tokens, "--bench", file.toString(), Integer.toString(reps)))
+                    System.out.println(line);
+            }
+        } finally {
+            Files.deleteIfExists(file);
+        }
+    }
+
+    public static void main(String[] args) throws IOException, InterruptedException {
+        if (args.length < 1) {
+            System.err.println("usage: Conform <tokens> [--bench]");
+            System.exit(2);
+        }
+
+        if (args.length > 1 && args[1].equals("--bench")) {
+            bench(args[0]);
+        } else if (!check(args[0])) {
+            System.exit(1);
+        }
+    }
+}
@@ -2,17 +2,19 @@ package com.tests;
 
 import java.io.Reader;
 import java.io.StringReader;
+import java.lang.management.ManagementFactory;
 import java.math.BigInteger;
 
 import com.cthulhu.Lexer;
 import com.cthulhu.Token;
+import com.cthulhu.tokens.IdentToken;
 import com.cthulhu.tokens.IntToken;
 import com.cthulhu.tokens.KeyToken;
 import com.cthulhu.tokens.Key;
 
 public class Lex1 {
     public static void main(String[] args) {
-        Reader r = new StringReader("500 0x500 0b1100 0 def");
+        Reader r = new StringReader("500 0x500 0b1100 0 def 99999999999999999999 name name");
         var lex = new Lexer(r);
         Token n;
 
@@ -35,5 +37,71 @@ public class Lex1 {
         n = lex.next();
         assert n instanceof KeyToken : "expected key";
         assert n.equals(Key.DEF) : "wrong value " + n.toString();
+
+        n = lex.next();
+        assert n instanceof IntToken : "expected int";
+        assert !((IntToken)n).fitsLong() : "expected a big value";
+        assert n.equals(new BigInteger("99999999999999999999")) : "wrong value " + n.toString();
+
+        assert lex.advance() == Lexer.Kind.IDENT : "expected ident";
+        String name = lex.name();
+        assert lex.advance() == Lexer.Kind.IDENT : "expected ident";
+        assert lex.name() == name : "identifiers should be interned";
+
+        n = lex.next();
+        assert !(n instanceof IdentToken) : "expected eof";
+
+        /* hex letters, and comments at the very start and straight after a token */
+        lex = new Lexer(new StringReader("# first\n0xaF# after\nx"));
+        assert lex.advance() == Lexer.Kind.INT && lex.longValue() == 0xaf : "expected 0xaf";
+        assert lex.advance() == Lexer.Kind.IDENT && lex.name().equals("x") : "expected x";
+        assert lex.advance() == Lexer.Kind.EOF : "expected eof";
+
+        /* whichever lexer open picks has to agree with this one */
+        var any = Lexer.open("def 0x10 99999999999999999999 name");
+        assert any.advance() == Lexer.Kind.KEY && any.key() == Key.DEF : "expected def";
+        assert any.advance() == Lexer.Kind.INT && any.longValue() == 16 : "expected 16";
+        assert any.advance() == Lexer.Kind.INT && !any.fitsLong() : "expected a big value";
+        assert any.bigValue().equals(new BigInteger("99999999999999999999")) : "wrong value";
+        assert any.advance() == Lexer.Kind.IDENT && any.name().equals("name") : "expected name";
+        assert any.advance() == Lexer.Kind.EOF : "expected eof";
+
+        throughput();
+    }
+
+    /* bytes allocated by this thread, or -1 if the vm cant tell us */
+    static long allocated() {
+        var bean = ManagementFactory.getThreadMXBean();
+        if (bean instanceof com.sun.management.ThreadMXBean it)
+            return it.getCurrentThreadAllocatedBytes();
+        return -1;
+    }
+
+    static void throughput() {
+        String line = "name 12345 0x1f 0b101 def != other_name\n";
+        int lines = (8 << 20) / line.length();
+
+        var text = new StringBuilder(lines * line.length());
+        for (int i = 0; i < lines; i++)
+            text.append(line);
+
+        var lex = new Lexer(new StringReader(text.toString()));
+        long tokens = 0;
+
+        long before = allocated();
+        long start = System.nanoTime();
+
+        while (lex.advance() != Lexer.Kind.EOF)
+            tokens++;
+
+        long elapsed = System.nanoTime() - start;
+        long bytes = allocated() - before;
+
+        assert tokens == lines * 7L : "wrong token count " + tokens;
+
+        System.out.printf("lexed %d tokens in %.1fms (%.1f MB/s), %d bytes allocated%n",
+            tokens, elapsed / 1e6, text.length() / (elapsed / 1e3), bytes);
+
+        assert before < 0 || bytes < (1 << 20) : "cursor lexing allocated " + bytes + " bytes";
     }
 }
@@ -1,7 +1,6 @@
 #include "cthulhu.h"
 
 #include <string.h>
-#include <ctype.h>
 
 #ifndef CT_MALLOC
 #   error "CT_MALLOC must be defined"
@@ -17,32 +16,480 @@
 
 #define CT_UNUSED(it) (void)it
 
-static CtRange zeroRange() {
-    CtRange self;
+/* strictest alignment any allocation needs */
+typedef union {
+    long l;
+    double d;
+    void *p;
+    void(*f)(void);
+} CtMaxAlign;
 
-    self.offset = 0;
-    self.line = 0;
-    self.col = 0;
-    self.len = 0;
+#define CT_ALIGN(size) (((size) + sizeof(CtMaxAlign) - 1) & ~(sizeof(CtMaxAlign) - 1))
+
+void *ctAlloc(CtAllocator *self, size_t size) {
+    return self->alloc(self, size);
+}
+
+void *ctResize(CtAllocator *self, void *ptr, size_t old, size_t size) {
+    return self->resize(self, ptr, old, size);
+}
+
+void ctRelease(CtAllocator *self, void *ptr, size_t size) {
+    self->release(self, ptr, size);
+}
+
+/**
+ * system allocator
+ */
+
+static void *systemAlloc(CtAllocator *self, size_t size) {
+    CT_UNUSED(self);
+    return CT_MALLOC(size);
+}
+
+static void *systemResize(CtAllocator *self, void *ptr, size_t old, size_t size) {
+    CT_UNUSED(self);
+    CT_UNUSED(old);
+    return CT_REALLOC(ptr, size);
+}
+
+static void systemRelease(CtAllocator *self, void *ptr, size_t size) {
+    CT_UNUSED(self);
+    CT_UNUSED(size);
+    CT_FREE(ptr);
+}
+
+/* never written, const lets the compiler see through it */
+static const CtAllocator systemAllocator = { systemAlloc, systemResize, systemRelease };
+
+CtAllocator *ctSystem(void) {
+    return (CtAllocator*)&systemAllocator;
+}
+
+/**
+ * arena allocator
+ */
+
+#define CHUNK_HEADER CT_ALIGN(sizeof(CtChunk))
+
+static char *chunkData(CtChunk *chunk) {
+    return (char*)chunk + CHUNK_HEADER;
+}
+
+static CtChunk *newChunk(CtAllocator *parent, size_t size, CtChunk *next) {
+    CtChunk *chunk = ctAlloc(parent, CHUNK_HEADER + size);
+    chunk->next = next;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+static void *arenaAlloc(CtAllocator *alloc, size_t size) {
+    CtArena *self = (CtArena*)alloc;
+    CtChunk *head = self->head;
+    void *out;
+
+    size = CT_ALIGN(size);
+
+    if (!head || head->used + size > head->size) {
+        head = newChunk(self->parent, size > self->chunk ? size : self->chunk, head);
+        self->head = head;
+    }
+
+    out = chunkData(head) + head->used;
+    head->used += size;
+    return out;
+}
+
+/* is this the last thing handed out by the arena */
+static bool arenaIsLast(CtArena *self, void *ptr, size_t size) {
+    CtChunk *head = self->head;
+    return head && (char*)ptr + CT_ALIGN(size) == chunkData(head) + head->used;
+}
+
+static void *arenaResize(CtAllocator *alloc, void *ptr, size_t old, size_t size) {
+    CtArena *self = (CtArena*)alloc;
+    void *out;
+
+    if (ptr && arenaIsLast(self, ptr, old)) {
+        CtChunk *head = self->head;
+        size_t base = (char*)ptr - chunkData(head);
+        if (base + CT_ALIGN(size) <= head->size) {
+            head->used = base + CT_ALIGN(size);
+            return ptr;
+        }
+    }
+
+    out = arenaAlloc(alloc, size);
+    if (ptr)
+        memcpy(out, ptr, old < size ? old : size);
+    return out;
+}
+
+static void arenaRelease(CtAllocator *alloc, void *ptr, size_t size) {
+    CtArena *self = (CtArena*)alloc;
+
+    if (ptr && arenaIsLast(self, ptr, size))
+        self->head->used -= CT_ALIGN(size);
+}
+
+CtArena ctArenaAlloc(CtAllocator *parent, size_t chunk) {
+    CtArena self;
+
+    self.base.alloc = arenaAlloc;
+    self.base.resize = arenaResize;
+    self.base.release = arenaRelease;
+    self.parent = parent;
+    self.head = NULL;
+    self.chunk = chunk;
 
     return self;
 }
 
-void ctPush(CtBuffer *self, char c) {
-    if (self->len + 1 >= self->size) {
-        self->size += 0x500;
-        self->ptr = CT_REALLOC(self->ptr, self->size);
+void ctArenaFree(CtArena *self) {
+    CtArenaMark mark;
+
+    mark.chunk = NULL;
+    mark.used = 0;
+
+    ctArenaRewind(self, mark);
+}
+
+CtArenaMark ctArenaMark(CtArena *self) {
+    CtArenaMark mark;
+
+    mark.chunk = self->head;
+    mark.used = self->head ? self->head->used : 0;
+
+    return mark;
+}
+
+void ctArenaRewind(CtArena *self, CtArenaMark mark) {
+    while (self->head != mark.chunk) {
+        CtChunk *next = self->head->next;
+        ctRelease(self->parent, self->head, CHUNK_HEADER + self->head->size);
+        self->head = next;
+    }
+
+    if (self->head)
+        self->head->used = mark.used;
+}
+
+/**
+ * pool allocator
+ */
+
+static void *poolAlloc(CtAllocator *alloc, size_t size) {
+    CtPool *self = (CtPool*)alloc;
+    void *out;
+
+    if (size > self->size)
+        return ctAlloc(self->parent, size);
+
+    if (!self->blocks) {
+        size_t i;
+        char *data;
+
+        self->slabs = newChunk(self->parent, self->size * self->count, self->slabs);
+        data = chunkData(self->slabs);
+
+        /* thread the new slab onto the free list */
+        for (i = 0; i < self->count; i++) {
+            *(void**)(data + i * self->size) = self->blocks;
+            self->blocks = data + i * self->size;
+        }
+    }
+
+    out = self->blocks;
+    self->blocks = *(void**)out;
+    return out;
+}
+
+static void poolRelease(CtAllocator *alloc, void *ptr, size_t size) {
+    CtPool *self = (CtPool*)alloc;
+
+    if (!ptr)
+        return;
+
+    if (size > self->size) {
+        ctRelease(self->parent, ptr, size);
+        return;
+    }
+
+    *(void**)ptr = self->blocks;
+    self->blocks = ptr;
+}
+
+static void *poolResize(CtAllocator *alloc, void *ptr, size_t old, size_t size) {
+    CtPool *self = (CtPool*)alloc;
+    void *out;
+
+    if (!ptr)
+        return poolAlloc(alloc, size);
+
+    if (old > self->size && size > self->size)
+        return ctResize(self->parent, ptr, old, size);
+
+    if (old <= self->size && size <= self->size)
+        return ptr;
+
+    out = poolAlloc(alloc, size);
+    memcpy(out, ptr, old < size ? old : size);
+    poolRelease(alloc, ptr, old);
+    return out;
+}
+
+CtPool ctPoolAlloc(CtAllocator *parent, size_t size, size_t count) {
+    CtPool self;
+
+    self.base.alloc = poolAlloc;
+    self.base.resize = poolResize;
+    self.base.release = poolRelease;
+    self.parent = parent;
+    self.slabs = NULL;
+    self.blocks = NULL;
+    self.size = CT_ALIGN(size < sizeof(void*) ? sizeof(void*) : size);
+    self.count = count;
+
+    return self;
+}
+
+void ctPoolFree(CtPool *self) {
+    while (self->slabs) {
+        CtChunk *next = self->slabs->next;
+        ctRelease(self->parent, self->slabs, CHUNK_HEADER + self->slabs->size);
+        self->slabs = next;
+    }
+
+    self->blocks = NULL;
+}
+
+/**
+ * counting allocator
+ */
+
+static void counterAdd(CtCounter *self, size_t size) {
+    self->current += size;
+    self->total += size;
+    if (self->current > self->peak)
+        self->peak = self->current;
+}
+
+static void *counterAlloc(CtAllocator *alloc, size_t size) {
+    CtCounter *self = (CtCounter*)alloc;
+
+    self->allocs += 1;
+    counterAdd(self, size);
+
+    return ctAlloc(self->parent, size);
+}
+
+static void *counterResize(CtAllocator *alloc, void *ptr, size_t old, size_t size) {
+    CtCounter *self = (CtCounter*)alloc;
+
+    if (!ptr)
+        self->allocs += 1;
+
+    self->current -= old;
+    counterAdd(self, size);
+
+    return ctResize(self->parent, ptr, old, size);
+}
+
+static void counterRelease(CtAllocator *alloc, void *ptr, size_t size) {
+    CtCounter *self = (CtCounter*)alloc;
+
+    if (!ptr)
+        return;
+
+    self->frees += 1;
+    self->current -= size;
+
+    ctRelease(self->parent, ptr, size);
+}
+
+CtCounter ctCounterAlloc(CtAllocator *parent) {
+    CtCounter self;
+
+    self.base.alloc = counterAlloc;
+    self.base.resize = counterResize;
+    self.base.release = counterRelease;
+    self.parent = parent;
+    self.current = 0;
+    self.peak = 0;
+    self.total = 0;
+    self.allocs = 0;
+    self.frees = 0;
+
+    return self;
+}
+
+/**
+ * ledger
+ */
+
+static void usageAdd(CtMemUsage *usage, size_t old, size_t size, bool fresh) {
+    usage->current = usage->current - old + size;
+    usage->total += size;
+    usage->allocs += fresh;
+    if (usage->current > usage->peak)
+        usage->peak = usage->current;
+}
+
+/* the running phase always sees the overall total */
+static void ledgerSync(CtLedger *self) {
+    CtMemUsage *phase = self->phases + self->phase;
+
+    phase->current = self->all.current;
+    if (phase->current > phase->peak)
+        phase->peak = phase->current;
+}
+
+static void ledgerAdd(CtTag *tag, size_t old, size_t size, bool fresh) {
+    CtLedger *self = tag->ledger;
+    CtMemUsage *phase = self->phases + self->phase;
+
+    if (self->limit && self->over && size > old && self->all.current + (size - old) > self->limit)
+        self->over(self, tag->kind, size);
+
+    usageAdd(self->kinds + tag->kind, old, size, fresh);
+    usageAdd(&self->all, old, size, fresh);
+
+    phase->total += size;
+    phase->allocs += fresh;
+    ledgerSync(self);
+}
+
+static void *tagAlloc(CtAllocator *alloc, size_t size) {
+    CtTag *tag = (CtTag*)alloc;
+
+    ledgerAdd(tag, 0, size, true);
+
+    return ctAlloc(tag->ledger->parent, size);
+}
+
+static void *tagResize(CtAllocator *alloc, void *ptr, size_t old, size_t size) {
+    CtTag *tag = (CtTag*)alloc;
+
+    ledgerAdd(tag, ptr ? old : 0, size, !ptr);
+
+    return ctResize(tag->ledger->parent, ptr, old, size);
+}
+
+static void tagRelease(CtAllocator *alloc, void *ptr, size_t size) {
+    CtTag *tag = (CtTag*)alloc;
+    CtLedger *self = tag->ledger;
+
+    if (!ptr)
+        return;
+
+    self->kinds[tag->kind].current -= size;
+    self->all.current -= size;
+    ledgerSync(self);
+
+    ctRelease(self->parent, ptr, size);
+}
+
+void ctLedgerAlloc(CtLedger *self, CtAllocator *parent) {
+    size_t i;
+
+    memset(self, 0, sizeof(CtLedger));
+    self->parent = parent;
+    self->phase = CT_PHASE_SETUP;
+
+    for (i = 0; i < CT_MEM_TOTAL; i++) {
+        self->tags[i].base.alloc = tagAlloc;
+        self->tags[i].base.resize = tagResize;
+        self->tags[i].base.release = tagRelease;
+        self->tags[i].ledger = self;
+        self->tags[i].kind = (CtMemKind)i;
+    }
+}
+
+CtAllocator *ctLedgerTag(CtLedger *self, CtMemKind kind) {
+    return &self->tags[kind].base;
+}
+
+void ctLedgerPhase(CtLedger *self, CtPhase phase) {
+    self->phase = phase;
+    ledgerSync(self);
+}
+
+CtMemUsage ctLedgerUsage(CtLedger *self, CtMemKind kind) {
+    return kind == CT_MEM_TOTAL ? self->all : self->kinds[kind];
+}
+
+/* an arena counts against whatever it gets its chunks from */
+static CtAllocator *allocBase(CtAllocator *alloc) {
+    return alloc->alloc == arenaAlloc ? ((CtArena*)alloc)->parent : alloc;
+}
+
+/* the tag for kind when alloc belongs to a ledger, NULL when it doesnt */
+static CtAllocator *ledgerFind(CtAllocator *alloc, CtMemKind kind) {
+    CtAllocator *base = allocBase(alloc);
+
+    if (base->alloc != tagAlloc)
+        return NULL;
+
+    return ctLedgerTag(((CtTag*)base)->ledger, kind);
+}
+
+/* where memory of a kind should come from, alloc itself unless another tag of its ledger fits */
+static CtAllocator *memFor(CtAllocator *alloc, CtMemKind kind) {
+    CtAllocator *tag = ledgerFind(alloc, kind);
+
+    return tag && tag != allocBase(alloc) ? tag : alloc;
+}
+
+/**
+ * buffers
+ */
+
+static char *bufferData(CtBuffer *self) {
+    return self->size > CT_MM_INLINE ? self->data.ptr : self->data.small;
+}
+
+void ctReserve(CtBuffer *self, size_t extra) {
+    size_t size = self->size;
+    char *ptr;
+
+    if (self->len + extra <= size)
+        return;
+
+    /* always grow geometrically so pushing n bytes is O(n) */
+    while (size < self->len + extra)
+        size = CT_MM_GROW(size);
+
+    if (self->size > CT_MM_INLINE) {
+        ptr = ctResize(self->alloc, self->data.ptr, self->size, size);
+    } else {
+        ptr = ctAlloc(self->alloc, size);
+        memcpy(ptr, self->data.small, self->len);
     }
 
-    self->ptr[self->len++] = c;
+    self->data.ptr = ptr;
+    self->size = size;
+}
+
+void ctPush(CtBuffer *self, char c) {
+    ctReserve(self, 1);
+    bufferData(self)[self->len++] = c;
+}
+
+void ctAppend(CtBuffer *self, const char *str, size_t len) {
+    ctReserve(self, len);
+    memcpy(bufferData(self) + self->len, str, len);
+    self->len += len;
 }
 
-CtBuffer ctBufferAlloc(size_t init) {
+CtBuffer ctBufferAlloc(CtAllocator *alloc, size_t init) {
     CtBuffer self;
 
-    self.ptr = CT_MALLOC(init);
-    self.size = init;
+    self.alloc = alloc;
     self.len = 0;
+    self.size = CT_MM_INLINE;
+
+    ctReserve(&self, init);
 
     return self;
 }
@@ -52,45 +499,226 @@ size_t ctOffset(CtBuffer *self) {
 }
 
 void ctBufferFree(CtBuffer self) {
-    CT_FREE(self.ptr);
+    if (self.size > CT_MM_INLINE)
+        ctRelease(self.alloc, self.data.ptr, self.size);
 }
 
 const char *ctAt(CtBuffer *self, size_t off) {
-    return self->ptr + off;
+    return bufferData(self) + off;
 }
 
 void ctRewind(CtBuffer *self, size_t off) {
     self->len = off;
 }
 
-CtStream ctStreamAlloc(void *stream, char(*fun)(void*)) {
+/* grow a typed array so it can hold at least `need` items */
+static void *growArray(CtAllocator *alloc, void *ptr, size_t *size, size_t need, size_t item) {
+    size_t next = *size ? *size : 8;
+
+    if (need <= *size)
+        return ptr;
+
+    while (next < need)
+        next = CT_MM_GROW(next);
+
+    ptr = ctResize(alloc, ptr, *size * item, next * item);
+    *size = next;
+
+    return ptr;
+}
+
+/**
+ * source manager
+ */
+
+static const uint32_t *fileLines(CtFile *file) {
+    return (const uint32_t*)ctAt(&file->lines, 0);
+}
+
+static size_t fileLineCount(CtFile *file) {
+    return ctOffset(&file->lines) / sizeof(uint32_t);
+}
+
+CtSources ctSourcesAlloc(CtAllocator *alloc) {
+    CtSources self;
+
+    self.alloc = memFor(alloc, CT_MEM_SOURCE);
+    self.files = NULL;
+    self.len = 0;
+    self.size = 0;
+    self.next = CT_NOWHERE + 1;
+
+    return self;
+}
+
+void ctSourcesFree(CtSources *self) {
+    size_t i;
+
+    for (i = 0; i < self->len; i++)
+        ctBufferFree(self->files[i].lines);
+
+    if (self->files)
+        ctRelease(self->alloc, self->files, sizeof(CtFile) * self->size);
+}
+
+size_t ctSourceOpen(CtSources *self, const char *name) {
+    CtFile *file;
+
+    self->files = growArray(self->alloc, self->files, &self->size, self->len + 1, sizeof(CtFile));
+
+    file = self->files + self->len;
+    file->name = name;
+    file->lines = ctBufferAlloc(self->alloc, 0);
+    file->base = self->next;
+    file->len = 0;
+    file->open = true;
+
+    return self->len++;
+}
+
+void ctSourceLine(CtSources *self, size_t file, uint32_t offset) {
+    ctAppend(&self->files[file].lines, (const char*)&offset, sizeof(uint32_t));
+}
+
+void ctSourceClose(CtSources *self, size_t file, uint32_t len) {
+    CtFile *it = self->files + file;
+
+    it->len = len;
+    it->open = false;
+
+    /* one past the end is reserved for the end of file */
+    self->next = it->base + len + 1;
+}
+
+CtLoc ctSourceLoc(CtSources *self, size_t file, uint32_t offset) {
+    return self->files[file].base + offset;
+}
+
+/* find the last element in a sorted range that is <= key */
+static size_t searchBelow(const uint32_t *items, size_t len, uint32_t key) {
+    size_t lo = 0;
+    size_t hi = len;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (items[mid] <= key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+CtPosition ctDecode(CtSources *self, CtLoc loc) {
+    CtPosition pos;
+    CtFile *file;
+    size_t lo = 0;
+    size_t hi = self->len;
+    size_t line;
+    uint32_t offset;
+
+    pos.name = NULL;
+    pos.line = 0;
+    pos.col = 0;
+
+    /* files are handed out in order, so their bases are sorted */
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (self->files[mid].base <= loc)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (loc == CT_NOWHERE || lo == 0)
+        return pos;
+
+    file = self->files + lo - 1;
+    offset = loc - file->base;
+
+    if (!file->open && offset > file->len)
+        return pos;
+
+    line = searchBelow(fileLines(file), fileLineCount(file), offset);
+
+    pos.name = file->name;
+    pos.line = line;
+    pos.col = offset - (line ? fileLines(file)[line - 1] : 0);
+
+    return pos;
+}
+
+/**
+ * streams
+ */
+
+CtStream ctStreamAlloc(
+    CtAllocator *alloc,
+    CtSources *sources,
+    const char *name,
+    void *stream,
+    char(*fun)(void*)
+) {
     CtStream self;
 
     self.stream = stream;
     self.get = fun;
+    self.sources = sources;
     self.ahead = fun(stream);
-    self.buffer = ctBufferAlloc(0x1000);
-    self.where = zeroRange();
+    self.buffer = ctBufferAlloc(memFor(alloc, CT_MEM_SOURCE), CT_MM_SOURCE);
+    self.file = ctSourceOpen(sources, name);
+    self.offset = 0;
 
     return self;
 }
 
 void ctStreamFree(CtStream self) {
+    if (self.sources->files[self.file].open)
+        ctSourceClose(self.sources, self.file, self.offset + (uint32_t)ctOffset(&self.buffer));
+
     ctBufferFree(self.buffer);
 }
 
+CtMemory ctMemory(const char *text, size_t len) {
+    CtMemory self;
+
+    self.text = text;
+    self.len = len;
+    self.idx = 0;
+
+    return self;
+}
+
+char ctMemoryNext(void *memory) {
+    CtMemory *self = memory;
+
+    if (self->idx >= self->len)
+        return '\0';
+
+    return self->text[self->idx++];
+}
+
+void ctStreamDiscard(CtStream *self) {
+#if !CT_MM_RETAIN
+    self->offset += (uint32_t)ctOffset(&self->buffer);
+    ctRewind(&self->buffer, 0);
+#else
+    CT_UNUSED(self);
+#endif
+}
+
 char ctNext(CtStream *self) {
     char c = self->ahead;
-    self->ahead = self->get(self->stream);
 
-    self->where.offset += 1;
+    if (c == '\0')
+        return c;
 
-    if (c == '\n') {
-        self->where.line += 1;
-        self->where.col = 0;
-    } else {
-        self->where.col += 1;
-    }
+    self->ahead = self->get(self->stream);
+    ctPush(&self->buffer, c);
+
+    if (c == '\n')
+        ctSourceLine(self->sources, self->file, self->offset + (uint32_t)ctOffset(&self->buffer));
 
     return c;
 }
@@ -107,10 +735,4212 @@ bool ctEat(CtStream *self, char c) {
     return false;
 }
 
-CtRange ctHere(CtStream *self) {
-    return self->where;
+CtLoc ctHere(CtStream *self) {
+    return ctSourceLoc(self->sources, self->file, self->offset + (uint32_t)ctOffset(&self->buffer));
+}
+
+/**
+ * utf8
+ */
+
+#ifdef __SSE2__
+#   include <emmintrin.h>
+#endif
+
+#define UTF8_BAD 0xFFFFFFFFu
+
+static const uint32_t xidStart[][2] = {
+#define XID_START(lo, hi) { lo, hi },
+#include "xid.h"
+};
+
+static const uint32_t xidContinue[][2] = {
+#define XID_CONTINUE(lo, hi) { lo, hi },
+#include "xid.h"
+};
+
+static bool xidIn(const uint32_t (*ranges)[2], size_t len, uint32_t c) {
+    size_t lo = 0;
+    size_t hi = len;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (c < ranges[mid][0])
+            hi = mid;
+        else if (c > ranges[mid][1])
+            lo = mid + 1;
+        else
+            return true;
+    }
+
+    return false;
 }
 
-static size_t sourceOffset(CtStream *self) {
-    return self->where.offset;
+#define IS_XID_START(c) xidIn(xidStart, sizeof(xidStart) / sizeof(*xidStart), c)
+#define IS_XID_CONTINUE(c) xidIn(xidContinue, sizeof(xidContinue) / sizeof(*xidContinue), c)
+
+/* length of a sequence starting with lead and the range its second byte must be in */
+static int utf8Lead(uint8_t lead, uint8_t *lo, uint8_t *hi) {
+    *lo = 0x80;
+    *hi = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+        return 2;
+
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        /* no overlongs or surrogates */
+        if (lead == 0xE0) *lo = 0xA0;
+        if (lead == 0xED) *hi = 0x9F;
+        return 3;
+    }
+
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        /* no overlongs or anything past 0x10FFFF */
+        if (lead == 0xF0) *lo = 0x90;
+        if (lead == 0xF4) *hi = 0x8F;
+        return 4;
+    }
+
+    return 0;
 }
+
+/* the first byte at or after idx that isnt ascii */
+static size_t utf8Ascii(const uint8_t *text, size_t idx, size_t len) {
+#ifdef __SSE2__
+    while (idx + 16 <= len) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(text + idx)));
+        if (mask)
+            return idx + __builtin_ctz(mask);
+
+        idx += 16;
+    }
+#else
+    const uint64_t high = (uint64_t)-1 / 0xFF * 0x80;
+
+    while (idx + 8 <= len) {
+        uint64_t word;
+        memcpy(&word, text + idx, 8);
+
+        if (word & high)
+            break;
+
+        idx += 8;
+    }
+#endif
+
+    while (idx < len && text[idx] < 0x80)
+        idx++;
+
+    return idx;
+}
+
+size_t ctUtf8Check(const char *text, size_t len) {
+    const uint8_t *data = (const uint8_t*)text;
+    size_t idx = 0;
+
+    while ((idx = utf8Ascii(data, idx, len)) < len) {
+        uint8_t lo, hi;
+        int size = utf8Lead(data[idx], &lo, &hi);
+        int i;
+
+        if (size == 0 || idx + size > len || data[idx + 1] < lo || data[idx + 1] > hi)
+            return idx;
+
+        for (i = 2; i < size; i++)
+            if ((data[idx + i] & 0xC0) != 0x80)
+                return idx;
+
+        idx += size;
+    }
+
+    return len;
+}
+
+/**
+ * lexer
+ */
+
+#if CT_MM_TABLES
+
+enum {
+    CC_SPACE = (1 << 0),
+    CC_DIGIT = (1 << 1),
+    CC_XDIGIT = (1 << 2),
+    CC_IDENT1 = (1 << 3),
+    CC_IDENT2 = (1 << 4)
+};
+
+static const uint8_t charClass[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    22, 22, 22, 22, 22, 22, 22, 22, 22, 22,  0,  0,  0,  0,  0,  0,
+     0, 28, 28, 28, 28, 28, 28, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+    24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,  0,  0,  0,  0, 24,
+     0, 28, 28, 28, 28, 28, 28, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+    24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+};
+
+#define CHAR_IS(c, cls) (charClass[(uint8_t)(c)] & (cls))
+
+static int isident1(char c) { return CHAR_IS(c, CC_IDENT1); }
+static int isident2(char c) { return CHAR_IS(c, CC_IDENT2); }
+static int isDigit(char c) { return CHAR_IS(c, CC_DIGIT); }
+static int isXDigit(char c) { return CHAR_IS(c, CC_XDIGIT); }
+static int isSpace(char c) { return CHAR_IS(c, CC_SPACE); }
+
+#else
+
+/* only ascii, <ctype.h> depends on the locale */
+static int isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+static int isDigit(char c) { return c >= '0' && c <= '9'; }
+static int isXDigit(char c) { return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+static int isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+static int isident1(char c) { return isAlpha(c) || c == '_'; }
+static int isident2(char c) { return isAlpha(c) || isDigit(c) || c == '_'; }
+
+#endif
+
+CtLexer ctLexerAlloc(CtStream stream, size_t max_errs) {
+    CtLexer self;
+    CtAllocator *alloc = stream.buffer.alloc;
+
+    self.stream = stream;
+    self.strings = ctBufferAlloc(memFor(alloc, CT_MEM_STRINGS), CT_MM_STRINGS);
+
+    self.bigs = ctArenaAlloc(memFor(alloc, CT_MEM_STRINGS), CT_MM_ARENA);
+
+    self.dialect = LD_CORE;
+    self.depth = 0;
+
+    self.err.kind = ERR_NONE;
+
+    self.errs = ctAlloc(memFor(alloc, CT_MEM_DIAGNOSTICS), sizeof(CtError) * max_errs);
+    self.err_idx = 0;
+    self.max_errs = max_errs;
+    self.reported = 0;
+
+    return self;
+}
+
+void ctLexerFree(CtLexer *self) {
+    CtAllocator *alloc = memFor(self->stream.buffer.alloc, CT_MEM_DIAGNOSTICS);
+
+    ctRelease(alloc, self->errs, sizeof(CtError) * self->max_errs);
+    ctArenaFree(&self->bigs);
+    ctBufferFree(self->strings);
+    ctStreamFree(self->stream);
+}
+
+const char *ctIdent(CtLexer *self, CtView view) {
+#if CT_MM_RETAIN
+    return ctAt(&self->stream.buffer, view.offset);
+#else
+    return ctAt(&self->strings, view.offset);
+#endif
+}
+
+const char *ctString(CtLexer *self, CtView view) {
+    return ctAt(&self->strings, view.offset);
+}
+
+static uint32_t lexOff(CtLexer *self) {
+    return (uint32_t)ctOffset(&self->stream.buffer);
+}
+
+static char lexNext(CtLexer *self) {
+    return ctNext(&self->stream);
+}
+
+static char lexPeek(CtLexer *self) {
+    return ctPeek(&self->stream);
+}
+
+static bool lexConsume(CtLexer *self, char c) {
+    return ctEat(&self->stream, c);
+}
+
+/* a bad sequence and any stray continuation bytes after it are one error */
+static uint32_t lexUtf8Bad(CtLexer *self) {
+    while ((uint8_t)lexPeek(self) >= 0x80 && (uint8_t)lexPeek(self) <= 0xBF)
+        lexNext(self);
+
+    return UTF8_BAD;
+}
+
+/**
+ * read the rest of a sequence starting with lead, its bytes are
+ * copied into out when set. returns the code point or UTF8_BAD
+ */
+static uint32_t lexUtf8(CtLexer *self, uint8_t lead, CtBuffer *out) {
+    uint8_t lo, hi;
+    int size = utf8Lead(lead, &lo, &hi);
+    uint32_t c = lead & (0x7F >> size);
+
+    if (size == 0)
+        return lexUtf8Bad(self);
+
+    while (--size) {
+        uint8_t next = (uint8_t)lexPeek(self);
+
+        if (next < lo || next > hi)
+            return lexUtf8Bad(self);
+
+        lexNext(self);
+        if (out)
+            ctPush(out, (char)next);
+
+        c = (c << 6) | (next & 0x3F);
+        lo = 0x80;
+        hi = 0xBF;
+    }
+
+    return c;
+}
+
+static void report(CtLexer *self, CtError *err);
+
+/* comments arent tokens so their errors are reported right away */
+static void lexComment(CtLexer *self) {
+    while (lexPeek(self) != '\n' && lexPeek(self) != '\0') {
+        CtLoc loc = ctHere(&self->stream);
+        uint8_t c = (uint8_t)lexNext(self);
+
+        if (c >= 0x80 && lexUtf8(self, c, NULL) == UTF8_BAD) {
+            self->err.kind = ERR_INVALID_UTF8;
+            self->err.where.loc = loc;
+            self->err.where.len = 1;
+            report(self, &self->err);
+        }
+    }
+}
+
+static void lexSkip(CtLexer *self) {
+    while (1) {
+        char c = lexPeek(self);
+
+        if (c == '#') {
+            lexComment(self);
+        } else if (isSpace(c)) {
+            lexNext(self);
+        } else {
+            break;
+        }
+    }
+}
+
+/* make a view of the source from off to here that outlives the token */
+static CtView lexView(CtLexer *self, uint32_t off) {
+    CtView view;
+
+    view.len = lexOff(self) - off;
+
+#if CT_MM_RETAIN
+    view.offset = off;
+#else
+    view.offset = 0;
+
+    if (view.len) {
+        view.offset = (uint32_t)ctOffset(&self->strings);
+        ctAppend(&self->strings, ctAt(&self->stream.buffer, off), view.len);
+        ctPush(&self->strings, '\0');
+    }
+#endif
+
+    return view;
+}
+
+static void report(CtLexer *self, CtError *err) {
+    self->reported++;
+
+    if (self->err_idx < self->max_errs)
+        self->errs[self->err_idx++] = *err;
+
+    err->kind = ERR_NONE;
+}
+
+/* the rest of a name starting at off, keywords are left to each dialect */
+static size_t lexName(CtLexer *self, uint32_t off) {
+    while (1) {
+        uint32_t c;
+
+        /* ascii runs never touch the unicode tables */
+        while (isident2(lexPeek(self)))
+            lexNext(self);
+
+        if ((uint8_t)lexPeek(self) < 0x80)
+            break;
+
+        /* theres only one byte of lookahead, so anything else ends up in the name */
+        c = lexUtf8(self, (uint8_t)lexNext(self), NULL);
+
+        if (c == UTF8_BAD) {
+            self->err.kind = ERR_INVALID_UTF8;
+            break;
+        } else if (!IS_XID_CONTINUE(c)) {
+            self->err.kind = ERR_INVALID_SYMBOL;
+            break;
+        }
+    }
+
+    return lexOff(self) - off;
+}
+
+#define BASE10_LIMIT (((size_t)-1) % 10)
+#define BASE10_CUTOFF (((size_t)-1) / 10)
+
+/* the fast paths only flag when the value stops fitting, lexBig does the rest */
+static size_t lexBase2(CtLexer *self, bool *wide) {
+    size_t out = 0;
+
+    while (lexPeek(self) == '0' || lexPeek(self) == '1') {
+        if (out >> (sizeof(size_t) * 8 - 1))
+            *wide = true;
+
+        out = (out * 2) + (lexNext(self) == '1');
+    }
+
+    return out;
+}
+
+static size_t lexBase10(CtLexer *self, char c, bool *wide) {
+    size_t out = c - '0';
+
+    while (isDigit(lexPeek(self))) {
+        size_t n = lexNext(self) - '0';
+        if (out > BASE10_CUTOFF || (out == BASE10_CUTOFF && n > BASE10_LIMIT))
+            *wide = true;
+
+        out = (out * 10) + n;
+    }
+
+    return out;
+}
+
+static size_t lexBase16(CtLexer *self, bool *wide) {
+    size_t out = 0;
+
+    while (isXDigit(lexPeek(self))) {
+        uint8_t n = lexNext(self);
+        size_t v = ((n & 0xF) + (n >> 6)) | ((n >> 3) & 0x8);
+
+        if (out >> (sizeof(size_t) * 8 - 4))
+            *wide = true;
+
+        out = (out << 4) | v;
+    }
+
+    return out;
+}
+
+#define MAX_LIMBS (CT_MAX_BITS / 32 + 2)
+
+static size_t bigSize(uint32_t len) {
+    return sizeof(CtBig) + sizeof(uint32_t) * len;
+}
+
+/* a copy of limbs with its header in one allocation */
+static CtBig *bigCopy(CtAllocator *alloc, bool negative, const uint32_t *limbs, uint32_t len) {
+    CtBig *out = ctAlloc(alloc, bigSize(len));
+    uint32_t *data = (uint32_t*)(out + 1);
+
+    memcpy(data, limbs, sizeof(uint32_t) * len);
+
+    out->negative = negative;
+    out->len = len;
+    out->limbs = data;
+
+    return out;
+}
+
+/* the low 64 bits of a magnitude */
+static uint64_t limbsLow(const uint32_t *limbs, uint32_t len) {
+    uint64_t lo = len > 0 ? limbs[0] : 0;
+    uint64_t hi = len > 1 ? limbs[1] : 0;
+
+    return lo | (hi << 32);
+}
+
+/**
+ * digits from..here are past INT64_MAX, convert them again into limbs.
+ * only the first CT_MAX_BITS worth are ever looked at so the cost is
+ * bounded however long the literal is
+ */
+static void lexBig(CtLexer *self, CtToken *tok, uint32_t from, uint32_t base) {
+    const char *text = ctAt(&self->stream.buffer, from);
+    size_t len = lexOff(self) - from;
+    uint32_t limbs[MAX_LIMBS];
+    uint32_t used = 0;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        uint8_t n = text[i];
+        uint64_t carry = ((n & 0xF) + (n >> 6)) | ((n >> 3) & 0x8);
+        uint32_t j;
+
+        for (j = 0; j < used; j++) {
+            carry += (uint64_t)limbs[j] * base;
+            limbs[j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+
+        if (carry)
+            limbs[used++] = (uint32_t)carry;
+
+        if (used * 32 > CT_MAX_BITS) {
+            self->err.kind = ERR_OVERFLOW;
+            return;
+        }
+    }
+
+    tok->data.digit.big = bigCopy(&self->bigs.base, false, limbs, used);
+    tok->data.digit.num = (size_t)limbsLow(limbs, used);
+}
+
+static void lexDigit(CtLexer *self, CtToken *tok, char c) {
+    uint32_t from = lexOff(self) - 1;
+    uint32_t base = 10;
+    bool wide = false;
+    uint32_t off;
+
+    tok->kind = TK_INT;
+    tok->data.digit.big = NULL;
+
+    if (c == '0' && lexConsume(self, 'b')) {
+        from = lexOff(self);
+        base = 2;
+        tok->data.digit.enc = BASE2;
+        tok->data.digit.num = lexBase2(self, &wide);
+    } else if (c == '0' && lexConsume(self, 'x')) {
+        from = lexOff(self);
+        base = 16;
+        tok->data.digit.enc = BASE16;
+        tok->data.digit.num = lexBase16(self, &wide);
+    } else {
+        tok->data.digit.enc = BASE10;
+        tok->data.digit.num = lexBase10(self, c, &wide);
+    }
+
+    /* small values are always an int64, so a plain cast gets them back */
+    if (wide || tok->data.digit.num > (size_t)INT64_MAX)
+        lexBig(self, tok, from, base);
+
+    off = lexOff(self);
+
+    while (isident2(lexPeek(self)))
+        lexNext(self);
+
+    tok->data.digit.suffix = lexView(self, off);
+}
+
+typedef enum {
+    /* keep going */
+    CR_OK,
+    /* found a newline */
+    CR_NL,
+
+    /* end of the string */
+    CR_END,
+
+    /* end of the file (this is bad) */
+    CR_EOF
+} CharResult;
+
+static CharResult lexSingleChar(CtLexer *self, char *out) {
+    char c = lexNext(self);
+    *out = c;
+
+    if (c == '\\') {
+        c = lexNext(self);
+        switch (c) {
+        case 'b': *out = '\b'; break;
+        case 'a': *out = '\a'; break;
+        case 'f': *out = '\f'; break;
+        case 'r': *out = '\r'; break;
+        case 'n': *out = '\n'; break;
+        case 'v': *out = '\v'; break;
+        case 't': *out = '\t'; break;
+        case '\'':*out = '\''; break;
+        case '"': *out = '\"'; break;
+        case '\\':*out = '\\'; break;
+        case '0': *out = '\0'; break;
+        default:
+            *out = c;
+            self->err.kind = ERR_INVALID_ESCAPE;
+            break;
+        }
+    } else if (c == '\n') {
+        return CR_NL;
+    } else if (c == '"') {
+        return CR_END;
+    } else if (c == '\0') {
+        self->err.kind = ERR_STRING_EOF;
+        return CR_EOF;
+    }
+
+    return CR_OK;
+}
+
+static void lexString(CtLexer *self, CtToken *tok, bool multiline) {
+    uint32_t off = (uint32_t)ctOffset(&self->strings);
+    char c;
+
+    tok->kind = TK_STRING;
+
+    while (1) {
+        CharResult res = lexSingleChar(self, &c);
+        if (res == CR_NL && !multiline)
+            self->err.kind = ERR_STRING_LINEBREAK;
+        else if (res == CR_END || res == CR_EOF)
+            break;
+
+        ctPush(&self->strings, c);
+
+        if ((uint8_t)c >= 0x80 && lexUtf8(self, (uint8_t)c, &self->strings) == UTF8_BAD)
+            self->err.kind = ERR_INVALID_UTF8;
+    }
+
+    tok->data.str.offset = off;
+    tok->data.str.len = (uint32_t)ctOffset(&self->strings) - off;
+
+    ctPush(&self->strings, '\0');
+}
+
+static void lexChar(CtLexer *self, CtToken *tok) {
+    char c;
+
+    tok->kind = TK_CHAR;
+
+    switch (lexSingleChar(self, &c)) {
+    case CR_END:
+        c = '"';
+        break;
+
+        /* handle eof */
+    case CR_EOF:
+        tok->data.letter = '\0';
+        return;
+    case CR_NL:
+        tok->data.letter = '\0';
+        self->err.kind = ERR_STRING_LINEBREAK;
+        return;
+    default:
+        break;
+    }
+
+    tok->data.letter = c;
+
+    /* check for the trailing ' */
+    if (!lexConsume(self, '\'')) {
+        /* try and gracefully cleanup the users mess */
+        while (lexPeek(self) != '\0' && !isSpace(lexPeek(self)))
+            lexNext(self);
+
+        self->err.kind = ERR_CHAR_CLOSING;
+    }
+}
+
+/**
+ * one copy of dialect.h per dialect, each only knows its own keys
+ */
+
+#define DIALECT_NAME(name) name##Core
+#define DIALECT_SET LF_CORE
+#include "dialect.h"
+
+#define DIALECT_NAME(name) name##Asm
+#define DIALECT_SET LF_ASM
+#include "dialect.h"
+
+CtToken ctLex(CtLexer *self) {
+    switch (self->dialect) {
+#define DIALECT(id, name, flags) case id: return lex##name(self);
+#include "keys.h"
+    default: return lexCore(self);
+    }
+}
+
+size_t ctLexBatch(CtLexer *self, CtPacked *out, size_t len) {
+    CtLoc base = self->stream.sources->files[self->stream.file].base;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        size_t errs = self->reported;
+        CtToken tok = ctLex(self);
+        CtPacked *it = &out[i];
+
+        it->kind = (uint8_t)tok.kind;
+        it->flags = self->reported != errs ? CT_PACKED_ERROR : 0;
+        it->key = 0;
+        it->offset = tok.where.loc - base;
+        it->len = tok.where.len;
+        it->reserved = 0;
+        it->value = 0;
+
+        switch (tok.kind) {
+        case TK_KEY:
+            it->key = (uint16_t)tok.data.key;
+            break;
+        case TK_INT:
+            it->flags |= (uint8_t)(tok.data.digit.enc << 1);
+            it->flags |= tok.data.digit.big ? CT_PACKED_BIG : 0;
+            it->value = tok.data.digit.num;
+            break;
+        case TK_CHAR:
+            it->value = (uint8_t)tok.data.letter;
+            break;
+        case TK_END:
+            return i + 1;
+        default:
+            break;
+        }
+    }
+
+    return i;
+}
+
+CtToken *ctLexAll(CtLexer *self, size_t *len) {
+    CtAllocator *alloc = memFor(self->stream.buffer.alloc, CT_MEM_TOKENS);
+    CtToken *out = NULL;
+    size_t size = 0;
+    size_t used = 0;
+
+    do {
+        out = growArray(alloc, out, &size, used + 1, sizeof(CtToken));
+        out[used] = ctLex(self);
+    } while (out[used++].kind != TK_END);
+
+    *len = used;
+    return ctResize(alloc, out, sizeof(CtToken) * size, sizeof(CtToken) * used);
+}
+
+/**
+ * hash consing
+ */
+
+static uint32_t hashText(const char *text, size_t len) {
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+
+    return hash;
+}
+
+CtCons ctConsAlloc(CtAllocator *alloc) {
+    CtCons self;
+
+    self.alloc = memFor(alloc, CT_MEM_AST);
+
+    self.entries = NULL;
+    self.len = 0;
+    self.size = 0;
+
+    self.slots = NULL;
+    self.slot_size = 0;
+
+    self.hits = 0;
+
+    return self;
+}
+
+void ctConsFree(CtCons *self) {
+    size_t i;
+
+    for (i = 0; i < self->len; i++) {
+        CtAST *node = self->entries[i].node;
+
+        /* only folding gives shared literals limbs */
+        if (node->kind == AK_LITERAL && node->tok.kind == TK_INT && node->tok.data.digit.big)
+            ctRelease(self->alloc, (void*)node->tok.data.digit.big, bigSize(node->tok.data.digit.big->len));
+
+        ctRelease(self->alloc, node, sizeof(CtAST));
+    }
+
+    if (self->entries)
+        ctRelease(self->alloc, self->entries, sizeof(CtConsEntry) * self->size);
+
+    if (self->slots)
+        ctRelease(self->alloc, self->slots, sizeof(uint32_t) * self->slot_size);
+}
+
+static void consRehash(CtCons *self) {
+    size_t size = self->slot_size ? self->slot_size * 2 : 64;
+    size_t mask = size - 1;
+    size_t i;
+
+    if (self->slots)
+        ctRelease(self->alloc, self->slots, sizeof(uint32_t) * self->slot_size);
+
+    self->slots = ctAlloc(self->alloc, sizeof(uint32_t) * size);
+    self->slot_size = size;
+    memset(self->slots, 0, sizeof(uint32_t) * size);
+
+    for (i = 0; i < self->len; i++) {
+        size_t slot = self->entries[i].hash & mask;
+
+        while (self->slots[slot])
+            slot = (slot + 1) & mask;
+
+        self->slots[slot] = (uint32_t)i + 1;
+    }
+}
+
+/* key must be zeroed before it is filled in, its bytes are hashed */
+static CtAST *consNode(CtCons *self, const CtConsKey *key, CtToken tok) {
+    uint32_t hash = hashText((const char*)key, sizeof(CtConsKey));
+    CtConsEntry *entry;
+    CtAST *node;
+    size_t mask;
+    size_t slot;
+
+    if ((self->len + 1) * 2 > self->slot_size)
+        consRehash(self);
+
+    mask = self->slot_size - 1;
+
+    for (slot = hash & mask; self->slots[slot]; slot = (slot + 1) & mask) {
+        entry = self->entries + self->slots[slot] - 1;
+
+        if (entry->hash == hash && memcmp(&entry->key, key, sizeof(CtConsKey)) == 0) {
+            self->hits++;
+            return entry->node;
+        }
+    }
+
+    node = ctAlloc(self->alloc, sizeof(CtAST));
+    node->kind = key->kind;
+    node->shared = true;
+    node->tok = tok;
+
+    if (key->kind == AK_BINARY) {
+        node->data.binary.lhs = key->lhs;
+        node->data.binary.rhs = key->rhs;
+    } else if (key->kind == AK_UNARY) {
+        node->data.expr = key->lhs;
+    }
+
+    self->entries = growArray(self->alloc, self->entries, &self->size, self->len + 1, sizeof(CtConsEntry));
+
+    entry = self->entries + self->len;
+    entry->key = *key;
+    entry->hash = hash;
+    entry->node = node;
+
+    self->slots[slot] = (uint32_t)++self->len;
+    return node;
+}
+
+/**
+ * parser
+ */
+
+/* working storage stays out of alloc so rewinding an arena cant pull it out from under us */
+static CtAllocator *pWork(CtAllocator *alloc, CtMemKind kind) {
+    CtAllocator *tag = ledgerFind(alloc, kind);
+    return tag ? tag : ctSystem();
+}
+
+CtParser ctParserAlloc(CtLexer *lex, CtAllocator *alloc, size_t max_errs) {
+    CtParser self;
+
+    self.lex = lex;
+    self.alloc = alloc;
+    self.cons = NULL;
+    self.ring = NULL;
+
+    self.tokens = NULL;
+    self.token_idx = 0;
+    self.token_len = 0;
+
+    self.peeked = false;
+    self.done = false;
+
+    self.log = NULL;
+    self.log_len = 0;
+    self.log_size = 0;
+    self.pos = 0;
+    self.marks = 0;
+
+    self.scratch = ctBufferAlloc(pWork(alloc, CT_MEM_AST), 0);
+    self.depth = 0;
+
+    self.err.kind = ERR_NONE;
+
+    self.errs = ctAlloc(memFor(alloc, CT_MEM_DIAGNOSTICS), sizeof(CtError) * max_errs);
+    self.err_idx = 0;
+    self.max_errs = max_errs;
+
+    return self;
+}
+
+void ctParserFree(CtParser *self) {
+    ctRelease(pWork(self->alloc, CT_MEM_TOKENS), self->log, sizeof(CtToken) * self->log_size);
+    ctBufferFree(self->scratch);
+    ctRelease(memFor(self->alloc, CT_MEM_DIAGNOSTICS), self->errs, sizeof(CtError) * self->max_errs);
+}
+
+static void pReport(CtParser *self, CtError *err) {
+    if (self->err_idx < self->max_errs)
+        self->errs[self->err_idx++] = *err;
+
+    err->kind = ERR_NONE;
+}
+
+static CtToken pFetch(CtParser *self) {
+    if (self->tokens) {
+        CtToken tok;
+
+        if (self->token_idx < self->token_len)
+            return self->tokens[self->token_idx++];
+
+        /* a slice of a file has no end token of its own */
+        tok.kind = TK_END;
+        tok.where.loc = CT_NOWHERE;
+        tok.where.len = 0;
+
+        if (self->token_len) {
+            CtRange last = self->tokens[self->token_len - 1].where;
+            tok.where.loc = last.loc + last.len;
+        }
+
+        return tok;
+    }
+
+#ifdef CT_THREADS
+    if (self->ring) {
+        /* the lexer thread stops after the end token, so keep handing it out */
+        if (!self->done)
+            self->tok = ctRingPop(self->ring);
+
+        self->done = self->tok.kind == TK_END;
+        return self->tok;
+    }
+#endif
+
+    return ctLex(self->lex);
+}
+
+static void pLog(CtParser *self, CtToken tok) {
+    if (self->log_len == self->log_size) {
+        /* nothing before pos is pinned by a mark so slide it out rather than grow */
+        if (self->pos && !self->marks) {
+            memmove(self->log, self->log + self->pos, sizeof(CtToken) * (self->log_len - self->pos));
+            self->log_len -= self->pos;
+            self->pos = 0;
+        } else {
+            self->log = growArray(pWork(self->alloc, CT_MEM_TOKENS), self->log, &self->log_size, self->log_len + 1, sizeof(CtToken));
+        }
+    }
+
+    self->log[self->log_len++] = tok;
+}
+
+/* a peeked token always comes right after the log, move it in */
+static void pSpill(CtParser *self) {
+    if (self->peeked) {
+        pLog(self, self->tok);
+        self->peeked = false;
+    }
+}
+
+static CtToken pAhead(CtParser *self, size_t n) {
+    pSpill(self);
+
+    while (self->log_len - self->pos <= n)
+        pLog(self, pFetch(self));
+
+    return self->log[self->pos + n];
+}
+
+/* the single token peek stays out of the log unless something needs more */
+static CtToken pPeek(CtParser *self) {
+    if (self->pos < self->log_len)
+        return self->log[self->pos];
+
+    if (!self->peeked) {
+        self->tok = pFetch(self);
+        self->peeked = true;
+    }
+
+    return self->tok;
+}
+
+static CtToken pNext(CtParser *self) {
+    CtToken tok;
+
+    if (self->pos < self->log_len) {
+        tok = self->log[self->pos++];
+
+        if (self->pos == self->log_len && !self->marks) {
+            self->pos = 0;
+            self->log_len = 0;
+        }
+
+        return tok;
+    }
+
+    if (self->peeked) {
+        self->peeked = false;
+        tok = self->tok;
+    } else {
+        tok = pFetch(self);
+    }
+
+    /* inside a mark every token is kept for a rewind */
+    if (self->marks) {
+        pLog(self, tok);
+        self->pos++;
+    }
+
+    return tok;
+}
+
+CtToken ctParserAhead(CtParser *self, size_t n) {
+    return pAhead(self, n);
+}
+
+CtParserMark ctParserMark(CtParser *self) {
+    CtParserMark mark;
+
+    pSpill(self);
+
+    mark.pos = self->pos;
+    mark.err_idx = self->err_idx;
+    mark.err = self->err;
+    mark.scratch = ctOffset(&self->scratch);
+    mark.nodes.chunk = NULL;
+    mark.nodes.used = 0;
+
+    if (self->alloc->alloc == arenaAlloc)
+        mark.nodes = ctArenaMark((CtArena*)self->alloc);
+
+    self->marks += 1;
+    return mark;
+}
+
+void ctParserRewind(CtParser *self, CtParserMark mark) {
+    self->pos = mark.pos;
+    self->err_idx = mark.err_idx;
+    self->err = mark.err;
+    ctRewind(&self->scratch, mark.scratch);
+
+    if (self->alloc->alloc == arenaAlloc)
+        ctArenaRewind((CtArena*)self->alloc, mark.nodes);
+
+    self->marks -= 1;
+}
+
+void ctParserDrop(CtParser *self, CtParserMark mark) {
+    CT_UNUSED(mark);
+    self->marks -= 1;
+}
+
+static bool pIsKey(CtToken tok, CtKey key) {
+    return tok.kind == TK_KEY && tok.data.key == key;
+}
+
+static bool pConsume(CtParser *self, CtKey key) {
+    if (pIsKey(pPeek(self), key)) {
+        pNext(self);
+        return true;
+    }
+    return false;
+}
+
+static bool pExpect(CtParser *self, CtKey key) {
+    CtToken tok = pNext(self);
+    if (tok.kind != TK_KEY || tok.data.key != key) {
+        /* the first error in a statement is the interesting one */
+        if (self->err.kind == ERR_NONE) {
+            self->err.kind = ERR_UNEXPECTED_KEY;
+            self->err.where = tok.where;
+        }
+        return false;
+    }
+    return true;
+}
+
+static CtAST *ast(CtParser *self, CtASTKind kind) {
+    CtAST *out = ctAlloc(self->alloc, sizeof(CtAST));
+    out->kind = kind;
+    out->shared = false;
+    return out;
+}
+
+/* the shared node for a literal or an operator over shared nodes, otherwise NULL */
+static CtAST *pShare(CtParser *self, CtASTKind kind, CtToken tok, CtAST *lhs, CtAST *rhs) {
+    CtConsKey key;
+
+    if (!self->cons)
+        return NULL;
+
+    memset(&key, 0, sizeof(CtConsKey));
+    key.kind = kind;
+    key.lhs = lhs;
+    key.rhs = rhs;
+
+    if (kind == AK_LITERAL) {
+        key.op = tok.kind;
+
+        if (tok.kind == TK_INT && tok.data.digit.suffix.len == 0 && !tok.data.digit.big)
+            key.value = tok.data.digit.num;
+        else if (tok.kind == TK_CHAR)
+            key.value = (uint8_t)tok.data.letter;
+        else
+            return NULL;
+    } else {
+        if (!lhs || !lhs->shared || (kind == AK_BINARY && (!rhs || !rhs->shared)))
+            return NULL;
+
+        key.op = tok.data.key;
+    }
+
+    return consNode(self->cons, &key, tok);
+}
+
+typedef enum {
+    OP_ERROR = 0,
+
+    OP_ASSIGN = 1,
+    OP_TERNARY = 2,
+    OP_LOGIC = 3,
+    OP_EQUAL = 4,
+    OP_COMPARE = 5,
+    OP_BITS = 6,
+    OP_SHIFT = 7,
+    OP_MATH = 8,
+    OP_MUL = 9
+} OpPrec;
+
+/* binds right to left */
+#define OF_RIGHT 0x1
+
+/* can also be a prefix operator */
+#define OF_UNARY 0x2
+
+typedef struct {
+    uint8_t prec;
+    uint8_t flags;
+} OpInfo;
+
+/* indexed by CtKey, anything that isnt an operator is all zeros */
+static const OpInfo opTable[] = {
+#define KEY(id, str, flags) { OP_ERROR, 0 },
+#define OP(id, str, prec, flags) { prec, flags },
+#include "keys.h"
+    { OP_ERROR, 0 }
+};
+
+static OpInfo opInfo(CtToken tok) {
+    return opTable[tok.kind == TK_KEY ? tok.data.key : K_INVALID];
+}
+
+static CtAST *pExpr(CtParser *self);
+static CtAST *pBinary(CtParser *self, OpPrec mprec);
+
+/**
+ * every level of nesting costs stack, so past CT_MAX_DEPTH the
+ * statement is an error rather than a crash. on success the
+ * caller must decrement depth once it is done
+ */
+static bool pDeeper(CtParser *self, CtToken tok) {
+    if (self->depth >= CT_MAX_DEPTH) {
+        if (self->err.kind == ERR_NONE) {
+            self->err.kind = ERR_TOO_DEEP;
+            self->err.where = tok.where;
+        }
+        return false;
+    }
+
+    self->depth++;
+    return true;
+}
+
+static CtAST *pPrimary(CtParser *self) {
+    CtToken tok = pPeek(self);
+    CtAST *node = NULL;
+
+    if (tok.kind == TK_CHAR || tok.kind == TK_INT || tok.kind == TK_STRING) {
+        tok = pNext(self);
+
+        if (!(node = pShare(self, AK_LITERAL, tok, NULL, NULL))) {
+            node = ast(self, AK_LITERAL);
+            node->tok = tok;
+        }
+    } else if (tok.kind == TK_IDENT) {
+        node = ast(self, AK_NAME);
+        node->tok = pNext(self);
+        node->data.target = NULL;
+    } else if (tok.kind == TK_KEY) {
+        if (opTable[tok.data.key].flags & OF_UNARY) {
+            CtAST *expr;
+
+            pNext(self);
+
+            /* - - - x nests just like ((x)) */
+            if (pDeeper(self, tok)) {
+                expr = pPrimary(self);
+                self->depth--;
+            } else {
+                expr = NULL;
+            }
+
+            if (!(node = pShare(self, AK_UNARY, tok, expr, NULL))) {
+                node = ast(self, AK_UNARY);
+                node->tok = tok;
+                node->data.expr = expr;
+            }
+        } else if (tok.data.key == K_LPAREN) {
+            pNext(self);
+            node = pExpr(self);
+            if (!pExpect(self, K_RPAREN) && self->err.kind != ERR_TOO_DEEP)
+                self->err.kind = ERR_MISSING_BRACE;
+        }
+    }
+
+    if (!node && self->err.kind == ERR_NONE) {
+        self->err.kind = ERR_UNEXPECTED_KEY;
+        self->err.where = tok.where;
+    }
+
+    return node;
+}
+
+static CtAST *binop(CtParser *self, CtAST *lhs, CtAST *rhs, CtToken tok) {
+    CtAST *node = pShare(self, AK_BINARY, tok, lhs, rhs);
+
+    if (node)
+        return node;
+
+    node = ast(self, AK_BINARY);
+    node->tok = tok;
+    node->data.binary.lhs = lhs;
+    node->data.binary.rhs = rhs;
+    return node;
+}
+
+static CtAST *pTernary(CtParser *self, CtAST *cond, CtToken tok) {
+    CtAST *node;
+    CtAST *lhs = pExpr(self);
+    CtAST *rhs;
+
+    if (!lhs || !pExpect(self, K_COLON)) {
+        ctASTFree(self, cond);
+        ctASTFree(self, lhs);
+        return NULL;
+    }
+
+    /* a ? b : c ? d : e is a ? b : (c ? d : e) */
+    if (!(rhs = pBinary(self, OP_TERNARY))) {
+        ctASTFree(self, cond);
+        ctASTFree(self, lhs);
+        return NULL;
+    }
+
+    node = ast(self, AK_TERNARY);
+    node->tok = tok;
+    node->data.ternary.cond = cond;
+    node->data.ternary.lhs = lhs;
+    node->data.ternary.rhs = rhs;
+    return node;
+}
+
+static CtAST *pBinary(CtParser *self, OpPrec mprec) {
+    CtAST *lhs;
+
+    if (!pDeeper(self, pPeek(self)))
+        return NULL;
+
+    lhs = pPrimary(self);
+
+    while (lhs) {
+        CtToken op = pPeek(self);
+        OpInfo info = opInfo(op);
+        CtAST *rhs;
+
+        if (!info.prec || info.prec < mprec)
+            break;
+
+        pNext(self);
+
+        if (info.prec == OP_TERNARY) {
+            lhs = pTernary(self, lhs, op);
+            continue;
+        }
+
+        /* right associative operators take their own level again on the right */
+        rhs = pBinary(self, (OpPrec)(info.flags & OF_RIGHT ? info.prec : info.prec + 1));
+
+        if (!rhs) {
+            ctASTFree(self, lhs);
+            lhs = NULL;
+            break;
+        }
+
+        lhs = binop(self, lhs, rhs, op);
+    }
+
+    self->depth--;
+    return lhs;
+}
+
+static CtAST *pExpr(CtParser *self) {
+    return pBinary(self, OP_ASSIGN);
+}
+
+/**
+ * declarations
+ */
+
+static size_t pMark(CtParser *self) {
+    return ctOffset(&self->scratch);
+}
+
+static void pPushItem(CtParser *self, CtAST *node) {
+    ctAppend(&self->scratch, (const char*)&node, sizeof(CtAST*));
+}
+
+/* move everything pushed since mark into the declarations items */
+static void pCollect(CtParser *self, CtAST *decl, size_t mark) {
+    size_t bytes = pMark(self) - mark;
+
+    decl->data.decl.len = bytes / sizeof(CtAST*);
+    decl->data.decl.items = NULL;
+
+    if (bytes) {
+        decl->data.decl.items = ctAlloc(self->alloc, bytes);
+        memcpy(decl->data.decl.items, ctAt(&self->scratch, mark), bytes);
+    }
+
+    ctRewind(&self->scratch, mark);
+}
+
+/* keep going until the closing key, the end of the file or an error */
+static bool pUntil(CtParser *self, CtKey key) {
+    CtToken tok = pPeek(self);
+
+    if (pIsKey(tok, key)) {
+        pNext(self);
+        return false;
+    }
+
+    return tok.kind != TK_END && self->err.kind == ERR_NONE;
+}
+
+static CtAST *pDeclName(CtParser *self, CtASTKind kind) {
+    CtToken tok = pNext(self);
+    CtAST *node;
+
+    if (tok.kind != TK_IDENT) {
+        self->err.kind = ERR_EXPECTED_NAME;
+        self->err.where = tok.where;
+        return NULL;
+    }
+
+    node = ast(self, kind);
+    node->tok = tok;
+    node->data.decl.body = NULL;
+    node->data.decl.items = NULL;
+    node->data.decl.len = 0;
+
+    return node;
+}
+
+static CtAST *pTypeName(CtParser *self) {
+    CtToken tok = pNext(self);
+    CtAST *node;
+
+    if (tok.kind != TK_IDENT) {
+        self->err.kind = ERR_EXPECTED_NAME;
+        self->err.where = tok.where;
+        return NULL;
+    }
+
+    node = ast(self, AK_NAME);
+    node->tok = tok;
+    node->data.target = NULL;
+
+    return node;
+}
+
+/* name(a, b, c) = body */
+static CtAST *pDef(CtParser *self) {
+    CtAST *node = pDeclName(self, AK_DEF);
+    size_t mark = pMark(self);
+
+    if (!node)
+        return NULL;
+
+    if (pConsume(self, K_LPAREN) && !pConsume(self, K_RPAREN)) {
+        do {
+            CtAST *param = pDeclName(self, AK_PARAM);
+            if (!param)
+                break;
+
+            pPushItem(self, param);
+        } while (pConsume(self, K_COMMA));
+
+        if (!pExpect(self, K_RPAREN))
+            self->err.kind = ERR_MISSING_BRACE;
+    }
+
+    pCollect(self, node, mark);
+
+    if (pConsume(self, K_ASSIGN))
+        node->data.decl.body = pExpr(self);
+
+    return node;
+}
+
+/* name = body */
+static CtAST *pVar(CtParser *self, CtASTKind kind) {
+    CtAST *node = pDeclName(self, kind);
+
+    if (!node)
+        return NULL;
+
+    if (pExpect(self, K_ASSIGN))
+        node->data.decl.body = kind == AK_ALIAS ? pTypeName(self) : pExpr(self);
+
+    return node;
+}
+
+/* name { field: type; ... } */
+static CtAST *pRecord(CtParser *self, CtASTKind kind) {
+    CtAST *node = pDeclName(self, kind);
+    size_t mark = pMark(self);
+
+    if (!node || !pExpect(self, K_LBRACE))
+        return node;
+
+    while (pUntil(self, K_RBRACE)) {
+        CtAST *field = pDeclName(self, AK_FIELD);
+        if (!field)
+            break;
+
+        if (pExpect(self, K_COLON))
+            field->data.decl.body = pTypeName(self);
+
+        pExpect(self, K_SEMI);
+        pPushItem(self, field);
+    }
+
+    pCollect(self, node, mark);
+    return node;
+}
+
+/* name { a, b, c } */
+static CtAST *pEnum(CtParser *self) {
+    CtAST *node = pDeclName(self, AK_ENUM);
+    size_t mark = pMark(self);
+
+    if (!node || !pExpect(self, K_LBRACE))
+        return node;
+
+    if (!pConsume(self, K_RBRACE)) {
+        do {
+            CtAST *item = pDeclName(self, AK_CASE);
+            if (!item)
+                break;
+
+            pPushItem(self, item);
+        } while (pConsume(self, K_COMMA));
+
+        if (!pExpect(self, K_RBRACE))
+            self->err.kind = ERR_MISSING_BRACE;
+    }
+
+    pCollect(self, node, mark);
+    return node;
+}
+
+/* name { def method(args); ... } */
+static CtAST *pTrait(CtParser *self) {
+    CtAST *node = pDeclName(self, AK_TRAIT);
+    size_t mark = pMark(self);
+
+    if (!node || !pExpect(self, K_LBRACE))
+        return node;
+
+    while (pUntil(self, K_RBRACE)) {
+        CtAST *method;
+
+        if (!pExpect(self, K_DEF))
+            break;
+
+        if (!(method = pDef(self)))
+            break;
+
+        pExpect(self, K_SEMI);
+        pPushItem(self, method);
+    }
+
+    pCollect(self, node, mark);
+    return node;
+}
+
+static CtAST *pStmt(CtParser *self) {
+    CtToken tok = pPeek(self);
+
+    if (tok.kind != TK_KEY)
+        return pExpr(self);
+
+    switch (tok.data.key) {
+    case K_DEF: pNext(self); return pDef(self);
+    case K_VAR: case K_LET: pNext(self); return pVar(self, AK_VAR);
+    case K_ALIAS: pNext(self); return pVar(self, AK_ALIAS);
+    case K_STRUCT: pNext(self); return pRecord(self, AK_STRUCT);
+    case K_UNION: pNext(self); return pRecord(self, AK_UNION);
+    case K_ENUM: pNext(self); return pEnum(self);
+    case K_TRAIT: pNext(self); return pTrait(self);
+    default: return pExpr(self);
+    }
+}
+
+void ctASTFree(CtParser *self, CtAST *node) {
+#if CT_MM_EAGER
+    if (!node || node->shared)
+        return;
+
+    switch (node->kind) {
+    case AK_BINARY:
+        ctASTFree(self, node->data.binary.lhs);
+        ctASTFree(self, node->data.binary.rhs);
+        break;
+    case AK_UNARY:
+        ctASTFree(self, node->data.expr);
+        break;
+    case AK_TERNARY:
+        ctASTFree(self, node->data.ternary.cond);
+        ctASTFree(self, node->data.ternary.lhs);
+        ctASTFree(self, node->data.ternary.rhs);
+        break;
+    case AK_LITERAL: case AK_NAME:
+        break;
+    default: {
+        size_t i;
+
+        ctASTFree(self, node->data.decl.body);
+
+        for (i = 0; i < node->data.decl.len; i++)
+            ctASTFree(self, node->data.decl.items[i]);
+
+        if (node->data.decl.items)
+            ctRelease(self->alloc, node->data.decl.items, sizeof(CtAST*) * node->data.decl.len);
+        break;
+    }
+    }
+
+    ctRelease(self->alloc, node, sizeof(CtAST));
+#else
+    CT_UNUSED(self);
+    CT_UNUSED(node);
+#endif
+}
+
+CtAST *ctParse(CtParser *self) {
+    CtAST *node;
+
+    if (pPeek(self).kind == TK_END)
+        return NULL;
+
+    node = pStmt(self);
+
+    if (self->err.kind == ERR_NONE && pExpect(self, K_SEMI))
+        return node;
+
+    /* skip the rest of a broken statement, a missing ; breaks it too */
+    while (pPeek(self).kind != TK_END && !pIsKey(pPeek(self), K_SEMI))
+        pNext(self);
+
+    if (pPeek(self).kind != TK_END)
+        pNext(self);
+
+    pReport(self, &self->err);
+    ctASTFree(self, node);
+
+    return NULL;
+}
+
+/**
+ * push parsing
+ */
+
+bool ctStmtEnds(CtToken tok, size_t *depth) {
+    if (tok.kind != TK_KEY)
+        return false;
+
+    switch (tok.data.key) {
+    case K_LPAREN: case K_LSQUARE: case K_LBRACE: case K_TBEGIN:
+        *depth += 1;
+        return false;
+
+    /* unbalanced closers are left for the parser to complain about */
+    case K_RPAREN: case K_RSQUARE: case K_RBRACE: case K_TEND:
+        if (*depth)
+            *depth -= 1;
+        return false;
+
+    case K_SEMI:
+        return *depth == 0;
+
+    default:
+        return false;
+    }
+}
+
+/* where the scanner is, only PS_CODE and PS_COMMENT are between tokens */
+typedef enum {
+    PS_CODE,
+    PS_COMMENT,
+    PS_STRING,
+    PS_ESCAPE,
+
+    /* right after a ', then after a \ in it */
+    PS_CHAR,
+    PS_CHAR_ESCAPE,
+
+    /* waiting for the closing ', then skipping junk up to a space like lexChar */
+    PS_CHAR_CLOSE,
+    PS_CHAR_JUNK
+} PushState;
+
+/**
+ * whitespace outside of strings, chars and comments always ends
+ * a token without being part of it, so every token before one is
+ * complete and lexing them never looks further ahead than it
+ */
+static void pushScan(CtPush *self, const char *text, size_t len) {
+    int state = self->state;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        char c = text[i];
+        bool space = false;
+
+        switch (state) {
+        case PS_CODE:
+            if (isSpace(c))
+                space = true;
+            else if (c == '#')
+                state = PS_COMMENT;
+            else if (c == '"')
+                state = PS_STRING;
+            else if (c == '\'')
+                state = PS_CHAR;
+            break;
+
+        case PS_COMMENT:
+            if (c == '\n') {
+                state = PS_CODE;
+                space = true;
+            }
+            break;
+
+        case PS_STRING:
+            if (c == '\\')
+                state = PS_ESCAPE;
+            else if (c == '"')
+                state = PS_CODE;
+            break;
+
+        case PS_ESCAPE:
+            state = PS_STRING;
+            break;
+
+        /* a linebreak right after the ' is part of the broken char */
+        case PS_CHAR:
+            if (c == '\\')
+                state = PS_CHAR_ESCAPE;
+            else if (c == '\n')
+                state = PS_CODE;
+            else
+                state = PS_CHAR_CLOSE;
+            break;
+
+        case PS_CHAR_ESCAPE:
+            state = PS_CHAR_CLOSE;
+            break;
+
+        case PS_CHAR_CLOSE:
+        case PS_CHAR_JUNK:
+            if (isSpace(c)) {
+                state = PS_CODE;
+                space = true;
+            } else {
+                state = c == '\'' && state == PS_CHAR_CLOSE ? PS_CODE : PS_CHAR_JUNK;
+            }
+            break;
+        }
+
+        if (space)
+            self->ready = self->solid;
+        else if (state != PS_COMMENT)
+            self->solid = self->fed + i + 1;
+    }
+
+    self->state = state;
+    self->fed += len;
+}
+
+static char pushNext(void *data) {
+    CtPush *self = data;
+
+    if (self->read == self->queue_len)
+        return '\0';
+
+    self->pulled++;
+    return self->queue[self->read++];
+}
+
+/* the stream reads its first byte when it is made, before anything was fed */
+static void pushPrime(CtPush *self) {
+    if (!self->primed) {
+        self->lex.stream.ahead = pushNext(self);
+        self->primed = true;
+    }
+}
+
+static void pushToken(CtPush *self, CtToken tok) {
+    if (self->token)
+        self->token(self, tok);
+
+    self->tokens = growArray(memFor(self->lex.stream.buffer.alloc, CT_MEM_TOKENS), self->tokens, &self->size, self->len + 1, sizeof(CtToken));
+    self->tokens[self->len++] = tok;
+
+    if (ctStmtEnds(tok, &self->depth))
+        self->cut = self->len;
+}
+
+/* parse the first len tokens and keep the rest for later, the end token only comes last */
+static void pushParse(CtPush *self, size_t len) {
+    CtParser *parser = &self->parser;
+
+    if (!len)
+        return;
+
+    parser->tokens = self->tokens;
+    parser->token_idx = 0;
+    parser->token_len = len;
+
+    while (pPeek(parser).kind != TK_END) {
+        CtAST *node = ctParse(parser);
+
+        if (node && self->stmt)
+            self->stmt(self, node);
+    }
+
+    /* the end of the slice isnt the end of the input */
+    parser->peeked = false;
+
+    memmove(self->tokens, self->tokens + len, sizeof(CtToken) * (self->len - len));
+    self->len -= len;
+    self->cut = 0;
+}
+
+void ctPushAlloc(
+    CtPush *self,
+    CtAllocator *alloc,
+    CtSources *sources,
+    const char *name,
+    CtAllocator *nodes,
+    size_t max_errs
+) {
+    self->token = NULL;
+    self->stmt = NULL;
+    self->data = NULL;
+
+    self->queue = NULL;
+    self->queue_len = 0;
+    self->queue_size = 0;
+    self->read = 0;
+
+    self->fed = 0;
+    self->pulled = 0;
+    self->ready = 0;
+    self->solid = 0;
+    self->state = PS_CODE;
+
+    self->tokens = NULL;
+    self->len = 0;
+    self->size = 0;
+    self->cut = 0;
+    self->depth = 0;
+
+    self->primed = false;
+    self->ended = false;
+    self->finished = false;
+
+    self->lex = ctLexerAlloc(ctStreamAlloc(alloc, sources, name, self, pushNext), max_errs);
+    self->parser = ctParserAlloc(&self->lex, nodes, max_errs);
+}
+
+void ctPushFree(CtPush *self) {
+    CtAllocator *alloc = self->lex.stream.buffer.alloc;
+
+    if (self->queue)
+        ctRelease(alloc, self->queue, self->queue_size);
+
+    if (self->tokens)
+        ctRelease(memFor(alloc, CT_MEM_TOKENS), self->tokens, sizeof(CtToken) * self->size);
+
+    ctParserFree(&self->parser);
+    ctLexerFree(&self->lex);
+}
+
+void ctFeed(CtPush *self, const char *text, size_t len) {
+    const char *nul;
+
+    if (self->ended || !len)
+        return;
+
+    if ((nul = memchr(text, '\0', len))) {
+        len = (size_t)(nul - text);
+        self->ended = true;
+    }
+
+    /* the lexer has its own copy of everything it read */
+    if (self->read > self->queue_len / 2) {
+        memmove(self->queue, self->queue + self->read, self->queue_len - self->read);
+        self->queue_len -= self->read;
+        self->read = 0;
+    }
+
+    self->queue = growArray(self->lex.stream.buffer.alloc, self->queue, &self->queue_size, self->queue_len + len, 1);
+    memcpy(self->queue + self->queue_len, text, len);
+    self->queue_len += len;
+
+    pushScan(self, text, len);
+
+    if (self->ready)
+        pushPrime(self);
+
+    /* the next byte the lexer looks at is pulled - 1 */
+    while (self->primed && self->ready >= self->pulled)
+        pushToken(self, ctLex(&self->lex));
+
+    pushParse(self, self->cut);
+}
+
+void ctFinish(CtPush *self) {
+    CtToken tok;
+
+    if (self->finished)
+        return;
+
+    self->ended = true;
+    self->finished = true;
+    pushPrime(self);
+
+    do {
+        tok = ctLex(&self->lex);
+        pushToken(self, tok);
+    } while (tok.kind != TK_END);
+
+    pushParse(self, self->len);
+}
+
+/**
+ * interned names
+ */
+
+CtNames ctNamesAlloc(CtAllocator *alloc) {
+    CtNames self;
+
+    self.alloc = memFor(alloc, CT_MEM_NAMES);
+    self.text = ctBufferAlloc(self.alloc, 0);
+
+    self.entries = NULL;
+    self.len = 0;
+    self.size = 0;
+
+    self.slots = NULL;
+    self.slot_size = 0;
+
+    return self;
+}
+
+void ctNamesFree(CtNames *self) {
+    ctBufferFree(self->text);
+
+    if (self->entries)
+        ctRelease(self->alloc, self->entries, sizeof(CtNameEntry) * self->size);
+
+    if (self->slots)
+        ctRelease(self->alloc, self->slots, sizeof(uint32_t) * self->slot_size);
+}
+
+static void namesRehash(CtNames *self) {
+    size_t size = self->slot_size ? self->slot_size * 2 : 64;
+    size_t mask = size - 1;
+    size_t i;
+
+    if (self->slots)
+        ctRelease(self->alloc, self->slots, sizeof(uint32_t) * self->slot_size);
+
+    self->slots = ctAlloc(self->alloc, sizeof(uint32_t) * size);
+    self->slot_size = size;
+    memset(self->slots, 0, sizeof(uint32_t) * size);
+
+    for (i = 0; i < self->len; i++) {
+        size_t slot = self->entries[i].hash & mask;
+
+        while (self->slots[slot])
+            slot = (slot + 1) & mask;
+
+        self->slots[slot] = (uint32_t)i + 1;
+    }
+}
+
+CtName ctIntern(CtNames *self, const char *text, size_t len) {
+    uint32_t hash = hashText(text, len);
+    CtNameEntry *entry;
+    size_t mask;
+    size_t slot;
+
+    if ((self->len + 1) * 2 > self->slot_size)
+        namesRehash(self);
+
+    mask = self->slot_size - 1;
+
+    for (slot = hash & mask; self->slots[slot]; slot = (slot + 1) & mask) {
+        entry = self->entries + self->slots[slot] - 1;
+
+        if (entry->hash == hash && entry->len == len && memcmp(ctAt(&self->text, entry->offset), text, len) == 0)
+            return self->slots[slot] - 1;
+    }
+
+    self->entries = growArray(self->alloc, self->entries, &self->size, self->len + 1, sizeof(CtNameEntry));
+
+    entry = self->entries + self->len;
+    entry->hash = hash;
+    entry->offset = (uint32_t)ctOffset(&self->text);
+    entry->len = (uint32_t)len;
+
+    ctAppend(&self->text, text, len);
+    ctPush(&self->text, '\0');
+
+    self->slots[slot] = (uint32_t)++self->len;
+    return (CtName)(self->len - 1);
+}
+
+const char *ctNameText(CtNames *self, CtName name) {
+    return ctAt(&self->text, self->entries[name].offset);
+}
+
+/**
+ * scopes
+ */
+
+CtScopes ctScopesAlloc(CtAllocator *alloc) {
+    CtScopes self;
+
+    self.alloc = memFor(alloc, CT_MEM_NAMES);
+
+    self.bindings = NULL;
+    self.len = 0;
+    self.size = 0;
+
+    self.heads = NULL;
+    self.head_size = 0;
+
+    self.base = 0;
+
+    return self;
+}
+
+void ctScopesFree(CtScopes *self) {
+    if (self->bindings)
+        ctRelease(self->alloc, self->bindings, sizeof(CtBinding) * self->size);
+
+    if (self->heads)
+        ctRelease(self->alloc, self->heads, sizeof(uint32_t) * self->head_size);
+}
+
+size_t ctScopePush(CtScopes *self) {
+    size_t mark = self->base;
+    self->base = self->len;
+    return mark;
+}
+
+void ctScopePop(CtScopes *self, size_t mark) {
+    while (self->len > self->base) {
+        CtBinding *binding = self->bindings + --self->len;
+        self->heads[binding->name] = binding->shadows;
+    }
+
+    self->base = mark;
+}
+
+bool ctScopeDeclare(CtScopes *self, CtName name, CtAST *decl) {
+    CtBinding *binding;
+    uint32_t head;
+
+    if (name >= self->head_size) {
+        size_t old = self->head_size;
+        self->heads = growArray(self->alloc, self->heads, &self->head_size, name + 1, sizeof(uint32_t));
+        memset(self->heads + old, 0xFF, sizeof(uint32_t) * (self->head_size - old));
+    }
+
+    head = self->heads[name];
+    if (head != CT_UNBOUND && head >= self->base)
+        return false;
+
+    self->bindings = growArray(self->alloc, self->bindings, &self->size, self->len + 1, sizeof(CtBinding));
+
+    binding = self->bindings + self->len;
+    binding->name = name;
+    binding->shadows = head;
+    binding->decl = decl;
+
+    self->heads[name] = (uint32_t)self->len++;
+    return true;
+}
+
+CtAST *ctScopeLookup(CtScopes *self, CtName name) {
+    if (name >= self->head_size || self->heads[name] == CT_UNBOUND)
+        return NULL;
+
+    return self->bindings[self->heads[name]].decl;
+}
+
+/**
+ * name resolution
+ */
+
+CtResolver ctResolverAlloc(CtLexer *lex, CtAllocator *alloc, size_t max_errs) {
+    CtResolver self;
+
+    self.lex = lex;
+    self.names = ctNamesAlloc(alloc);
+    self.scopes = ctScopesAlloc(alloc);
+
+    self.err.kind = ERR_NONE;
+
+    self.errs = ctAlloc(memFor(alloc, CT_MEM_DIAGNOSTICS), sizeof(CtError) * max_errs);
+    self.err_idx = 0;
+    self.max_errs = max_errs;
+
+    return self;
+}
+
+void ctResolverFree(CtResolver *self) {
+    ctRelease(memFor(self->names.alloc, CT_MEM_DIAGNOSTICS), self->errs, sizeof(CtError) * self->max_errs);
+    ctScopesFree(&self->scopes);
+    ctNamesFree(&self->names);
+}
+
+static void rReport(CtResolver *self, CtErrorKind kind, CtToken tok) {
+    self->err.kind = kind;
+    self->err.where = tok.where;
+
+    if (self->err_idx < self->max_errs)
+        self->errs[self->err_idx++] = self->err;
+
+    self->err.kind = ERR_NONE;
+}
+
+static CtName rName(CtResolver *self, CtToken tok) {
+    CtView view = tok.data.ident;
+    return ctIntern(&self->names, ctIdent(self->lex, view), view.len);
+}
+
+static void rDeclare(CtResolver *self, CtAST *decl) {
+    if (!ctScopeDeclare(&self->scopes, rName(self, decl->tok), decl))
+        rReport(self, ERR_REDEFINED_NAME, decl->tok);
+}
+
+static void rExpr(CtResolver *self, CtAST *node) {
+    if (!node)
+        return;
+
+    switch (node->kind) {
+    case AK_NAME:
+        node->data.target = ctScopeLookup(&self->scopes, rName(self, node->tok));
+        if (!node->data.target)
+            rReport(self, ERR_UNDEFINED_NAME, node->tok);
+        break;
+    case AK_BINARY:
+        rExpr(self, node->data.binary.lhs);
+        rExpr(self, node->data.binary.rhs);
+        break;
+    case AK_UNARY:
+        rExpr(self, node->data.expr);
+        break;
+    case AK_TERNARY:
+        rExpr(self, node->data.ternary.cond);
+        rExpr(self, node->data.ternary.lhs);
+        rExpr(self, node->data.ternary.rhs);
+        break;
+    default:
+        break;
+    }
+}
+
+static bool isDecl(CtAST *node) {
+    return node->kind >= AK_DEF && node->kind <= AK_TRAIT;
+}
+
+static void rDecl(CtResolver *self, CtAST *decl) {
+    size_t mark;
+    size_t i;
+
+    switch (decl->kind) {
+    case AK_DEF:
+        mark = ctScopePush(&self->scopes);
+        for (i = 0; i < decl->data.decl.len; i++)
+            rDeclare(self, decl->data.decl.items[i]);
+
+        rExpr(self, decl->data.decl.body);
+        ctScopePop(&self->scopes, mark);
+        break;
+
+    case AK_VAR: case AK_ALIAS:
+        rExpr(self, decl->data.decl.body);
+        break;
+
+    case AK_STRUCT: case AK_UNION: case AK_ENUM:
+        mark = ctScopePush(&self->scopes);
+        for (i = 0; i < decl->data.decl.len; i++) {
+            rDeclare(self, decl->data.decl.items[i]);
+            rExpr(self, decl->data.decl.items[i]->data.decl.body);
+        }
+        ctScopePop(&self->scopes, mark);
+        break;
+
+    case AK_TRAIT:
+        mark = ctScopePush(&self->scopes);
+        for (i = 0; i < decl->data.decl.len; i++) {
+            rDeclare(self, decl->data.decl.items[i]);
+            rDecl(self, decl->data.decl.items[i]);
+        }
+        ctScopePop(&self->scopes, mark);
+        break;
+
+    default:
+        rExpr(self, decl);
+        break;
+    }
+}
+
+void ctResolve(CtResolver *self, CtAST **decls, size_t len) {
+    size_t mark = ctScopePush(&self->scopes);
+    size_t i;
+
+    /* declare everything first so order doesnt matter */
+    for (i = 0; i < len; i++)
+        if (decls[i] && isDecl(decls[i]))
+            rDeclare(self, decls[i]);
+
+    for (i = 0; i < len; i++)
+        if (decls[i])
+            rDecl(self, decls[i]);
+
+    ctScopePop(&self->scopes, mark);
+}
+
+/**
+ * evaluation
+ */
+
+/* wrapping arithmetic is done unsigned, converting back relies on twos complement */
+#define WRAP(op, lhs, rhs) ((CtInt)((uint64_t)(lhs) op (uint64_t)(rhs)))
+
+#define INT_MIN64 ((CtInt)((uint64_t)1 << 63))
+
+CtFunction ctFunctionAlloc(CtAST *node, size_t hot) {
+    CtFunction self;
+
+    if (node->kind == AK_DEF) {
+        self.body = node->data.decl.body;
+        self.params = node->data.decl.items;
+        self.len = node->data.decl.len;
+    } else {
+        self.body = node;
+        self.params = NULL;
+        self.len = 0;
+    }
+
+    self.calls = 0;
+    self.hot = CT_HAS_JIT ? hot : 0;
+
+    self.code = NULL;
+    self.size = 0;
+    self.native = NULL;
+
+    self.err.kind = ERR_NONE;
+
+    return self;
+}
+
+static bool evalFail(CtFunction *self, CtErrorKind kind, CtAST *node) {
+    self->err.kind = kind;
+    self->err.where = node->tok.where;
+    return false;
+}
+
+/* the argument a name refers to, or -1 */
+static int evalParam(CtFunction *self, CtAST *node) {
+    size_t i;
+
+    for (i = 0; i < self->len; i++)
+        if (self->params[i] == node->data.target)
+            return (int)i;
+
+    return -1;
+}
+
+static bool evalLiteral(CtAST *node, CtInt *out) {
+    switch (node->tok.kind) {
+    case TK_INT: *out = (CtInt)node->tok.data.digit.num; return true;
+    case TK_CHAR: *out = (uint8_t)node->tok.data.letter; return true;
+    default: return false;
+    }
+}
+
+static CtInt shiftRight(CtInt lhs, CtInt rhs) {
+    int n = (int)(rhs & 63);
+    return lhs < 0 ? ~(~lhs >> n) : lhs >> n;
+}
+
+static bool eval(CtFunction *self, CtAST *node, const CtInt *args, CtInt *out) {
+    CtInt lhs;
+    CtInt rhs;
+    int param;
+
+    if (!node)
+        return false;
+
+    switch (node->kind) {
+    case AK_LITERAL:
+        return evalLiteral(node, out) || evalFail(self, ERR_UNSUPPORTED, node);
+
+    case AK_NAME:
+        if ((param = evalParam(self, node)) < 0)
+            return evalFail(self, ERR_UNSUPPORTED, node);
+
+        *out = args[param];
+        return true;
+
+    case AK_UNARY:
+        if (!eval(self, node->data.expr, args, &lhs))
+            return false;
+
+        switch (node->tok.data.key) {
+        case K_ADD: *out = lhs; return true;
+        case K_SUB: *out = WRAP(-, 0, lhs); return true;
+        case K_BITNOT: *out = ~lhs; return true;
+        case K_NOT: *out = !lhs; return true;
+        default: return evalFail(self, ERR_UNSUPPORTED, node);
+        }
+
+    case AK_TERNARY:
+        if (!eval(self, node->data.ternary.cond, args, &lhs))
+            return false;
+
+        return eval(self, lhs ? node->data.ternary.lhs : node->data.ternary.rhs, args, out);
+
+    case AK_BINARY:
+        if (!eval(self, node->data.binary.lhs, args, &lhs))
+            return false;
+
+        /* short circuit before looking at the rhs */
+        if (node->tok.data.key == K_AND && !lhs) {
+            *out = 0;
+            return true;
+        } else if (node->tok.data.key == K_OR && lhs) {
+            *out = 1;
+            return true;
+        }
+
+        if (!eval(self, node->data.binary.rhs, args, &rhs))
+            return false;
+
+        switch (node->tok.data.key) {
+        case K_ADD: *out = WRAP(+, lhs, rhs); return true;
+        case K_SUB: *out = WRAP(-, lhs, rhs); return true;
+        case K_MUL: *out = WRAP(*, lhs, rhs); return true;
+        case K_DIV: case K_MOD:
+            if (rhs == 0)
+                return evalFail(self, ERR_DIVIDE_BY_ZERO, node);
+
+            /* INT_MIN / -1 overflows, x / -1 is just -x */
+            if (rhs == -1)
+                *out = node->tok.data.key == K_DIV ? WRAP(-, 0, lhs) : 0;
+            else
+                *out = node->tok.data.key == K_DIV ? lhs / rhs : lhs % rhs;
+            return true;
+        case K_SHL: *out = WRAP(<<, lhs, rhs & 63); return true;
+        case K_SHR: *out = shiftRight(lhs, rhs); return true;
+        case K_BITAND: *out = lhs & rhs; return true;
+        case K_BITOR: *out = lhs | rhs; return true;
+        case K_XOR: *out = lhs ^ rhs; return true;
+        case K_EQ: *out = lhs == rhs; return true;
+        case K_NEQ: *out = lhs != rhs; return true;
+        case K_LT: *out = lhs < rhs; return true;
+        case K_LTE: *out = lhs <= rhs; return true;
+        case K_GT: *out = lhs > rhs; return true;
+        case K_GTE: *out = lhs >= rhs; return true;
+        case K_AND: case K_OR: *out = rhs != 0; return true;
+        default: return evalFail(self, ERR_UNSUPPORTED, node);
+        }
+
+    default:
+        return evalFail(self, ERR_UNSUPPORTED, node);
+    }
+}
+
+bool ctCall(CtFunction *self, const CtInt *args, CtInt *out) {
+    if (self->native) {
+        /* on failure the interpreter reruns it to say exactly where */
+        if (self->native(args, out) == 0)
+            return true;
+    } else if (self->hot && ++self->calls >= self->hot) {
+        if (!ctCompile(self))
+            self->hot = 0;
+    }
+
+    self->err.kind = ERR_NONE;
+    return eval(self, self->body, args, out);
+}
+
+/**
+ * exact evaluation. while both sides are small the int64 result is
+ * checked for overflow, only when it would overflow do they become
+ * limbs on the stack and the result gets allocated
+ */
+
+/* a signed magnitude being worked on, big enough for any product */
+typedef struct {
+    bool negative;
+    uint32_t len;
+    uint32_t limbs[MAX_LIMBS * 2];
+} Wide;
+
+typedef struct {
+    CtAllocator *alloc;
+    CtError err;
+
+    /* scratch for one op at a time, kept out of the recursion */
+    Wide a, b, res, rem;
+} Exact;
+
+static void wideTrim(Wide *self) {
+    while (self->len && self->limbs[self->len - 1] == 0)
+        self->len--;
+
+    if (self->len == 0)
+        self->negative = false;
+}
+
+static void wideOf(CtNum num, Wide *out) {
+    uint64_t mag;
+
+    if (num.big) {
+        out->negative = num.big->negative;
+        out->len = num.big->len;
+        memcpy(out->limbs, num.big->limbs, sizeof(uint32_t) * num.big->len);
+        return;
+    }
+
+    mag = num.value < 0 ? 0 - (uint64_t)num.value : (uint64_t)num.value;
+
+    out->negative = num.value < 0;
+    out->len = 2;
+    out->limbs[0] = (uint32_t)mag;
+    out->limbs[1] = (uint32_t)(mag >> 32);
+
+    wideTrim(out);
+}
+
+static uint32_t wideBits(const Wide *self) {
+    uint32_t top;
+    uint32_t bits;
+
+    if (self->len == 0)
+        return 0;
+
+    top = self->limbs[self->len - 1];
+    bits = (self->len - 1) * 32;
+
+    while (top) {
+        top >>= 1;
+        bits++;
+    }
+
+    return bits;
+}
+
+static bool exactFail(Exact *self, CtErrorKind kind, CtAST *node) {
+    self->err.kind = kind;
+    self->err.where = node->tok.where;
+    return false;
+}
+
+/* back to a CtNum, small if it fits */
+static bool exactMake(Exact *self, CtAST *node, Wide *wide, CtNum *out) {
+    uint64_t low;
+
+    wideTrim(wide);
+    low = limbsLow(wide->limbs, wide->len);
+
+    out->value = wide->negative ? WRAP(-, 0, low) : (CtInt)low;
+    out->big = NULL;
+
+    if (wide->len <= 2 && (wide->negative ? low <= (uint64_t)1 << 63 : low <= (uint64_t)INT64_MAX))
+        return true;
+
+    if (wideBits(wide) > CT_MAX_BITS)
+        return exactFail(self, ERR_OVERFLOW, node);
+
+    out->big = bigCopy(self->alloc, wide->negative, wide->limbs, wide->len);
+    return true;
+}
+
+static int magCmp(const Wide *lhs, const Wide *rhs) {
+    uint32_t i;
+
+    if (lhs->len != rhs->len)
+        return lhs->len < rhs->len ? -1 : 1;
+
+    for (i = lhs->len; i-- > 0;)
+        if (lhs->limbs[i] != rhs->limbs[i])
+            return lhs->limbs[i] < rhs->limbs[i] ? -1 : 1;
+
+    return 0;
+}
+
+static int wideCmp(const Wide *lhs, const Wide *rhs) {
+    if (lhs->negative != rhs->negative)
+        return lhs->negative ? -1 : 1;
+
+    return lhs->negative ? magCmp(rhs, lhs) : magCmp(lhs, rhs);
+}
+
+static void magAdd(Wide *out, const Wide *lhs, const Wide *rhs) {
+    uint32_t len = lhs->len > rhs->len ? lhs->len : rhs->len;
+    uint64_t carry = 0;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        carry += i < lhs->len ? lhs->limbs[i] : 0;
+        carry += i < rhs->len ? rhs->limbs[i] : 0;
+        out->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    out->limbs[len] = (uint32_t)carry;
+    out->len = len + 1;
+}
+
+/* lhs is at least as big as rhs, out may be lhs */
+static void magSub(Wide *out, const Wide *lhs, const Wide *rhs) {
+    uint32_t borrow = 0;
+    uint32_t i;
+
+    for (i = 0; i < lhs->len; i++) {
+        uint64_t sub = (uint64_t)(i < rhs->len ? rhs->limbs[i] : 0) + borrow;
+        borrow = lhs->limbs[i] < sub;
+        out->limbs[i] = (uint32_t)(lhs->limbs[i] - sub);
+    }
+
+    out->len = lhs->len;
+}
+
+static void wideAdd(Wide *out, const Wide *lhs, const Wide *rhs) {
+    if (lhs->negative == rhs->negative) {
+        magAdd(out, lhs, rhs);
+        out->negative = lhs->negative;
+    } else if (magCmp(lhs, rhs) >= 0) {
+        magSub(out, lhs, rhs);
+        out->negative = lhs->negative;
+    } else {
+        magSub(out, rhs, lhs);
+        out->negative = rhs->negative;
+    }
+
+    wideTrim(out);
+}
+
+static void wideMul(Wide *out, const Wide *lhs, const Wide *rhs) {
+    uint32_t i, j;
+
+    out->len = lhs->len + rhs->len;
+    memset(out->limbs, 0, sizeof(uint32_t) * out->len);
+
+    for (i = 0; i < lhs->len; i++) {
+        uint64_t carry = 0;
+
+        for (j = 0; j < rhs->len; j++) {
+            carry += (uint64_t)lhs->limbs[i] * rhs->limbs[j] + out->limbs[i + j];
+            out->limbs[i + j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+
+        out->limbs[i + rhs->len] = (uint32_t)carry;
+    }
+
+    out->negative = lhs->negative != rhs->negative;
+    wideTrim(out);
+}
+
+/* truncating division of magnitudes, rhs isnt zero */
+static void wideDiv(Wide *quot, Wide *rem, const Wide *lhs, const Wide *rhs) {
+    uint32_t bits = wideBits(lhs);
+    uint32_t i;
+
+    quot->len = lhs->len;
+    memset(quot->limbs, 0, sizeof(uint32_t) * quot->len);
+    rem->len = 0;
+    rem->negative = false;
+
+    /* one bit at a time, the operands are only ever a few limbs */
+    for (i = bits; i-- > 0;) {
+        uint32_t carry = (lhs->limbs[i / 32] >> (i % 32)) & 1;
+        uint32_t j;
+
+        for (j = 0; j < rem->len; j++) {
+            uint32_t top = rem->limbs[j] >> 31;
+            rem->limbs[j] = (rem->limbs[j] << 1) | carry;
+            carry = top;
+        }
+
+        if (carry)
+            rem->limbs[rem->len++] = carry;
+
+        if (magCmp(rem, rhs) >= 0) {
+            magSub(rem, rem, rhs);
+            wideTrim(rem);
+            quot->limbs[i / 32] |= (uint32_t)1 << (i % 32);
+        }
+    }
+
+    quot->negative = lhs->negative != rhs->negative;
+    rem->negative = lhs->negative;
+
+    wideTrim(quot);
+    wideTrim(rem);
+}
+
+/* shift the magnitude, left when count is positive */
+static void magShift(Wide *out, const Wide *lhs, uint32_t count, bool left) {
+    uint32_t limbs = count / 32;
+    uint32_t bits = count % 32;
+    uint32_t i;
+
+    if (left) {
+        out->len = lhs->len + limbs + 1;
+        memset(out->limbs, 0, sizeof(uint32_t) * out->len);
+
+        for (i = 0; i < lhs->len; i++) {
+            uint64_t part = (uint64_t)lhs->limbs[i] << bits;
+            out->limbs[i + limbs] |= (uint32_t)part;
+            out->limbs[i + limbs + 1] |= (uint32_t)(part >> 32);
+        }
+    } else {
+        out->len = lhs->len > limbs ? lhs->len - limbs : 0;
+
+        for (i = 0; i < out->len; i++) {
+            uint64_t part = lhs->limbs[i + limbs];
+
+            if (i + limbs + 1 < lhs->len)
+                part |= (uint64_t)lhs->limbs[i + limbs + 1] << 32;
+
+            out->limbs[i] = (uint32_t)(part >> bits);
+        }
+    }
+
+    out->negative = lhs->negative;
+    wideTrim(out);
+}
+
+/* add or take one from the magnitude, taking needs it to be nonzero */
+static void magInc(Wide *self) {
+    uint32_t i;
+
+    for (i = 0; i < self->len; i++)
+        if (++self->limbs[i] != 0)
+            return;
+
+    self->limbs[self->len++] = 1;
+}
+
+static void magDec(Wide *self) {
+    uint32_t i;
+
+    for (i = 0; i < self->len; i++)
+        if (self->limbs[i]-- != 0)
+            break;
+
+    wideTrim(self);
+}
+
+/* >> rounds towards negative infinity, so -x >> n is -((x - 1) >> n) - 1 */
+static void wideShr(Wide *out, Wide *lhs, uint32_t count) {
+    if (!lhs->negative) {
+        magShift(out, lhs, count, false);
+        return;
+    }
+
+    magDec(lhs);
+    magShift(out, lhs, count, false);
+    magInc(out);
+
+    out->negative = true;
+}
+
+/* twos complement in width limbs and back again, both in place */
+static void toTwos(Wide *self, uint32_t width) {
+    uint64_t carry = 1;
+    uint32_t i;
+
+    memset(self->limbs + self->len, 0, sizeof(uint32_t) * (width - self->len));
+    self->len = width;
+
+    if (!self->negative)
+        return;
+
+    for (i = 0; i < width; i++) {
+        carry += (uint32_t)~self->limbs[i];
+        self->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+static void fromTwos(Wide *self) {
+    uint64_t carry = 1;
+    uint32_t i;
+
+    self->negative = self->limbs[self->len - 1] >> 31;
+
+    for (i = 0; self->negative && i < self->len; i++) {
+        carry += (uint32_t)~self->limbs[i];
+        self->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    wideTrim(self);
+}
+
+/* lhs ends up with the result */
+static void wideLogic(CtKey key, Wide *lhs, Wide *rhs) {
+    uint32_t width = (lhs->len > rhs->len ? lhs->len : rhs->len) + 1;
+    uint32_t i;
+
+    toTwos(lhs, width);
+    toTwos(rhs, width);
+
+    for (i = 0; i < width; i++) {
+        switch (key) {
+        case K_BITAND: lhs->limbs[i] &= rhs->limbs[i]; break;
+        case K_BITOR: lhs->limbs[i] |= rhs->limbs[i]; break;
+        default: lhs->limbs[i] ^= rhs->limbs[i]; break;
+        }
+    }
+
+    fromTwos(lhs);
+}
+
+/* ops on two int64s that cant overflow, false when the result needs limbs */
+static bool exactSmall(CtKey key, CtInt lhs, CtInt rhs, CtInt *out) {
+    switch (key) {
+    case K_ADD:
+        *out = WRAP(+, lhs, rhs);
+        return ((lhs ^ *out) & (rhs ^ *out)) >= 0;
+    case K_SUB:
+        *out = WRAP(-, lhs, rhs);
+        return ((lhs ^ rhs) & (lhs ^ *out)) >= 0;
+    case K_MUL:
+        *out = WRAP(*, lhs, rhs);
+        return lhs == 0 || (!(lhs == -1 && rhs == INT_MIN64) && *out / lhs == rhs);
+    case K_DIV:
+        *out = rhs == -1 ? WRAP(-, 0, lhs) : lhs / rhs;
+        return !(lhs == INT_MIN64 && rhs == -1);
+    case K_MOD:
+        *out = rhs == -1 ? 0 : lhs % rhs;
+        return true;
+    case K_SHL:
+        *out = rhs < 63 ? WRAP(<<, lhs, rhs) : 0;
+        return rhs < 63 && shiftRight(*out, rhs) == lhs;
+    case K_SHR:
+        *out = rhs < 63 ? shiftRight(lhs, rhs) : (lhs < 0 ? -1 : 0);
+        return true;
+    case K_BITAND: *out = lhs & rhs; return true;
+    case K_BITOR: *out = lhs | rhs; return true;
+    case K_XOR: *out = lhs ^ rhs; return true;
+    case K_EQ: *out = lhs == rhs; return true;
+    case K_NEQ: *out = lhs != rhs; return true;
+    case K_LT: *out = lhs < rhs; return true;
+    case K_LTE: *out = lhs <= rhs; return true;
+    case K_GT: *out = lhs > rhs; return true;
+    case K_GTE: *out = lhs >= rhs; return true;
+    default: return false;
+    }
+}
+
+static bool exactBinary(Exact *self, CtAST *node, CtNum lhs, CtNum rhs, CtNum *out) {
+    CtKey key = node->tok.data.key;
+    Wide *a = &self->a;
+    Wide *b = &self->b;
+    Wide *res = &self->res;
+    uint32_t count = 0;
+    int cmp;
+
+    if ((key == K_DIV || key == K_MOD) && !rhs.big && rhs.value == 0)
+        return exactFail(self, ERR_DIVIDE_BY_ZERO, node);
+
+    if (key == K_SHL || key == K_SHR) {
+        if (rhs.big ? rhs.big->negative : rhs.value < 0)
+            return exactFail(self, ERR_UNSUPPORTED, node);
+
+        /* past CT_MAX_BITS the answer is either an overflow or all sign bits */
+        if (rhs.big || rhs.value > CT_MAX_BITS) {
+            if (key == K_SHL && (lhs.big || lhs.value))
+                return exactFail(self, ERR_OVERFLOW, node);
+
+            out->value = key == K_SHR && (lhs.big ? lhs.big->negative : lhs.value < 0) ? -1 : 0;
+            out->big = NULL;
+            return true;
+        }
+
+        count = (uint32_t)rhs.value;
+    }
+
+    out->big = NULL;
+
+    if (!lhs.big && !rhs.big && exactSmall(key, lhs.value, rhs.value, &out->value))
+        return true;
+
+    wideOf(lhs, a);
+    wideOf(rhs, b);
+
+    switch (key) {
+    case K_ADD: wideAdd(res, a, b); break;
+    case K_SUB: b->negative = b->len && !b->negative; wideAdd(res, a, b); break;
+    case K_MUL: wideMul(res, a, b); break;
+    case K_DIV: wideDiv(res, &self->rem, a, b); break;
+    case K_MOD: wideDiv(&self->rem, res, a, b); break;
+    case K_SHL: magShift(res, a, count, true); break;
+    case K_SHR: wideShr(res, a, count); break;
+    case K_BITAND: case K_BITOR: case K_XOR: wideLogic(key, a, b); res = a; break;
+
+    case K_EQ: case K_NEQ: case K_LT: case K_LTE: case K_GT: case K_GTE:
+        cmp = wideCmp(a, b);
+
+        switch (key) {
+        case K_EQ: out->value = cmp == 0; break;
+        case K_NEQ: out->value = cmp != 0; break;
+        case K_LT: out->value = cmp < 0; break;
+        case K_LTE: out->value = cmp <= 0; break;
+        case K_GT: out->value = cmp > 0; break;
+        default: out->value = cmp >= 0; break;
+        }
+        return true;
+
+    default:
+        return exactFail(self, ERR_UNSUPPORTED, node);
+    }
+
+    return exactMake(self, node, res, out);
+}
+
+static bool truthy(CtNum num) {
+    return num.big || num.value;
+}
+
+static bool exact(Exact *self, CtAST *node, CtNum *out) {
+    CtNum lhs;
+    CtNum rhs;
+
+    if (!node)
+        return false;
+
+    switch (node->kind) {
+    case AK_LITERAL:
+        out->big = NULL;
+
+        if (node->tok.kind == TK_INT) {
+            out->value = (CtInt)node->tok.data.digit.num;
+            out->big = node->tok.data.digit.big;
+            return true;
+        } else if (node->tok.kind == TK_CHAR) {
+            out->value = (uint8_t)node->tok.data.letter;
+            return true;
+        }
+
+        return exactFail(self, ERR_UNSUPPORTED, node);
+
+    case AK_UNARY:
+        if (!exact(self, node->data.expr, &lhs))
+            return false;
+
+        *out = lhs;
+
+        switch (node->tok.data.key) {
+        case K_ADD:
+            return true;
+        case K_NOT:
+            out->value = !truthy(lhs);
+            out->big = NULL;
+            return true;
+        case K_SUB: case K_BITNOT:
+            /* ~x is -x - 1, both only need limbs at the edges */
+            if (!lhs.big && lhs.value != INT_MIN64) {
+                out->value = node->tok.data.key == K_SUB ? -lhs.value : ~lhs.value;
+                return true;
+            }
+
+            wideOf(lhs, &self->a);
+            self->a.negative = self->a.len && !self->a.negative;
+
+            if (node->tok.data.key == K_SUB)
+                return exactMake(self, node, &self->a, out);
+
+            if (self->a.negative || self->a.len == 0) {
+                magInc(&self->a);
+                self->a.negative = true;
+            } else {
+                magDec(&self->a);
+            }
+
+            return exactMake(self, node, &self->a, out);
+        default:
+            return exactFail(self, ERR_UNSUPPORTED, node);
+        }
+
+    case AK_TERNARY:
+        if (!exact(self, node->data.ternary.cond, &lhs))
+            return false;
+
+        return exact(self, truthy(lhs) ? node->data.ternary.lhs : node->data.ternary.rhs, out);
+
+    case AK_BINARY:
+        if (!exact(self, node->data.binary.lhs, &lhs))
+            return false;
+
+        out->big = NULL;
+
+        /* short circuit before looking at the rhs */
+        if (node->tok.data.key == K_AND && !truthy(lhs)) {
+            out->value = 0;
+            return true;
+        } else if (node->tok.data.key == K_OR && truthy(lhs)) {
+            out->value = 1;
+            return true;
+        }
+
+        if (!exact(self, node->data.binary.rhs, &rhs))
+            return false;
+
+        if (node->tok.data.key == K_AND || node->tok.data.key == K_OR) {
+            out->value = truthy(rhs);
+            return true;
+        }
+
+        return exactBinary(self, node, lhs, rhs, out);
+
+    default:
+        return exactFail(self, ERR_UNSUPPORTED, node);
+    }
+}
+
+bool ctEvalNum(CtAST *node, CtAllocator *alloc, CtNum *out, CtError *err) {
+    Exact self;
+
+    self.alloc = alloc;
+    self.err.kind = ERR_NONE;
+
+    if (exact(&self, node, out))
+        return true;
+
+    *err = self.err;
+    return false;
+}
+
+void ctNumDecimal(CtNum num, CtBuffer *out) {
+    /* nine digits at a time, most significant last */
+    uint32_t parts[MAX_LIMBS * 2];
+    size_t len = 0;
+    size_t first;
+    char text[24];
+    Wide wide;
+
+    if (num.big ? num.big->negative : num.value < 0)
+        ctPush(out, '-');
+
+    if (!num.big) {
+        uint64_t mag = num.value < 0 ? 0 - (uint64_t)num.value : (uint64_t)num.value;
+
+        do {
+            text[len++] = (char)('0' + mag % 10);
+            mag /= 10;
+        } while (mag);
+
+        while (len)
+            ctPush(out, text[--len]);
+
+        return;
+    }
+
+    wideOf(num, &wide);
+
+    do {
+        uint64_t rem = 0;
+        uint32_t i;
+
+        for (i = wide.len; i-- > 0;) {
+            rem = (rem << 32) | wide.limbs[i];
+            wide.limbs[i] = (uint32_t)(rem / 1000000000u);
+            rem %= 1000000000u;
+        }
+
+        parts[len++] = (uint32_t)rem;
+        wideTrim(&wide);
+    } while (wide.len);
+
+    first = len - 1;
+
+    /* every part after the first is zero padded to nine digits */
+    while (len--) {
+        uint32_t part = parts[len];
+        size_t digits = 0;
+
+        do {
+            text[digits++] = (char)('0' + part % 10);
+            part /= 10;
+        } while (part || (digits < 9 && len < first));
+
+        while (digits)
+            ctPush(out, text[--digits]);
+    }
+}
+
+size_t ctConsFold(CtCons *self) {
+    CtArena scratch = ctArenaAlloc(self->alloc, CT_MM_ARENA);
+    CtArenaMark mark = ctArenaMark(&scratch);
+    size_t folded = 0;
+    size_t i;
+
+    /* children come before their parents so they are already folded */
+    for (i = 0; i < self->len; i++) {
+        CtAST *node = self->entries[i].node;
+        CtNum value;
+        CtError err;
+
+        if (node->kind == AK_LITERAL)
+            continue;
+
+        if (ctEvalNum(node, &scratch.base, &value, &err)) {
+            const CtBig *big = value.big;
+
+            node->kind = AK_LITERAL;
+            node->tok.kind = TK_INT;
+            node->tok.data.digit.enc = BASE10;
+            node->tok.data.digit.num = (size_t)value.value;
+            node->tok.data.digit.big = big ? bigCopy(self->alloc, big->negative, big->limbs, big->len) : NULL;
+            node->tok.data.digit.suffix.offset = 0;
+            node->tok.data.digit.suffix.len = 0;
+            folded++;
+        }
+
+        ctArenaRewind(&scratch, mark);
+    }
+
+    ctArenaFree(&scratch);
+    return folded;
+}
+
+#if CT_HAS_JIT
+
+#include <sys/mman.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#   define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#ifndef MAP_ANONYMOUS
+#   error "CT_JIT needs MAP_ANONYMOUS, define _DEFAULT_SOURCE"
+#endif
+
+/**
+ * a tiny x86-64 code generator, every node leaves its value in rax.
+ * the lhs of a binary op is pushed while the rhs is generated, rbx
+ * holds the entry stack pointer so errors can bail out from any depth.
+ * args come in rdi and the result pointer in rsi, neither is touched
+ */
+
+#define EMIT(code, bytes) ctAppend(code, bytes, sizeof(bytes) - 1)
+
+typedef struct {
+    CtFunction *func;
+
+    /* offsets of every jump to the error exit */
+    CtBuffer code;
+    CtBuffer fails;
+} Jit;
+
+static void emit32(CtBuffer *code, uint32_t value) {
+    int i;
+    for (i = 0; i < 4; i++)
+        ctPush(code, (char)(value >> (i * 8)));
+}
+
+static void emit64(CtBuffer *code, uint64_t value) {
+    int i;
+    for (i = 0; i < 8; i++)
+        ctPush(code, (char)(value >> (i * 8)));
+}
+
+/* emit a forward jump and return where its rel32 ends */
+static size_t jitJump(CtBuffer *code, const char *op, size_t len) {
+    ctAppend(code, op, len);
+    emit32(code, 0);
+    return ctOffset(code);
+}
+
+/* point a forward jump at the end of the code */
+static void jitPatch(CtBuffer *code, size_t from) {
+    uint32_t rel = (uint32_t)(ctOffset(code) - from);
+    char *at = (char*)ctAt(code, from - 4);
+    int i;
+
+    for (i = 0; i < 4; i++)
+        at[i] = (char)(rel >> (i * 8));
+}
+
+static void jitFail(Jit *self, const char *op, size_t len) {
+    size_t from = jitJump(&self->code, op, len);
+    ctAppend(&self->fails, (const char*)&from, sizeof(size_t));
+}
+
+/* rax = rax != 0 */
+static void jitBool(CtBuffer *code) {
+    EMIT(code, "\x48\x85\xC0\x0F\x95\xC0\x0F\xB6\xC0");
+}
+
+static bool jitNode(Jit *self, CtAST *node);
+
+static bool jitLogic(Jit *self, CtAST *node) {
+    CtBuffer *code = &self->code;
+    size_t skip;
+    size_t end;
+
+    if (!jitNode(self, node->data.binary.lhs))
+        return false;
+
+    EMIT(code, "\x48\x85\xC0");
+
+    if (node->tok.data.key == K_AND) {
+        /* rax is already 0 when skipping */
+        end = jitJump(code, "\x0F\x84", 2);
+    } else {
+        skip = jitJump(code, "\x0F\x84", 2);
+        EMIT(code, "\xB8\x01\x00\x00\x00");
+        end = jitJump(code, "\xE9", 1);
+        jitPatch(code, skip);
+    }
+
+    if (!jitNode(self, node->data.binary.rhs))
+        return false;
+
+    jitBool(code);
+    jitPatch(code, end);
+    return true;
+}
+
+static bool jitDivide(Jit *self, CtAST *node) {
+    CtBuffer *code = &self->code;
+    bool div = node->tok.data.key == K_DIV;
+    size_t slow;
+    size_t end;
+
+    /* test rcx, rcx; jz fail */
+    EMIT(code, "\x48\x85\xC9");
+    jitFail(self, "\x0F\x84", 2);
+
+    /* cmp rcx, -1; jne slow; neg rax or xor eax, eax */
+    EMIT(code, "\x48\x83\xF9\xFF");
+    slow = jitJump(code, "\x0F\x85", 2);
+
+    if (div)
+        EMIT(code, "\x48\xF7\xD8");
+    else
+        EMIT(code, "\x31\xC0");
+
+    end = jitJump(code, "\xE9", 1);
+    jitPatch(code, slow);
+
+    /* cqo; idiv rcx */
+    EMIT(code, "\x48\x99\x48\xF7\xF9");
+
+    if (!div)
+        EMIT(code, "\x48\x89\xD0");
+
+    jitPatch(code, end);
+    return true;
+}
+
+static bool jitBinary(Jit *self, CtAST *node) {
+    CtBuffer *code = &self->code;
+
+    if (node->tok.data.key == K_AND || node->tok.data.key == K_OR)
+        return jitLogic(self, node);
+
+    if (!jitNode(self, node->data.binary.lhs))
+        return false;
+
+    /* push rax; <rhs>; mov rcx, rax; pop rax */
+    EMIT(code, "\x50");
+
+    if (!jitNode(self, node->data.binary.rhs))
+        return false;
+
+    EMIT(code, "\x48\x89\xC1\x58");
+
+    switch (node->tok.data.key) {
+    case K_ADD: EMIT(code, "\x48\x01\xC8"); return true;
+    case K_SUB: EMIT(code, "\x48\x29\xC8"); return true;
+    case K_MUL: EMIT(code, "\x48\x0F\xAF\xC1"); return true;
+    case K_DIV: case K_MOD: return jitDivide(self, node);
+    case K_SHL: EMIT(code, "\x48\xD3\xE0"); return true;
+    case K_SHR: EMIT(code, "\x48\xD3\xF8"); return true;
+    case K_BITAND: EMIT(code, "\x48\x21\xC8"); return true;
+    case K_BITOR: EMIT(code, "\x48\x09\xC8"); return true;
+    case K_XOR: EMIT(code, "\x48\x31\xC8"); return true;
+    default: break;
+    }
+
+    /* cmp rax, rcx; setcc al; movzx eax, al */
+    EMIT(code, "\x48\x39\xC8\x0F");
+
+    switch (node->tok.data.key) {
+    case K_EQ: ctPush(code, '\x94'); break;
+    case K_NEQ: ctPush(code, '\x95'); break;
+    case K_LT: ctPush(code, '\x9C'); break;
+    case K_LTE: ctPush(code, '\x9E'); break;
+    case K_GT: ctPush(code, '\x9F'); break;
+    case K_GTE: ctPush(code, '\x9D'); break;
+    default: return false;
+    }
+
+    EMIT(code, "\xC0\x0F\xB6\xC0");
+    return true;
+}
+
+static bool jitTernary(Jit *self, CtAST *node) {
+    CtBuffer *code = &self->code;
+    size_t other;
+    size_t end;
+
+    if (!jitNode(self, node->data.ternary.cond))
+        return false;
+
+    /* test rax, rax; jz other */
+    EMIT(code, "\x48\x85\xC0");
+    other = jitJump(code, "\x0F\x84", 2);
+
+    if (!jitNode(self, node->data.ternary.lhs))
+        return false;
+
+    end = jitJump(code, "\xE9", 1);
+    jitPatch(code, other);
+
+    if (!jitNode(self, node->data.ternary.rhs))
+        return false;
+
+    jitPatch(code, end);
+    return true;
+}
+
+static bool jitNode(Jit *self, CtAST *node) {
+    CtBuffer *code = &self->code;
+    CtInt value;
+    int param;
+
+    if (!node)
+        return false;
+
+    switch (node->kind) {
+    case AK_LITERAL:
+        if (!evalLiteral(node, &value))
+            return false;
+
+        if (value >= -0x7FFFFFFF - 1 && value <= 0x7FFFFFFF) {
+            EMIT(code, "\x48\xC7\xC0");
+            emit32(code, (uint32_t)value);
+        } else {
+            EMIT(code, "\x48\xB8");
+            emit64(code, (uint64_t)value);
+        }
+        return true;
+
+    case AK_NAME:
+        if ((param = evalParam(self->func, node)) < 0)
+            return false;
+
+        /* mov rax, [rdi + param * 8] */
+        EMIT(code, "\x48\x8B\x87");
+        emit32(code, (uint32_t)param * 8);
+        return true;
+
+    case AK_UNARY:
+        if (!jitNode(self, node->data.expr))
+            return false;
+
+        switch (node->tok.data.key) {
+        case K_ADD: return true;
+        case K_SUB: EMIT(code, "\x48\xF7\xD8"); return true;
+        case K_BITNOT: EMIT(code, "\x48\xF7\xD0"); return true;
+        case K_NOT: EMIT(code, "\x48\x85\xC0\x0F\x94\xC0\x0F\xB6\xC0"); return true;
+        default: return false;
+        }
+
+    case AK_BINARY:
+        return jitBinary(self, node);
+
+    case AK_TERNARY:
+        return jitTernary(self, node);
+
+    default:
+        return false;
+    }
+}
+
+bool ctCompile(CtFunction *self) {
+    Jit jit;
+    void *code = NULL;
+    size_t i;
+    bool ok;
+
+    if (self->native)
+        return true;
+
+    jit.func = self;
+    jit.code = ctBufferAlloc(ctSystem(), 0);
+    jit.fails = ctBufferAlloc(ctSystem(), 0);
+
+    /* push rbx; mov rbx, rsp */
+    EMIT(&jit.code, "\x53\x48\x89\xE3");
+
+    ok = jitNode(&jit, self->body);
+
+    if (ok) {
+        /* mov [rsi], rax; xor eax, eax; pop rbx; ret */
+        EMIT(&jit.code, "\x48\x89\x06\x31\xC0\x5B\xC3");
+
+        for (i = 0; i < jit.fails.len; i += sizeof(size_t)) {
+            size_t from;
+            memcpy(&from, ctAt(&jit.fails, i), sizeof(size_t));
+            jitPatch(&jit.code, from);
+        }
+
+        /* mov rsp, rbx; mov eax, 1; pop rbx; ret */
+        EMIT(&jit.code, "\x48\x89\xDC\xB8\x01\x00\x00\x00\x5B\xC3");
+
+        /* never writable and executable at the same time */
+        code = mmap(NULL, jit.code.len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        ok = code != MAP_FAILED;
+    }
+
+    if (ok) {
+        memcpy(code, ctAt(&jit.code, 0), jit.code.len);
+
+        if (mprotect(code, jit.code.len, PROT_READ | PROT_EXEC) == 0) {
+            self->code = code;
+            self->size = jit.code.len;
+
+            /* iso c has no cast from object to function pointers */
+            memcpy(&self->native, &code, sizeof(code));
+        } else {
+            munmap(code, jit.code.len);
+            ok = false;
+        }
+    }
+
+    ctBufferFree(jit.fails);
+    ctBufferFree(jit.code);
+
+    return ok;
+}
+
+void ctFunctionFree(CtFunction *self) {
+    if (self->code)
+        munmap(self->code, self->size);
+}
+
+#else
+
+bool ctCompile(CtFunction *self) {
+    CT_UNUSED(self);
+    return false;
+}
+
+void ctFunctionFree(CtFunction *self) {
+    CT_UNUSED(self);
+}
+
+#endif
+
+/**
+ * column evaluation
+ */
+
+enum {
+    VOP_ADD, VOP_SUB, VOP_MUL, VOP_DIV, VOP_MOD,
+    VOP_SHL, VOP_SHR, VOP_BITAND, VOP_BITOR, VOP_XOR,
+    VOP_EQ, VOP_NEQ, VOP_LT, VOP_LTE, VOP_GT, VOP_GTE,
+    VOP_AND, VOP_OR,
+    VOP_NEG, VOP_BITNOT, VOP_NOT,
+
+    /* lhs is true or false in the rows of mask, used as the mask of one side of && || ?: */
+    VOP_WHEN, VOP_UNLESS,
+
+    /* mask ? lhs : rhs */
+    VOP_SELECT,
+
+    VOP_NONE
+};
+
+typedef struct {
+    CtVecPlan *plan;
+
+    /* doesnt own */
+    CtAST **params;
+
+    /* owns */
+    CtInt *consts;
+    size_t const_len;
+    size_t const_size;
+
+    size_t op_size;
+    size_t nodes;
+
+    /* which temporaries are holding something */
+    bool *busy;
+    size_t temps;
+} VecBuild;
+
+static int vecBinary(CtKey key) {
+    switch (key) {
+    case K_ADD: return VOP_ADD;
+    case K_SUB: return VOP_SUB;
+    case K_MUL: return VOP_MUL;
+    case K_DIV: return VOP_DIV;
+    case K_MOD: return VOP_MOD;
+    case K_SHL: return VOP_SHL;
+    case K_SHR: return VOP_SHR;
+    case K_BITAND: return VOP_BITAND;
+    case K_BITOR: return VOP_BITOR;
+    case K_XOR: return VOP_XOR;
+    case K_EQ: return VOP_EQ;
+    case K_NEQ: return VOP_NEQ;
+    case K_LT: return VOP_LT;
+    case K_LTE: return VOP_LTE;
+    case K_GT: return VOP_GT;
+    case K_GTE: return VOP_GTE;
+    case K_AND: return VOP_AND;
+    case K_OR: return VOP_OR;
+    default: return VOP_NONE;
+    }
+}
+
+static int vecUnary(CtKey key) {
+    switch (key) {
+    case K_SUB: return VOP_NEG;
+    case K_BITNOT: return VOP_BITNOT;
+    case K_NOT: return VOP_NOT;
+    default: return VOP_NONE;
+    }
+}
+
+static bool vecFail(VecBuild *self, CtAST *node) {
+    self->plan->err.kind = ERR_UNSUPPORTED;
+    if (node)
+        self->plan->err.where = node->tok.where;
+    return false;
+}
+
+static int vecParam(VecBuild *self, CtAST *node) {
+    size_t i;
+
+    for (i = 0; i < self->plan->inputs; i++)
+        if (self->params[i] == node->data.target)
+            return (int)i;
+
+    return -1;
+}
+
+/* the register holding a constant, adding it when asked to */
+static size_t vecConst(VecBuild *self, CtInt value, bool add) {
+    size_t i;
+
+    for (i = 0; i < self->const_len; i++)
+        if (self->consts[i] == value)
+            return self->plan->inputs + i;
+
+    if (add) {
+        self->consts = growArray(self->plan->alloc, self->consts, &self->const_size, i + 1, sizeof(CtInt));
+        self->consts[self->const_len++] = value;
+    }
+
+    return self->plan->inputs + i;
+}
+
+/* every constant has to be known before temporaries can be numbered */
+static bool vecScan(VecBuild *self, CtAST *node) {
+    CtInt value;
+
+    if (!node)
+        return vecFail(self, node);
+
+    self->nodes++;
+
+    switch (node->kind) {
+    case AK_LITERAL:
+        if (!evalLiteral(node, &value))
+            return vecFail(self, node);
+
+        vecConst(self, value, true);
+        return true;
+
+    case AK_NAME:
+        return vecParam(self, node) >= 0 || vecFail(self, node);
+
+    case AK_UNARY:
+        if (node->tok.data.key != K_ADD && vecUnary(node->tok.data.key) == VOP_NONE)
+            return vecFail(self, node);
+
+        return vecScan(self, node->data.expr);
+
+    case AK_TERNARY:
+        return vecScan(self, node->data.ternary.cond)
+            && vecScan(self, node->data.ternary.lhs)
+            && vecScan(self, node->data.ternary.rhs);
+
+    case AK_BINARY:
+        if (vecBinary(node->tok.data.key) == VOP_NONE)
+            return vecFail(self, node);
+
+        return vecScan(self, node->data.binary.lhs) && vecScan(self, node->data.binary.rhs);
+
+    default:
+        return vecFail(self, node);
+    }
+}
+
+/* operands are still held so out never aliases them */
+static uint16_t vecOp(VecBuild *self, int op, uint16_t lhs, uint16_t rhs, uint16_t mask) {
+    CtVecPlan *plan = self->plan;
+    size_t temp = 0;
+    CtVecOp *it;
+
+    while (temp < self->temps && self->busy[temp])
+        temp++;
+
+    if (temp == self->temps)
+        self->temps++;
+
+    self->busy[temp] = true;
+
+    plan->ops = growArray(plan->alloc, plan->ops, &self->op_size, plan->len + 1, sizeof(CtVecOp));
+    it = plan->ops + plan->len++;
+    it->op = (uint8_t)op;
+    it->out = (uint16_t)(plan->inputs + self->const_len + temp);
+    it->lhs = lhs;
+    it->rhs = rhs;
+    it->mask = mask;
+
+    return it->out;
+}
+
+static void vecDrop(VecBuild *self, uint16_t reg) {
+    size_t base = self->plan->inputs + self->const_len;
+
+    if (reg >= base)
+        self->busy[reg - base] = false;
+}
+
+static uint16_t vecNode(VecBuild *self, CtAST *node, uint16_t mask) {
+    CtKey key = node->kind == AK_LITERAL ? K_INVALID : node->tok.data.key;
+    uint16_t cond, guard, lhs, rhs, out;
+    CtInt value = 0;
+
+    switch (node->kind) {
+    case AK_LITERAL:
+        evalLiteral(node, &value);
+        return (uint16_t)vecConst(self, value, false);
+
+    case AK_NAME:
+        return (uint16_t)vecParam(self, node);
+
+    case AK_UNARY:
+        lhs = vecNode(self, node->data.expr, mask);
+        if (key == K_ADD)
+            return lhs;
+
+        out = vecOp(self, vecUnary(key), lhs, lhs, mask);
+        vecDrop(self, lhs);
+        return out;
+
+    case AK_TERNARY:
+        cond = vecNode(self, node->data.ternary.cond, mask);
+
+        guard = vecOp(self, VOP_WHEN, cond, cond, mask);
+        lhs = vecNode(self, node->data.ternary.lhs, guard);
+        vecDrop(self, guard);
+
+        guard = vecOp(self, VOP_UNLESS, cond, cond, mask);
+        rhs = vecNode(self, node->data.ternary.rhs, guard);
+        vecDrop(self, guard);
+
+        out = vecOp(self, VOP_SELECT, lhs, rhs, cond);
+        vecDrop(self, cond);
+        break;
+
+    default:
+        lhs = vecNode(self, node->data.binary.lhs, mask);
+
+        /* the rhs of && and || only counts in the rows that dont short circuit */
+        if (key == K_AND || key == K_OR) {
+            guard = vecOp(self, key == K_AND ? VOP_WHEN : VOP_UNLESS, lhs, lhs, mask);
+            rhs = vecNode(self, node->data.binary.rhs, guard);
+            vecDrop(self, guard);
+        } else {
+            rhs = vecNode(self, node->data.binary.rhs, mask);
+        }
+
+        out = vecOp(self, vecBinary(key), lhs, rhs, mask);
+        break;
+    }
+
+    vecDrop(self, lhs);
+    vecDrop(self, rhs);
+    return out;
+}
+
+CtVecPlan ctVecAlloc(CtAllocator *alloc, CtAST *node) {
+    CtVecPlan self;
+    VecBuild build;
+    size_t i;
+
+    self.alloc = alloc;
+    self.ops = NULL;
+    self.len = 0;
+    self.regs = NULL;
+    self.data = NULL;
+    self.inputs = 0;
+    self.size = 0;
+    self.result = 0;
+    self.err.kind = ERR_NONE;
+    self.err.where.loc = CT_NOWHERE;
+    self.err.where.len = 0;
+
+    build.plan = &self;
+    build.params = NULL;
+    build.consts = NULL;
+    build.const_len = 0;
+    build.const_size = 0;
+    build.op_size = 0;
+    build.nodes = 0;
+    build.busy = NULL;
+    build.temps = 0;
+
+    if (node && node->kind == AK_DEF) {
+        build.params = node->data.decl.items;
+        self.inputs = node->data.decl.len;
+        node = node->data.decl.body;
+    }
+
+    /* every row starts out live */
+    vecConst(&build, 1, true);
+
+    /* a temporary is never needed more than twice per node */
+    if (!vecScan(&build, node) || self.inputs + build.const_len + build.nodes * 2 > UINT16_MAX) {
+        vecFail(&build, NULL);
+        ctRelease(alloc, build.consts, sizeof(CtInt) * build.const_size);
+        return self;
+    }
+
+    build.busy = ctAlloc(alloc, sizeof(bool) * build.nodes * 2);
+    self.result = vecNode(&build, node, (uint16_t)self.inputs);
+
+    /* a bare param or constant still gets copied out of its own register */
+    self.size = self.inputs + build.const_len + build.temps;
+    self.ops = ctResize(alloc, self.ops, sizeof(CtVecOp) * build.op_size, sizeof(CtVecOp) * self.len);
+    self.regs = ctAlloc(alloc, sizeof(CtInt*) * self.size);
+    self.data = ctAlloc(alloc, sizeof(CtInt) * CT_VEC_BLOCK * (self.size - self.inputs));
+
+    for (i = self.inputs; i < self.size; i++)
+        self.regs[i] = self.data + (i - self.inputs) * CT_VEC_BLOCK;
+
+    for (i = 0; i < build.const_len; i++) {
+        size_t j;
+        for (j = 0; j < CT_VEC_BLOCK; j++)
+            self.regs[self.inputs + i][j] = build.consts[i];
+    }
+
+    ctRelease(alloc, build.busy, sizeof(bool) * build.nodes * 2);
+    ctRelease(alloc, build.consts, sizeof(CtInt) * build.const_size);
+
+    return self;
+}
+
+void ctVecFree(CtVecPlan *self) {
+    if (self->err.kind != ERR_NONE)
+        return;
+
+    ctRelease(self->alloc, self->ops, sizeof(CtVecOp) * self->len);
+    ctRelease(self->alloc, self->regs, sizeof(CtInt*) * self->size);
+    ctRelease(self->alloc, self->data, sizeof(CtInt) * CT_VEC_BLOCK * (self->size - self->inputs));
+}
+
+/* all ones when x is negative, shifting x ^ that keeps >> arithmetic without branches */
+#define SIGNS(x) ((uint64_t)0 - ((uint64_t)(x) >> 63))
+
+#define ADD_OVERFLOWS(x, y) ((((x) ^ WRAP(+, x, y)) & ((y) ^ WRAP(+, x, y))) < 0)
+#define SUB_OVERFLOWS(x, y) ((((x) ^ (y)) & ((x) ^ WRAP(-, x, y))) < 0)
+
+/**
+ * multiplies the magnitudes as 32 bit halves so the high half of the
+ * product is known without a division or a branch, it overflows when
+ * that isnt zero or the low half is past what the sign allows
+ */
+static int mulOverflows(CtInt x, CtInt y) {
+    uint64_t sx = SIGNS(x);
+    uint64_t sy = SIGNS(y);
+    uint64_t ax = ((uint64_t)x ^ sx) - sx;
+    uint64_t ay = ((uint64_t)y ^ sy) - sy;
+    uint64_t x0 = ax & 0xFFFFFFFFu, x1 = ax >> 32;
+    uint64_t y0 = ay & 0xFFFFFFFFu, y1 = ay >> 32;
+
+    /* only one of the cross products is nonzero unless x1 * y1 already is */
+    uint64_t low = x0 * y0;
+    uint64_t mid = x1 * y0 + x0 * y1;
+    uint64_t lo = low + (mid << 32);
+
+    return ((x1 != 0) & (y1 != 0))
+        | ((mid >> 32) != 0)
+        | (lo < low)
+        | (lo > (uint64_t)INT64_MAX + ((sx ^ sy) & 1));
+}
+
+/**
+ * every case is one loop without calls or exits so it can be vectorized,
+ * except the DIV and MOD values which have no vector instruction and stay
+ * scalar. their flags are still vectorized
+ */
+#define VEC_MAP(expr) for (i = 0; i < n; i++) out[i] = (expr); break
+
+/* flags are worked out first since out is written after */
+#define VEC_FLAG(expr) if (fl) for (i = 0; i < n; i++) fl[i] |= (uint8_t)((expr) * m[i])
+
+static void vecStep(CtVecPlan *self, CtVecOp *op, size_t n, uint8_t *fl) {
+    CtInt *out = self->regs[op->out];
+    const CtInt *l = self->regs[op->lhs];
+    const CtInt *r = self->regs[op->rhs];
+    const CtInt *m = self->regs[op->mask];
+    size_t i;
+
+    switch (op->op) {
+    case VOP_ADD:
+        VEC_FLAG(ADD_OVERFLOWS(l[i], r[i]) * CT_VEC_OVERFLOW);
+        VEC_MAP(WRAP(+, l[i], r[i]));
+    case VOP_SUB:
+        VEC_FLAG(SUB_OVERFLOWS(l[i], r[i]) * CT_VEC_OVERFLOW);
+        VEC_MAP(WRAP(-, l[i], r[i]));
+    case VOP_MUL:
+        VEC_FLAG(mulOverflows(l[i], r[i]) * CT_VEC_OVERFLOW);
+        VEC_MAP(WRAP(*, l[i], r[i]));
+    case VOP_DIV:
+        VEC_FLAG((r[i] == 0) * CT_VEC_DIVIDE | (l[i] == INT_MIN64 && r[i] == -1) * CT_VEC_OVERFLOW);
+        VEC_MAP(r[i] == 0 ? 0 : r[i] == -1 ? WRAP(-, 0, l[i]) : l[i] / r[i]);
+    case VOP_MOD:
+        VEC_FLAG((r[i] == 0) * CT_VEC_DIVIDE);
+        VEC_MAP(r[i] == 0 || r[i] == -1 ? 0 : l[i] % r[i]);
+    case VOP_SHL: VEC_MAP(WRAP(<<, l[i], r[i] & 63));
+    case VOP_SHR: VEC_MAP((CtInt)((((uint64_t)l[i] ^ SIGNS(l[i])) >> (r[i] & 63)) ^ SIGNS(l[i])));
+    case VOP_BITAND: VEC_MAP(l[i] & r[i]);
+    case VOP_BITOR: VEC_MAP(l[i] | r[i]);
+    case VOP_XOR: VEC_MAP(l[i] ^ r[i]);
+    case VOP_EQ: VEC_MAP(l[i] == r[i]);
+    case VOP_NEQ: VEC_MAP(l[i] != r[i]);
+    case VOP_LT: VEC_MAP(l[i] < r[i]);
+    case VOP_LTE: VEC_MAP(l[i] <= r[i]);
+    case VOP_GT: VEC_MAP(l[i] > r[i]);
+    case VOP_GTE: VEC_MAP(l[i] >= r[i]);
+    case VOP_AND: VEC_MAP((l[i] != 0) & (r[i] != 0));
+    case VOP_OR: VEC_MAP((l[i] != 0) | (r[i] != 0));
+    case VOP_NEG:
+        VEC_FLAG((l[i] == INT_MIN64) * CT_VEC_OVERFLOW);
+        VEC_MAP(WRAP(-, 0, l[i]));
+    case VOP_BITNOT: VEC_MAP(~l[i]);
+    case VOP_NOT: VEC_MAP(l[i] == 0);
+    case VOP_WHEN: VEC_MAP((l[i] != 0) & m[i]);
+    case VOP_UNLESS: VEC_MAP((l[i] == 0) & m[i]);
+    case VOP_SELECT: VEC_MAP(m[i] ? l[i] : r[i]);
+    default: break;
+    }
+}
+
+size_t ctVecRun(CtVecPlan *self, const CtInt *const *columns, size_t len, CtInt *out, uint8_t *flags) {
+    size_t flagged = 0;
+    size_t base;
+    size_t i;
+
+    if (self->err.kind != ERR_NONE)
+        return 0;
+
+    for (base = 0; base < len; base += CT_VEC_BLOCK) {
+        size_t n = len - base < CT_VEC_BLOCK ? len - base : CT_VEC_BLOCK;
+        uint8_t *fl = flags ? flags + base : NULL;
+
+        /* params are only ever read */
+        for (i = 0; i < self->inputs; i++)
+            self->regs[i] = (CtInt*)(columns[i] + base);
+
+        if (fl)
+            memset(fl, 0, n);
+
+        for (i = 0; i < self->len; i++)
+            vecStep(self, self->ops + i, n, fl);
+
+        memcpy(out + base, self->regs[self->result], sizeof(CtInt) * n);
+
+        if (fl)
+            for (i = 0; i < n; i++)
+                flagged += fl[i] != 0;
+    }
+
+    return flagged;
+}
+
+#ifdef CT_THREADS
+
+#include <sched.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200112L
+#   error "CT_THREADS needs _POSIX_C_SOURCE >= 200112L"
+#endif
+
+/**
+ * token ring
+ */
+
+void ctRingAlloc(CtRing *self, CtAllocator *alloc, size_t size, size_t batch) {
+    self->head = 0;
+    self->write = 0;
+    self->limit = size;
+
+    self->tail = 0;
+    self->avail = 0;
+
+    self->alloc = memFor(alloc, CT_MEM_TOKENS);
+    self->items = ctAlloc(self->alloc, sizeof(CtToken) * size);
+    self->mask = size - 1;
+    self->batch = batch;
+}
+
+void ctRingFree(CtRing *self) {
+    ctRelease(self->alloc, self->items, sizeof(CtToken) * (self->mask + 1));
+}
+
+void ctRingFlush(CtRing *self) {
+    __atomic_store_n(&self->head, self->write, __ATOMIC_RELEASE);
+}
+
+void ctRingPush(CtRing *self, CtToken tok) {
+    /* only go looking at the consumers index when we think were full */
+    while (self->write == self->limit) {
+        ctRingFlush(self);
+        self->limit = __atomic_load_n(&self->tail, __ATOMIC_ACQUIRE) + self->mask + 1;
+
+        if (self->write == self->limit)
+            sched_yield();
+    }
+
+    self->items[self->write & self->mask] = tok;
+    self->write += 1;
+
+    if (self->write - self->head >= self->batch)
+        ctRingFlush(self);
+}
+
+CtToken ctRingPop(CtRing *self) {
+    CtToken tok;
+
+    while (self->tail == self->avail) {
+        self->avail = __atomic_load_n(&self->head, __ATOMIC_ACQUIRE);
+
+        if (self->tail == self->avail)
+            sched_yield();
+    }
+
+    tok = self->items[self->tail & self->mask];
+    __atomic_store_n(&self->tail, self->tail + 1, __ATOMIC_RELEASE);
+
+    return tok;
+}
+
+/**
+ * pipelined lexing
+ */
+
+static void *pipelineLex(void *arg) {
+    CtPipeline *self = arg;
+    CtLexer *lex = self->parser->lex;
+    CtToken tok;
+
+    do {
+        tok = ctLex(lex);
+        ctRingPush(&self->ring, tok);
+    } while (tok.kind != TK_END);
+
+    ctRingFlush(&self->ring);
+
+    return NULL;
+}
+
+bool ctPipelineStart(CtPipeline *self, CtParser *parser, size_t size) {
+    self->parser = parser;
+
+    ctRingAlloc(&self->ring, parser->alloc, size, size / 8 ? size / 8 : 1);
+
+    if (pthread_create(&self->thread, NULL, pipelineLex, self) != 0) {
+        ctRingFree(&self->ring);
+        return false;
+    }
+
+    parser->ring = &self->ring;
+    parser->done = false;
+
+    return true;
+}
+
+void ctPipelineJoin(CtPipeline *self) {
+    CtParser *parser = self->parser;
+
+    /* the lexer thread cant finish until the ring has room for the end token */
+    while (!parser->done) {
+        parser->tok = ctRingPop(&self->ring);
+        parser->done = parser->tok.kind == TK_END;
+    }
+
+    pthread_join(self->thread, NULL);
+
+    self->parser->ring = NULL;
+    ctRingFree(&self->ring);
+}
+
+/**
+ * split parsing
+ */
+
+/**
+ * pick up to `parts` cut points, each one just past a top level ;
+ * and at least len / parts tokens after the last. returns how many
+ * segments there are, the last always ends at len
+ */
+static size_t splitCut(const CtToken *tokens, size_t len, size_t *cuts, size_t parts) {
+    size_t per = len / parts;
+    size_t next = per;
+    size_t count = 0;
+    size_t depth = 0;
+    size_t i;
+
+    for (i = 0; i < len && count + 1 < parts; i++) {
+        if (ctStmtEnds(tokens[i], &depth) && i + 1 >= next) {
+            cuts[count++] = i + 1;
+            next = i + 1 + per;
+        }
+    }
+
+    cuts[count++] = len;
+    return count;
+}
+
+static void usageMerge(CtMemUsage *usage, CtMemUsage from) {
+    if (usage->current + from.peak > usage->peak)
+        usage->peak = usage->current + from.peak;
+
+    usage->current += from.current;
+    usage->total += from.total;
+    usage->allocs += from.allocs;
+}
+
+/**
+ * count everything from counted on another thread as if it was
+ * allocated here during the current phase. its peak lands on top of
+ * what is in use now, which is as close as it gets without knowing
+ * how the threads interleaved. from still has to release what it
+ * has in use, through the matching tags of self
+ */
+static void ledgerMerge(CtLedger *self, CtLedger *from) {
+    CtMemUsage *phase = self->phases + self->phase;
+    size_t i;
+
+    if (self->limit && self->over && self->all.current + from->all.current > self->limit)
+        self->over(self, CT_MEM_AST, from->all.current);
+
+    for (i = 0; i < CT_MEM_TOTAL; i++)
+        usageMerge(self->kinds + i, from->kinds[i]);
+
+    usageMerge(&self->all, from->all);
+
+    phase->total += from->all.total;
+    phase->allocs += from->all.allocs;
+    ledgerSync(self);
+}
+
+static void *splitWorker(void *arg) {
+    CtSegment *self = arg;
+
+    while (pPeek(&self->parser).kind != TK_END) {
+        CtAST *node = ctParse(&self->parser);
+
+        /* broken statements leave nothing behind, like a serial parse */
+        if (node) {
+            self->nodes = growArray(self->arena.parent, self->nodes, &self->size, self->len + 1, sizeof(CtAST*));
+            self->nodes[self->len++] = node;
+        }
+    }
+
+    return NULL;
+}
+
+void ctSplitParse(
+    CtSplit *self,
+    CtAllocator *alloc,
+    CtLexer *lex,
+    const CtToken *tokens,
+    size_t len,
+    size_t workers,
+    size_t max_errs
+) {
+    CtAllocator *tag = ledgerFind(alloc, CT_MEM_AST);
+    size_t parts = len / CT_SPLIT_MIN;
+    size_t *cuts;
+    size_t begin = 0;
+    size_t i;
+
+    if (parts > workers)
+        parts = workers;
+    if (parts == 0)
+        parts = 1;
+
+    cuts = ctAlloc(alloc, sizeof(size_t) * parts);
+
+    self->alloc = alloc;
+    self->ledger = tag ? ((CtTag*)tag)->ledger : NULL;
+    self->workers = splitCut(tokens, len, cuts, parts);
+    self->segments = ctAlloc(alloc, sizeof(CtSegment) * self->workers);
+
+    for (i = 0; i < self->workers; i++) {
+        CtSegment *seg = &self->segments[i];
+        CtAllocator *nodes = alloc;
+
+        /* a ledger cant be shared between threads */
+        if (self->ledger) {
+            ctLedgerAlloc(&seg->ledger, self->ledger->parent);
+            nodes = ctLedgerTag(&seg->ledger, CT_MEM_AST);
+        }
+
+        seg->arena = ctArenaAlloc(nodes, CT_MM_ARENA);
+        seg->parser = ctParserAlloc(lex, &seg->arena.base, max_errs);
+        seg->parser.tokens = tokens + begin;
+        seg->parser.token_len = cuts[i] - begin;
+        seg->nodes = NULL;
+        seg->len = 0;
+        seg->size = 0;
+        seg->started = false;
+
+        begin = cuts[i];
+    }
+
+    ctRelease(alloc, cuts, sizeof(size_t) * parts);
+
+    /* the first segment runs here, as do any that couldnt get a thread */
+    for (i = 1; i < self->workers; i++) {
+        CtSegment *seg = &self->segments[i];
+        seg->started = pthread_create(&seg->thread, NULL, splitWorker, seg) == 0;
+    }
+
+    splitWorker(&self->segments[0]);
+
+    self->len = 0;
+    for (i = 0; i < self->workers; i++) {
+        CtSegment *seg = &self->segments[i];
+
+        if (seg->started) {
+            pthread_join(seg->thread, NULL);
+        } else if (i) {
+            splitWorker(seg);
+        }
+
+        self->len += seg->len;
+    }
+
+    self->nodes = ctAlloc(alloc, sizeof(CtAST*) * self->len);
+    self->errs = ctAlloc(alloc, sizeof(CtError) * max_errs);
+    self->err_idx = 0;
+    self->max_errs = max_errs;
+
+    begin = 0;
+    for (i = 0; i < self->workers; i++) {
+        CtSegment *seg = &self->segments[i];
+        size_t j;
+
+        if (seg->len)
+            memcpy(self->nodes + begin, seg->nodes, sizeof(CtAST*) * seg->len);
+        begin += seg->len;
+
+        for (j = 0; j < seg->parser.err_idx && self->err_idx < max_errs; j++)
+            self->errs[self->err_idx++] = seg->parser.errs[j];
+
+        ctRelease(seg->arena.parent, seg->nodes, sizeof(CtAST*) * seg->size);
+        ctParserFree(&seg->parser);
+
+        /* only the nodes are left, they go back through the callers ledger */
+        if (self->ledger) {
+            ledgerMerge(self->ledger, &seg->ledger);
+            seg->arena.parent = ctLedgerTag(self->ledger, CT_MEM_AST);
+        }
+    }
+}
+
+void ctSplitFree(CtSplit *self) {
+    size_t i;
+
+    for (i = 0; i < self->workers; i++)
+        ctArenaFree(&self->segments[i].arena);
+
+    ctRelease(self->alloc, self->segments, sizeof(CtSegment) * self->workers);
+    ctRelease(self->alloc, self->nodes, sizeof(CtAST*) * self->len);
+    ctRelease(self->alloc, self->errs, sizeof(CtError) * self->max_errs);
+}
+
+/**
+ * file loading
+ */
+
+static void loadMapped(CtLoad *load, int fd) {
+    void *ptr = mmap(NULL, load->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    long page = sysconf(_SC_PAGESIZE);
+    volatile char sink = 0;
+    size_t i;
+
+    if (ptr == MAP_FAILED)
+        return;
+
+    posix_madvise(ptr, load->size, POSIX_MADV_WILLNEED);
+
+    /* fault every page in here so the front end never waits on the disk */
+    for (i = 0; i < load->size; i += page > 0 ? (size_t)page : 0x1000)
+        sink ^= ((const char*)ptr)[i];
+
+    load->data = ptr;
+    load->mapped = true;
+}
+
+static void loadRead(CtLoader *self, CtLoad *load, int fd) {
+    char *data = ctAlloc(self->alloc, load->size ? load->size : 1);
+    size_t len = 0;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    while (len < load->size) {
+        ssize_t n = read(fd, data + len, load->size - len);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0) {
+            load->error = n < 0 ? errno : EIO;
+            ctRelease(self->alloc, data, load->size ? load->size : 1);
+            return;
+        }
+
+        len += n;
+    }
+
+    load->data = data;
+}
+
+static void loadFile(CtLoader *self, CtLoad *load) {
+    struct stat st;
+    int fd = open(load->path, O_RDONLY);
+
+    load->data = NULL;
+    load->size = 0;
+    load->error = 0;
+    load->mapped = false;
+    load->valid = 0;
+
+    if (fd < 0) {
+        load->error = errno;
+        return;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        load->error = errno;
+        close(fd);
+        return;
+    }
+
+    load->size = st.st_size;
+
+    if (load->size >= CT_LOAD_MAP_MIN)
+        loadMapped(load, fd);
+
+    if (!load->data)
+        loadRead(self, load, fd);
+
+    close(fd);
+
+    /* validate while the file is still hot in this threads cache */
+    load->valid = load->data ? ctUtf8Check(load->data, load->size) : 0;
+}
+
+static void *loaderWork(void *arg) {
+    CtLoader *self = arg;
+
+    while (1) {
+        size_t idx;
+
+        pthread_mutex_lock(&self->lock);
+
+        while (self->next < self->len && self->next >= self->consumed + self->window)
+            pthread_cond_wait(&self->cond, &self->lock);
+
+        idx = self->next;
+        if (idx >= self->len) {
+            pthread_mutex_unlock(&self->lock);
+            return NULL;
+        }
+
+        self->next += 1;
+        pthread_mutex_unlock(&self->lock);
+
+        loadFile(self, self->loads + idx);
+
+        pthread_mutex_lock(&self->lock);
+        self->loads[idx].ready = true;
+        pthread_cond_broadcast(&self->cond);
+        pthread_mutex_unlock(&self->lock);
+    }
+}
+
+bool ctLoaderStart(
+    CtLoader *self,
+    CtAllocator *alloc,
+    CtLoad *loads,
+    size_t len,
+    size_t workers,
+    size_t window
+) {
+    size_t i;
+
+    self->alloc = alloc;
+    self->loads = loads;
+    self->len = len;
+
+    self->next = 0;
+    self->consumed = 0;
+    self->window = window ? window : 1;
+
+    for (i = 0; i < len; i++)
+        loads[i].ready = false;
+
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->cond, NULL);
+
+    self->threads = ctAlloc(alloc, sizeof(pthread_t) * workers);
+    self->size = workers;
+    self->workers = 0;
+
+    while (self->workers < workers) {
+        if (pthread_create(self->threads + self->workers, NULL, loaderWork, self) != 0)
+            break;
+
+        self->workers += 1;
+    }
+
+    if (self->workers == 0) {
+        ctLoaderJoin(self);
+        return false;
+    }
+
+    return true;
+}
+
+CtLoad *ctLoaderWait(CtLoader *self, size_t idx) {
+    CtLoad *load = self->loads + idx;
+
+    pthread_mutex_lock(&self->lock);
+
+    while (!load->ready)
+        pthread_cond_wait(&self->cond, &self->lock);
+
+    pthread_mutex_unlock(&self->lock);
+
+    return load;
+}
+
+static void loadRelease(CtLoader *self, CtLoad *load) {
+    if (!load->data)
+        return;
+
+    if (load->mapped)
+        munmap((void*)load->data, load->size);
+    else
+        ctRelease(self->alloc, (void*)load->data, load->size ? load->size : 1);
+
+    load->data = NULL;
+}
+
+void ctLoaderDone(CtLoader *self, CtLoad *load) {
+    loadRelease(self, load);
+
+    pthread_mutex_lock(&self->lock);
+    self->consumed += 1;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+}
+
+void ctLoaderJoin(CtLoader *self) {
+    size_t i;
+
+    /* stop handing out new files */
+    pthread_mutex_lock(&self->lock);
+    self->len = self->next;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+
+    for (i = 0; i < self->workers; i++)
+        pthread_join(self->threads[i], NULL);
+
+    for (i = 0; i < self->len; i++)
+        loadRelease(self, self->loads + i);
+
+    ctRelease(self->alloc, self->threads, sizeof(pthread_t) * self->size);
+
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->lock);
+}
+
+#endif
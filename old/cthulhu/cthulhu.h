@@ -1,63 +1,1300 @@
 #ifndef CTHULHU_H
-#define CTHULHU_H 
+#define CTHULHU_H
 
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+/**
+ * memory profiles
+ * CT_MM_SMALL is for hosts with very little memory, buffers grow
+ * slowly, source text is dropped as soon as it has been lexed
+ * and nodes are freed as soon as they are dead. tokens keep their
+ * full size since the parser only holds a few of them at a time.
+ * CT_MM_FAST trades memory for throughput, buffers start out huge,
+ * arenas are large, character classes come from a table and
+ * nodes are never freed one at a time.
+ * every setting can also be overridden on its own
+ */
+#if defined(CT_MM_SMALL) && defined(CT_MM_FAST)
+#   error "CT_MM_SMALL and CT_MM_FAST cannot both be defined"
+#endif
+
+#if defined(CT_MM_SMALL)
+#   define CT_MM_GROW(size) ((size) + (size) / 2)
+#   define CT_MM_INLINE 16
+#   define CT_MM_SOURCE 0x100
+#   define CT_MM_STRINGS 0x100
+#   define CT_MM_ARENA 0x1000
+#   define CT_MM_RETAIN 0
+#   define CT_MM_EAGER 1
+#   define CT_MM_TABLES 0
+#elif defined(CT_MM_FAST)
+#   define CT_MM_GROW(size) ((size) * 4)
+#   define CT_MM_INLINE 32
+#   define CT_MM_SOURCE 0x100000
+#   define CT_MM_STRINGS 0x40000
+#   define CT_MM_ARENA 0x400000
+#   define CT_MM_RETAIN 1
+#   define CT_MM_EAGER 0
+#   define CT_MM_TABLES 1
+#endif
+
+/* how a buffer grows when it runs out of space, must be geometric */
+#ifndef CT_MM_GROW
+#   define CT_MM_GROW(size) ((size) * 2)
+#endif
+
+/* bytes a buffer can hold before it needs to allocate */
+#ifndef CT_MM_INLINE
+#   define CT_MM_INLINE 32
+#endif
+
+/* initial size of the source and string buffers */
+#ifndef CT_MM_SOURCE
+#   define CT_MM_SOURCE 0x1000
+#endif
+
+#ifndef CT_MM_STRINGS
+#   define CT_MM_STRINGS 0x1000
+#endif
+
+/* chunk size for arenas the front end creates */
+#ifndef CT_MM_ARENA
+#   define CT_MM_ARENA 0x10000
+#endif
+
+/* keep the whole source in memory, otherwise only the current token is kept */
+#ifndef CT_MM_RETAIN
+#   define CT_MM_RETAIN 1
+#endif
+
+/* free nodes one at a time with ctASTFree */
+#ifndef CT_MM_EAGER
+#   define CT_MM_EAGER 1
+#endif
+
+/* use lookup tables for character classes instead of ctype */
+#ifndef CT_MM_TABLES
+#   define CT_MM_TABLES 0
+#endif
+
+/**
+ * allocator interface
+ * every allocation the front end makes goes through one of these
+ * so embedders can plug in their own memory management.
+ * `size` is always passed back to `resize` and `release`
+ * so allocators dont need to store headers
+ */
+typedef struct CtAllocator {
+    void *(*alloc)(struct CtAllocator *self, size_t size);
+    void *(*resize)(struct CtAllocator *self, void *ptr, size_t old, size_t size);
+    void (*release)(struct CtAllocator *self, void *ptr, size_t size);
+} CtAllocator;
+
+void *ctAlloc(CtAllocator *self, size_t size);
+void *ctResize(CtAllocator *self, void *ptr, size_t old, size_t size);
+void ctRelease(CtAllocator *self, void *ptr, size_t size);
+
+/* the default allocator, backed by CT_MALLOC, CT_REALLOC and CT_FREE */
+CtAllocator *ctSystem(void);
+
+typedef struct CtChunk {
+    struct CtChunk *next;
+    size_t size;
+    size_t used;
+} CtChunk;
+
+/**
+ * bump allocator, individual frees are ignored
+ * unless they are the most recent allocation.
+ * everything is released at once by ctArenaFree
+ */
+typedef struct {
+    CtAllocator base;
+
+    /* doesnt own */
+    CtAllocator *parent;
+
+    /* owns */
+    CtChunk *head;
+    size_t chunk;
+} CtArena;
+
+typedef struct {
+    CtChunk *chunk;
+    size_t used;
+} CtArenaMark;
+
+CtArena ctArenaAlloc(CtAllocator *parent, size_t chunk);
+void ctArenaFree(CtArena *self);
+
+CtArenaMark ctArenaMark(CtArena *self);
+void ctArenaRewind(CtArena *self, CtArenaMark mark);
+
+/**
+ * fixed size block allocator, anything larger than
+ * the block size is forwarded to the parent allocator
+ */
+typedef struct {
+    CtAllocator base;
+
+    /* doesnt own */
+    CtAllocator *parent;
+
+    /* owns */
+    CtChunk *slabs;
+    void *blocks;
+    size_t size;
+    size_t count;
+} CtPool;
+
+CtPool ctPoolAlloc(CtAllocator *parent, size_t size, size_t count);
+void ctPoolFree(CtPool *self);
+
+/* forwards to the parent and keeps track of how much is in use */
+typedef struct {
+    CtAllocator base;
+
+    /* doesnt own */
+    CtAllocator *parent;
+
+    size_t current;
+    size_t peak;
+    size_t total;
+    size_t allocs;
+    size_t frees;
+} CtCounter;
+
+CtCounter ctCounterAlloc(CtAllocator *parent);
+
+/* what a piece of memory is being used for */
+typedef enum {
+    CT_MEM_SOURCE, /* source text and line tables */
+    CT_MEM_STRINGS, /* the lexers string table */
+    CT_MEM_TOKENS, /* token arrays, rings and lookahead */
+    CT_MEM_AST, /* nodes and lists being parsed */
+    CT_MEM_DIAGNOSTICS, /* error arrays */
+    CT_MEM_NAMES, /* interned names and scopes */
+    CT_MEM_OTHER,
+
+    CT_MEM_TOTAL
+} CtMemKind;
+
+/* what the front end is busy with */
+typedef enum {
+    CT_PHASE_SETUP,
+    CT_PHASE_LEX,
+    CT_PHASE_PARSE,
+    CT_PHASE_RESOLVE,
+    CT_PHASE_EVAL,
+
+    CT_PHASE_TOTAL
+} CtPhase;
+
+typedef struct {
+    size_t current;
+    size_t peak;
+    size_t total;
+    size_t allocs;
+} CtMemUsage;
+
+struct CtLedger;
+
+/* allocates one kind of memory out of a ledger */
+typedef struct {
+    CtAllocator base;
+
+    /* doesnt own */
+    struct CtLedger *ledger;
+    CtMemKind kind;
+} CtTag;
+
+/**
+ * byte accurate accounting by kind and by phase.
+ * when a tag is handed to the sources, lexer, parser, resolver,
+ * cons table or ring they take every kind of memory they need
+ * from its sibling tags, an arena over a tag counts as that tag.
+ * if limit is set over is called before an allocation would go
+ * past it, over isnt expected to return but if it does the
+ * allocation goes ahead. not thread safe
+ */
+typedef struct CtLedger {
+    /* doesnt own */
+    CtAllocator *parent;
+
+    /* owns */
+    CtTag tags[CT_MEM_TOTAL];
+
+    CtMemUsage kinds[CT_MEM_TOTAL];
+    CtMemUsage all;
+
+    /**
+     * peak is the most in use while a phase was running, total and
+     * allocs are what it asked for, current is what was in use the
+     * last time it ran
+     */
+    CtMemUsage phases[CT_PHASE_TOTAL];
+    CtPhase phase;
+
+    size_t limit;
+    void (*over)(struct CtLedger *self, CtMemKind kind, size_t size);
+} CtLedger;
+
+/* the tags point back at the ledger so it is set up in place */
+void ctLedgerAlloc(CtLedger *self, CtAllocator *parent);
+
+CtAllocator *ctLedgerTag(CtLedger *self, CtMemKind kind);
+void ctLedgerPhase(CtLedger *self, CtPhase phase);
+
+/* usage of one kind, or of everything for CT_MEM_TOTAL */
+CtMemUsage ctLedgerUsage(CtLedger *self, CtMemKind kind);
+
 typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
     /* owns */
-    char *ptr;
+    union {
+        /* used when size > CT_MM_INLINE */
+        char *ptr;
+        char small[CT_MM_INLINE];
+    } data;
     size_t len;
     size_t size;
 } CtBuffer;
 
-CtBuffer ctBufferAlloc(size_t init);
+CtBuffer ctBufferAlloc(CtAllocator *alloc, size_t init);
 void ctBufferFree(CtBuffer self);
 
+void ctReserve(CtBuffer *self, size_t extra);
 void ctPush(CtBuffer *self, char c);
 void ctAppend(CtBuffer *self, const char *str, size_t len);
 size_t ctOffset(CtBuffer *self);
 const char *ctAt(CtBuffer *self, size_t off);
 void ctRewind(CtBuffer *self, size_t off);
 
+/**
+ * source locations
+ * every file gets a contiguous range in one global 32 bit
+ * location space, so a position is a single CtLoc no matter
+ * which file it came from. file, line and column are only
+ * worked out when something needs to be printed.
+ * location 0 is never handed out and means "nowhere"
+ */
+typedef uint32_t CtLoc;
+
+#define CT_NOWHERE 0
+
 typedef struct {
-    size_t offset;
+    CtLoc loc;
+    uint32_t len;
+} CtRange;
+
+typedef struct {
+    /* doesnt own */
+    const char *name;
+
+    /* owns */
+    CtBuffer lines; /* uint32_t offset of the start of every line after the first */
+    CtLoc base;
+    uint32_t len;
+    bool open;
+} CtFile;
+
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns */
+    CtFile *files;
+    size_t len;
+    size_t size;
+
+    /* start of the next free range */
+    CtLoc next;
+} CtSources;
+
+/* a decoded location, lines and columns start at 0 */
+typedef struct {
+    const char *name;
     size_t line;
     size_t col;
-    size_t len;
-} CtRange;
+} CtPosition;
+
+CtSources ctSourcesAlloc(CtAllocator *alloc);
+void ctSourcesFree(CtSources *self);
+
+/**
+ * files being streamed in dont know their length yet
+ * so only one file can be open at a time, its range
+ * is fixed once it is closed
+ */
+size_t ctSourceOpen(CtSources *self, const char *name);
+void ctSourceLine(CtSources *self, size_t file, uint32_t offset);
+void ctSourceClose(CtSources *self, size_t file, uint32_t len);
+
+CtLoc ctSourceLoc(CtSources *self, size_t file, uint32_t offset);
+CtPosition ctDecode(CtSources *self, CtLoc loc);
 
 typedef struct {
     /* doesnt own */
     void *stream;
     char(*get)(void*);
+    CtSources *sources;
 
     /* owns */
     char ahead;
     CtBuffer buffer;
-    CtRange where;
+    size_t file;
+
+    /* how much source has been dropped from the front of buffer */
+    uint32_t offset;
 } CtStream;
 
-CtStream ctStreamAlloc(void *stream, char(*fun)(void*));
+CtStream ctStreamAlloc(
+    CtAllocator *alloc,
+    CtSources *sources,
+    const char *name,
+    void *stream,
+    char(*fun)(void*)
+);
 void ctStreamFree(CtStream self);
 
+/* reads out of an in memory buffer, for use with ctStreamAlloc */
+typedef struct {
+    /* doesnt own */
+    const char *text;
+
+    size_t len;
+    size_t idx;
+} CtMemory;
+
+CtMemory ctMemory(const char *text, size_t len);
+char ctMemoryNext(void *memory);
+
+/* offset of the first byte of text that isnt valid utf8, len if it all is */
+size_t ctUtf8Check(const char *text, size_t len);
+
+/* drop everything read so far, unless CT_MM_RETAIN is set */
+void ctStreamDiscard(CtStream *self);
+
 char ctNext(CtStream *self);
 char ctPeek(CtStream *self);
 bool ctEat(CtStream *self, char c);
-CtRange ctHere(CtStream *self);
+CtLoc ctHere(CtStream *self);
 
 typedef enum {
     TK_INVALID, TK_END,
     TK_IDENT, TK_STRING,
-    TK_INT, TK_KEY
+    TK_INT, TK_CHAR,
+    TK_KEY
 } CtTokenKind;
 
 typedef enum {
-#define KEY(id, str) id,
-#define OP(id, str) id,
+#define KEY(id, str, flags) id,
+#define OP(id, str, prec, flags) id,
 #include "keys.h"
     K_INVALID
 } CtKey;
 
+typedef enum {
+#define FLAG(name, bit) name = (1 << bit),
+#include "keys.h"
+    LF_DEFAULT = LF_CORE
+} CtFlags;
+
+typedef enum {
+#define DIALECT(id, name, flags) id,
+#include "keys.h"
+    LD_TOTAL
+} CtDialect;
+
+/* a slice of one of the lexers buffers */
+typedef struct {
+    uint32_t offset;
+    uint32_t len;
+} CtView;
+
+/* the widest integer a literal or evaluation may produce, wider is ERR_OVERFLOW */
+#ifndef CT_MAX_BITS
+#   define CT_MAX_BITS 4096
+#endif
+
+/* an integer that doesnt fit in 64 bits */
+typedef struct {
+    bool negative;
+    uint32_t len;
+
+    /* the magnitude, least significant first */
+    const uint32_t *limbs;
+} CtBig;
+
+typedef struct {
+    enum { BASE2, BASE10, BASE16 } enc;
+
+    /* the value, or its low 64 bits when big is set */
+    size_t num;
+
+    /* only set for literals past INT64_MAX, owned by the lexer */
+    const CtBig *big;
+
+    CtView suffix;
+} CtDigit;
+
+typedef struct {
+    CtTokenKind kind;
+    CtRange where;
+
+    union {
+        /* view of the source */
+        CtView ident;
+        /* view of the string table */
+        CtView str;
+        char letter;
+        CtKey key;
+        CtDigit digit;
+    } data;
+} CtToken;
+
+typedef enum {
+    ERR_NONE = 0,
+
+    /* non-fatal */
+
+    /* integer literal was too large to fit into max size */
+    ERR_OVERFLOW,
+
+    /* invalid escape sequence in string/char literal */
+    ERR_INVALID_ESCAPE,
+
+    /* a linebreak was found inside a single line string */
+    ERR_STRING_LINEBREAK,
+
+    /* fatal */
+
+    /* invalid character found while lexing */
+    ERR_INVALID_SYMBOL,
+
+    /* the source isnt valid utf8 */
+    ERR_INVALID_UTF8,
+
+    /* the EOF was found while lexing a string */
+    ERR_STRING_EOF,
+
+    /* the closing ' was missing while parsing a char literal */
+    ERR_CHAR_CLOSING,
+
+    /* an unexpected keyword was encountered while parsing */
+    ERR_UNEXPECTED_KEY,
+
+    /* missing closing ) */
+    ERR_MISSING_BRACE,
+
+    /* a name was expected in a declaration */
+    ERR_EXPECTED_NAME,
+
+    /* a name was used that isnt declared anywhere in scope */
+    ERR_UNDEFINED_NAME,
+
+    /* a name was declared twice in the same scope */
+    ERR_REDEFINED_NAME,
+
+    /* the right hand side of a / or % was 0 */
+    ERR_DIVIDE_BY_ZERO,
+
+    /* the expression uses something the evaluator cant handle */
+    ERR_UNSUPPORTED,
+
+    /* expressions were nested deeper than CT_MAX_DEPTH */
+    ERR_TOO_DEEP
+} CtErrorKind;
+
+typedef struct {
+    CtErrorKind kind;
+    CtRange where;
+} CtError;
+
+typedef struct {
+    /* owns */
+    CtStream stream;
+    CtBuffer strings;
+
+    /* limbs of big literals */
+    CtArena bigs;
+
+    /* which dialects lexer ctLex runs, can be changed between tokens */
+    CtDialect dialect;
+    int depth;
+
+    /* error handling state */
+    CtError err;
+
+    CtError *errs;
+    size_t err_idx;
+    size_t max_errs;
+
+    /* every error reported, including the ones that didnt fit */
+    size_t reported;
+} CtLexer;
+
+CtLexer ctLexerAlloc(CtStream stream, size_t max_errs);
+void ctLexerFree(CtLexer *self);
+
+CtToken ctLex(CtLexer *self);
+
+/**
+ * fixed size token records for handing tokens over to another
+ * language in bulk. offset and len are bytes into the file,
+ * value is the number of an int or the letter of a char
+ */
+typedef struct {
+    uint8_t kind; /* CtTokenKind */
+    uint8_t flags;
+    uint16_t key; /* CtKey */
+    uint32_t offset;
+    uint32_t len;
+    uint32_t reserved;
+    uint64_t value;
+} CtPacked;
+
+/* an error was reported while lexing this token */
+#define CT_PACKED_ERROR 0x1
+
+/* the base of an int, BASE2, BASE10 or BASE16 */
+#define CT_PACKED_BASE(flags) (((flags) >> 1) & 0x3)
+
+/* the int is past INT64_MAX and value is only its low 64 bits */
+#define CT_PACKED_BIG 0x8
+
+/* lex up to len tokens into out, stopping after TK_END. returns how many were written */
+size_t ctLexBatch(CtLexer *self, CtPacked *out, size_t len);
+
+/**
+ * lex everything that is left into one array ending with TK_END,
+ * allocated from the streams allocator, or its CT_MEM_TOKENS tag
+ * when that is a ledger. release it with len items
+ */
+CtToken *ctLexAll(CtLexer *self, size_t *len);
+
+/**
+ * text of an identifier or suffix and the contents of a string.
+ * identifiers point into the source, or the string table when
+ * the source isnt retained
+ */
+const char *ctIdent(CtLexer *self, CtView view);
+const char *ctString(CtLexer *self, CtView view);
+
+typedef enum {
+    AK_BINARY,
+    AK_UNARY,
+    AK_LITERAL,
+
+    /* cond ? lhs : rhs, tok is the ? */
+    AK_TERNARY,
+
+    /* a reference to a name */
+    AK_NAME,
+
+    /**
+     * declarations, tok is the name being declared
+     * def name(params) = body;
+     * var name = body;
+     * let name = body;
+     * alias name = body;
+     * struct name { items };
+     * union name { items };
+     * enum name { items };
+     * trait name { items };
+     */
+    AK_DEF,
+    AK_VAR,
+    AK_ALIAS,
+    AK_STRUCT,
+    AK_UNION,
+    AK_ENUM,
+    AK_TRAIT,
+
+    /* parts of declarations */
+    AK_PARAM,
+    AK_FIELD,
+    AK_CASE
+} CtASTKind;
+
+typedef struct CtAST {
+    CtASTKind kind;
+
+    /* belongs to a CtCons and may appear in many trees */
+    bool shared;
+
+    CtToken tok;
+
+    union {
+        struct {
+            struct CtAST *lhs;
+            struct CtAST *rhs;
+        } binary;
+        struct CtAST *expr;
+
+        struct {
+            struct CtAST *cond;
+            struct CtAST *lhs;
+            struct CtAST *rhs;
+        } ternary;
+
+        /* what a name refers to, filled in by ctResolve */
+        struct CtAST *target;
+
+        struct {
+            /* initializer, alias target or field type */
+            struct CtAST *body;
+
+            /* params, fields, cases or trait methods */
+            struct CtAST **items;
+            size_t len;
+        } decl;
+    } data;
+} CtAST;
+
+/**
+ * hash consing of constant subtrees. literals and operators over
+ * shared nodes are looked up by their contents so every distinct
+ * subtree only exists once. shared nodes belong to the table, are
+ * never freed by ctASTFree and keep the location they were first
+ * seen at
+ */
+typedef struct {
+    CtASTKind kind;
+    uint32_t op;
+    size_t value;
+    CtAST *lhs;
+    CtAST *rhs;
+} CtConsKey;
+
+typedef struct {
+    CtConsKey key;
+    uint32_t hash;
+    CtAST *node;
+} CtConsEntry;
+
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns, entries are in creation order so children come first */
+    CtConsEntry *entries;
+    size_t len;
+    size_t size;
+
+    uint32_t *slots;
+    size_t slot_size;
+
+    /* lookups that found an existing node */
+    size_t hits;
+} CtCons;
+
+CtCons ctConsAlloc(CtAllocator *alloc);
+void ctConsFree(CtCons *self);
+
+/**
+ * fold every shared node into a literal, each distinct subtree
+ * is evaluated once and exactly like ctEvalNum, so big results
+ * keep their limbs. subtrees that fail to evaluate are left alone
+ * so the error happens at runtime. returns how many were folded
+ */
+size_t ctConsFold(CtCons *self);
+
+struct CtRing;
+
+/* deepest an expression may nest before the parser gives up on it */
+#ifndef CT_MAX_DEPTH
+#   define CT_MAX_DEPTH 1024
+#endif
+
+typedef struct {
+    /* doesnt own */
+    CtLexer *lex;
+    CtAllocator *alloc;
+
+    /* constant subtrees are shared through this when set */
+    CtCons *cons;
+
+    /* tokens come from here instead of lex when pipelined */
+    struct CtRing *ring;
+
+    /* tokens come from here instead of lex when set, past the end is TK_END */
+    const CtToken *tokens;
+    size_t token_idx;
+    size_t token_len;
+
+    /* owns */
+    CtToken tok;
+    bool peeked;
+    bool done;
+
+    /**
+     * tokens read ahead of the parser, plus every token since the
+     * oldest live mark so rewinding never lexes anything twice
+     */
+    CtToken *log;
+    size_t log_len;
+    size_t log_size;
+    size_t pos;
+    size_t marks;
+
+    /* stack of nodes for lists that are still being parsed */
+    CtBuffer scratch;
+
+    /* how many expressions are currently being parsed inside each other */
+    size_t depth;
+
+    /* error handling state */
+    CtError err;
+
+    CtError *errs;
+    size_t err_idx;
+    size_t max_errs;
+} CtParser;
+
+/* nodes are allocated from alloc, an arena is a good fit */
+CtParser ctParserAlloc(CtLexer *lex, CtAllocator *alloc, size_t max_errs);
+void ctParserFree(CtParser *self);
+
+/**
+ * parse one declaration or statement, returns NULL at the end of the
+ * stream or for a broken statement, which is skipped up to its ;
+ */
+CtAST *ctParse(CtParser *self);
+
+/* release a tree, does nothing unless CT_MM_EAGER is set */
+void ctASTFree(CtParser *self, CtAST *node);
+
+/* the token n past the next one without consuming anything */
+CtToken ctParserAhead(CtParser *self, size_t n);
+
+/* everything needed to back out of a speculative parse */
+typedef struct {
+    size_t pos;
+    size_t err_idx;
+    CtError err;
+    size_t scratch;
+    CtArenaMark nodes;
+} CtParserMark;
+
+/**
+ * speculative parsing, marking and rewinding are O(1).
+ * tokens read after a mark are kept so a rewind replays them,
+ * which also means lexer errors stay reported. when alloc is a
+ * CtArena the nodes made since the mark are given back as well.
+ * every mark has to be rewound or dropped, innermost first
+ */
+CtParserMark ctParserMark(CtParser *self);
+void ctParserRewind(CtParser *self, CtParserMark mark);
+void ctParserDrop(CtParser *self, CtParserMark mark);
+
+/**
+ * true when tok is a ; outside of any brackets or templates,
+ * which is where a top level statement ends. depth starts at 0
+ * and carries the nesting from one token to the next
+ */
+bool ctStmtEnds(CtToken tok, size_t *depth);
+
+/**
+ * a front end driven by input as it arrives rather than one that
+ * pulls it, so one thread can serve many sessions at once.
+ * bytes are scanned once as they are fed to find where the last
+ * complete token ends, keeping track of strings, chars and comments
+ * cut in half by a chunk boundary. only complete tokens are lexed,
+ * and top level statements are parsed once their ; arrives, same
+ * as split parsing does. a nul byte ends the input like it does
+ * for a pulled stream
+ */
+typedef struct CtPush {
+    /* every token as soon as it is complete, the end token included */
+    void (*token)(struct CtPush *self, CtToken tok);
+
+    /* every top level statement that parsed */
+    void (*stmt)(struct CtPush *self, CtAST *node);
+
+    void *data;
+
+    /* owns */
+    CtLexer lex;
+    CtParser parser;
+
+    /* bytes fed that the lexer hasnt read yet */
+    char *queue;
+    size_t queue_len;
+    size_t queue_size;
+    size_t read;
+
+    /**
+     * counts of bytes, fed is everything seen so far, pulled is
+     * what the lexer has read, ready is one past the last byte
+     * of the last token that is known to be complete
+     */
+    size_t fed;
+    size_t pulled;
+    size_t ready;
+    size_t solid;
+    int state;
+
+    /* tokens of statements that havent ended yet */
+    CtToken *tokens;
+    size_t len;
+    size_t size;
+    size_t cut;
+    size_t depth;
+
+    bool primed;
+    bool ended;
+    bool finished;
+} CtPush;
+
+/* nodes are allocated from nodes, everything else from alloc */
+void ctPushAlloc(
+    CtPush *self,
+    CtAllocator *alloc,
+    CtSources *sources,
+    const char *name,
+    CtAllocator *nodes,
+    size_t max_errs
+);
+void ctPushFree(CtPush *self);
+
+/* lex and parse as much as the input so far allows */
+void ctFeed(CtPush *self, const char *text, size_t len);
+
+/* there is no more input, whatever is left is lexed and parsed */
+void ctFinish(CtPush *self);
+
+/* interned identifiers */
+typedef uint32_t CtName;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;
+    uint32_t len;
+} CtNameEntry;
+
+/* open addressing table of every distinct identifier */
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns */
+    CtBuffer text;
+
+    CtNameEntry *entries;
+    size_t len;
+    size_t size;
+
+    /* index into entries + 1, 0 is empty */
+    uint32_t *slots;
+    size_t slot_size;
+} CtNames;
+
+CtNames ctNamesAlloc(CtAllocator *alloc);
+void ctNamesFree(CtNames *self);
+
+CtName ctIntern(CtNames *self, const char *text, size_t len);
+const char *ctNameText(CtNames *self, CtName name);
+
+#define CT_UNBOUND UINT32_MAX
+
+typedef struct {
+    CtName name;
+
+    /* the binding this one hides, or CT_UNBOUND */
+    uint32_t shadows;
+
+    CtAST *decl;
+} CtBinding;
+
+/**
+ * every scope lives on one contiguous stack of bindings, and
+ * each name maps straight to its innermost binding by its
+ * interned id. pushing a scope just remembers the top of the
+ * stack, popping it rolls the stack back to that mark
+ */
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns */
+    CtBinding *bindings;
+    size_t len;
+    size_t size;
+
+    /* innermost binding of each name, indexed by CtName */
+    uint32_t *heads;
+    size_t head_size;
+
+    /* first binding of the innermost scope */
+    size_t base;
+} CtScopes;
+
+CtScopes ctScopesAlloc(CtAllocator *alloc);
+void ctScopesFree(CtScopes *self);
+
+size_t ctScopePush(CtScopes *self);
+void ctScopePop(CtScopes *self, size_t mark);
+
+/* returns false if the name already exists in the innermost scope */
+bool ctScopeDeclare(CtScopes *self, CtName name, CtAST *decl);
+CtAST *ctScopeLookup(CtScopes *self, CtName name);
+
+typedef struct {
+    /* doesnt own */
+    CtLexer *lex;
+
+    /* owns */
+    CtNames names;
+    CtScopes scopes;
+
+    /* error handling state */
+    CtError err;
+
+    CtError *errs;
+    size_t err_idx;
+    size_t max_errs;
+} CtResolver;
+
+CtResolver ctResolverAlloc(CtLexer *lex, CtAllocator *alloc, size_t max_errs);
+void ctResolverFree(CtResolver *self);
+
+/**
+ * resolve every name in a module, top level declarations can
+ * be referenced from anywhere regardless of their order
+ */
+void ctResolve(CtResolver *self, CtAST **decls, size_t len);
+
+/**
+ * evaluation of resolved integer expressions.
+ * integers are 64 bits and wrap on overflow, literals wider than
+ * that wrap as well. division truncates
+ * towards zero, shift counts are taken mod 64, >> is arithmetic,
+ * comparisons and logic give 0 or 1 and && || short circuit.
+ * division by zero is an error
+ */
+typedef int64_t CtInt;
+
+/* interpreted calls before a function is compiled */
+#ifndef CT_JIT_HOT
+#   define CT_JIT_HOT 64
+#endif
+
+/* CT_JIT only does anything on x86-64 with the system v abi */
+#if defined(CT_JIT) && defined(__x86_64__) && !defined(_WIN32)
+#   define CT_HAS_JIT 1
+#else
+#   define CT_HAS_JIT 0
+#endif
+
+typedef struct {
+    /* doesnt own */
+    CtAST *body;
+    CtAST **params;
+    size_t len;
+
+    /* tiering state, hot is 0 once compiling is off the table */
+    size_t calls;
+    size_t hot;
+
+    /* owns, the mapped code if compiled */
+    void *code;
+    size_t size;
+    int(*native)(const CtInt*, CtInt*);
+
+    CtError err;
+} CtFunction;
+
+/**
+ * node is either a def, whose params become the arguments,
+ * or a bare expression that takes none. after `hot` calls
+ * the function is compiled to native code, 0 never compiles
+ */
+CtFunction ctFunctionAlloc(CtAST *node, size_t hot);
+void ctFunctionFree(CtFunction *self);
+
+/* returns false and fills in self->err if evaluation failed */
+bool ctCall(CtFunction *self, const CtInt *args, CtInt *out);
+
+/* compile right away, false if this platform or expression cant be compiled */
+bool ctCompile(CtFunction *self);
+
+/**
+ * an integer of any size, just value while big is NULL. otherwise
+ * value is the low 64 bits of big, so anything that only deals in
+ * 64 bits can ignore big and wrap like ctCall does
+ */
+typedef struct {
+    CtInt value;
+    const CtBig *big;
+} CtNum;
+
+/**
+ * evaluate an expression that takes no params exactly. nothing wraps,
+ * values past 64 bits are big instead and anything wider than
+ * CT_MAX_BITS is ERR_OVERFLOW. otherwise it behaves like ctCall but
+ * for shift counts, which cant be negative and arent taken mod 64.
+ * limbs come from alloc, an arena that is rewound afterwards is best
+ */
+bool ctEvalNum(CtAST *node, CtAllocator *alloc, CtNum *out, CtError *err);
+
+/* append num to out in decimal */
+void ctNumDecimal(CtNum num, CtBuffer *out);
+
+/* rows evaluated at a time by a column plan */
+#ifndef CT_VEC_BLOCK
+#   define CT_VEC_BLOCK 256
+#endif
+
+/* the row divided by zero, its result is 0 */
+#define CT_VEC_DIVIDE 0x1
+
+/* the row wrapped around in + - * / or unary - */
+#define CT_VEC_OVERFLOW 0x2
+
+typedef struct {
+    uint8_t op;
+    uint16_t out;
+    uint16_t lhs;
+    uint16_t rhs;
+
+    /* rows the scalar evaluator would have run this for, or the condition of a select */
+    uint16_t mask;
+} CtVecOp;
+
+/**
+ * an expression compiled for evaluating over columns of rows.
+ * every node becomes one straight loop over a block of rows
+ * that the c compiler can vectorize for whatever simd the
+ * target has, so both sides of && || and ?: are always worked
+ * out but only rows the scalar evaluator would have run can be
+ * flagged. results match ctCall except that dividing by zero
+ * gives 0 and flags the row rather than failing
+ */
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns */
+    CtVecOp *ops;
+    size_t len;
+
+    /**
+     * one block of rows per register, params come first and are
+     * pointed into the columns, then constants and temporaries
+     */
+    CtInt **regs;
+    CtInt *data;
+    size_t inputs;
+    size_t size;
+    uint16_t result;
+
+    CtError err;
+} CtVecPlan;
+
+/* node is the same as for ctFunctionAlloc, err is set if it cant be planned */
+CtVecPlan ctVecAlloc(CtAllocator *alloc, CtAST *node);
+void ctVecFree(CtVecPlan *self);
+
+/**
+ * evaluate len rows, columns has one column per param. flags
+ * gets the CT_VEC_ flags of every row when it isnt NULL.
+ * returns how many rows were flagged
+ */
+size_t ctVecRun(CtVecPlan *self, const CtInt *const *columns, size_t len, CtInt *out, uint8_t *flags);
+
+#ifdef CT_THREADS
+#   include <pthread.h>
+
+#   ifndef CT_CACHELINE
+#       define CT_CACHELINE 64
+#   endif
+
+/**
+ * bounded single producer single consumer token queue.
+ * each side keeps its own index on its own cache line and
+ * only looks at the other sides index when its cached copy
+ * runs out. the producer publishes in batches
+ */
+typedef struct CtRing {
+    /* producer side */
+    size_t head;
+    size_t write;
+    size_t limit;
+    char pad0[CT_CACHELINE - 3 * sizeof(size_t)];
+
+    /* consumer side */
+    size_t tail;
+    size_t avail;
+    char pad1[CT_CACHELINE - 2 * sizeof(size_t)];
+
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* owns */
+    CtToken *items;
+    size_t mask;
+    size_t batch;
+} CtRing;
+
+/* size must be a power of 2 */
+void ctRingAlloc(CtRing *self, CtAllocator *alloc, size_t size, size_t batch);
+void ctRingFree(CtRing *self);
+
+void ctRingPush(CtRing *self, CtToken tok);
+void ctRingFlush(CtRing *self);
+CtToken ctRingPop(CtRing *self);
+
+/**
+ * runs the parsers lexer on its own thread feeding the parser
+ * through a ring. the lexers buffers and errors belong to the
+ * lexer thread until ctPipelineJoin returns, and the lexer and
+ * parser must not share an allocator that isnt thread safe
+ */
+typedef struct {
+    /* doesnt own */
+    CtParser *parser;
+
+    /* owns */
+    CtRing ring;
+    pthread_t thread;
+} CtPipeline;
+
+bool ctPipelineStart(CtPipeline *self, CtParser *parser, size_t size);
+void ctPipelineJoin(CtPipeline *self);
+
+#ifndef CT_SPLIT_MIN
+#   define CT_SPLIT_MIN 0x1000
+#endif
+
+/* one run of whole top level statements and the thread parsing it */
+typedef struct {
+    /* owns */
+    CtArena arena;
+    CtParser parser;
+
+    /* what the worker allocated when alloc belongs to a ledger */
+    CtLedger ledger;
+
+    CtAST **nodes;
+    size_t len;
+    size_t size;
+
+    pthread_t thread;
+    bool started;
+} CtSegment;
+
+/**
+ * parses an already lexed file on several threads. top level
+ * statements end at a ; outside of any brackets or templates so
+ * they dont depend on each other, the tokens are cut at those
+ * points into one segment per worker of at least CT_SPLIT_MIN tokens.
+ * every segment is parsed into its own arena and the results are
+ * put back together in source order. alloc must be thread safe,
+ * or a ledger tag over a thread safe allocator. ledgers arent thread
+ * safe themselves so every worker counts into one of its own, they
+ * are merged into alloc's after the join, peaks only approximately.
+ * hash consing isnt available, and after a broken statement the
+ * follow on errors can differ from a serial parse
+ */
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+
+    /* allocs ledger or NULL */
+    CtLedger *ledger;
+
+    /* owns */
+    CtSegment *segments;
+    size_t workers;
+
+    /* every top level statement in source order */
+    CtAST **nodes;
+    size_t len;
+
+    /* parse errors in source order */
+    CtError *errs;
+    size_t err_idx;
+    size_t max_errs;
+} CtSplit;
+
+/* tokens must end with TK_END and outlive self, lex is only used for its views */
+void ctSplitParse(
+    CtSplit *self,
+    CtAllocator *alloc,
+    CtLexer *lex,
+    const CtToken *tokens,
+    size_t len,
+    size_t workers,
+    size_t max_errs
+);
+void ctSplitFree(CtSplit *self);
+
+#ifndef CT_LOAD_MAP_MIN
+#   define CT_LOAD_MAP_MIN 0x10000
+#endif
+
+typedef struct {
+    const char *path;
+
+    /* filled in by the loader */
+    const char *data;
+    size_t size;
+    int error;
+
+    /* how much of data is valid utf8, size when all of it is */
+    size_t valid;
+    bool mapped;
+    bool ready;
+} CtLoad;
+
+/**
+ * loads a list of files on a small pool of io threads ahead
+ * of the front end. files are read in list order, so sort
+ * them by priority, and at most `window` files are kept
+ * in memory ahead of the consumer.
+ * files smaller than CT_LOAD_MAP_MIN are read into a buffer,
+ * larger ones are mapped and faulted in on the io thread.
+ * alloc is used from the io threads so it must be thread safe
+ */
+typedef struct {
+    /* doesnt own */
+    CtAllocator *alloc;
+    CtLoad *loads;
+    size_t len;
+
+    /* owns */
+    pthread_t *threads;
+    size_t size;
+    size_t workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t next;
+    size_t consumed;
+    size_t window;
+} CtLoader;
+
+bool ctLoaderStart(
+    CtLoader *self,
+    CtAllocator *alloc,
+    CtLoad *loads,
+    size_t len,
+    size_t workers,
+    size_t window
+);
+
+/* blocks until loads[idx] is ready, files must be taken in order */
+CtLoad *ctLoaderWait(CtLoader *self, size_t idx);
+
+/* give back a files memory so the io threads can move ahead */
+void ctLoaderDone(CtLoader *self, CtLoad *load);
+
+void ctLoaderJoin(CtLoader *self);
+#endif
+
 #endif /* CTHULHU_H */
@@ -0,0 +1,157 @@
+/**
+ * the parts of the lexer that depend on the dialect. cthulhu.c
+ * includes this once per DIALECT in keys.h with DIALECT_NAME(x)
+ * pasting the dialects name onto x and DIALECT_SET as its flags.
+ * DIALECT_SET is a constant so every key and symbol rule outside
+ * the dialect folds away rather than being tested per token
+ */
+
+#ifndef DIALECT_NAME
+#   error "define DIALECT_NAME and DIALECT_SET before including dialect.h"
+#endif
+
+static CtKey DIALECT_NAME(lexKeyword)(const char *text, size_t len) {
+#define KEY(id, str, flags) \
+    if (((flags) & DIALECT_SET) && len == sizeof(str) - 1 && text[0] == str[0] && memcmp(text, str, len) == 0) \
+        return id;
+#include "keys.h"
+    return K_INVALID;
+}
+
+static void DIALECT_NAME(lexIdent)(CtLexer *self, CtToken *tok, uint32_t off) {
+    size_t len = lexName(self, off);
+    CtKey key = DIALECT_NAME(lexKeyword)(ctAt(&self->stream.buffer, off), len);
+
+    if (key != K_INVALID) {
+        tok->kind = TK_KEY;
+        tok->data.key = key;
+    } else {
+        tok->kind = TK_IDENT;
+        tok->data.ident = lexView(self, off);
+    }
+}
+
+/* type arguments are part of the core language only */
+static CtKey DIALECT_NAME(lexSymbol)(CtLexer *self, char c) {
+    switch (c) {
+    case '!':
+        if ((DIALECT_SET & LF_CORE) && lexConsume(self, '<')) {
+            self->depth++;
+            return K_TBEGIN;
+        }
+        return lexConsume(self, '=') ? K_NEQ : K_NOT;
+
+    case '>':
+        if ((DIALECT_SET & LF_CORE) && self->depth) {
+            self->depth--;
+            return K_TEND;
+        } else if (lexConsume(self, '>')) {
+            return lexConsume(self, '=') ? K_SHREQ : K_SHR;
+        }
+        return lexConsume(self, '=') ? K_GTE : K_GT;
+
+    case '<':
+        if (lexConsume(self, '<'))
+            return lexConsume(self, '=') ? K_SHLEQ : K_SHL;
+        return lexConsume(self, '=') ? K_LTE : K_LT;
+
+    case '*': return lexConsume(self, '=') ? K_MULEQ : K_MUL;
+    case '/': return lexConsume(self, '=') ? K_DIVEQ : K_DIV;
+    case '%': return lexConsume(self, '=') ? K_MODEQ : K_MOD;
+    case '^': return lexConsume(self, '=') ? K_XOREQ : K_XOR;
+
+    case '&':
+        if (lexConsume(self, '&'))
+            return K_AND;
+        return lexConsume(self, '=') ? K_BITANDEQ : K_BITAND;
+
+    case '|':
+        if (lexConsume(self, '|'))
+            return K_OR;
+        return lexConsume(self, '=') ? K_BITOREQ : K_BITOR;
+
+    case '@': return K_AT;
+    case '?': return K_QUESTION;
+    case '~': return K_BITNOT;
+    case '(': return K_LPAREN;
+    case ')': return K_RPAREN;
+    case '[': return K_LSQUARE;
+    case ']': return K_RSQUARE;
+    case '{': return K_LBRACE;
+    case '}': return K_RBRACE;
+
+    case '=':
+        if (lexConsume(self, '>'))
+            return K_ARROW;
+        return lexConsume(self, '=') ? K_EQ : K_ASSIGN;
+
+    case ':': return lexConsume(self, ':') ? K_COLON2 : K_COLON;
+    case '+': return lexConsume(self, '=') ? K_ADDEQ : K_ADD;
+
+    case '-':
+        if (lexConsume(self, '>'))
+            return K_PTR;
+        return lexConsume(self, '=') ? K_SUBEQ : K_SUB;
+
+    case '.': return K_DOT;
+    case ',': return K_COMMA;
+    case ';': return K_SEMI;
+
+    default:
+        self->err.kind = ERR_INVALID_SYMBOL;
+        return K_INVALID;
+    }
+}
+
+static CtToken DIALECT_NAME(lex)(CtLexer *self) {
+    CtToken tok;
+    uint32_t off;
+    char c;
+
+    lexSkip(self);
+    ctStreamDiscard(&self->stream);
+
+    off = lexOff(self);
+    tok.where.loc = ctHere(&self->stream);
+
+    c = lexNext(self);
+
+    if (c == '\0') {
+        tok.kind = TK_END;
+    } else if ((c == 'r' || c == 'R') && lexConsume(self, '"')) {
+        lexString(self, &tok, true);
+    } else if (isident1(c)) {
+        DIALECT_NAME(lexIdent)(self, &tok, off);
+    } else if ((uint8_t)c >= 0x80) {
+        uint32_t letter = lexUtf8(self, (uint8_t)c, NULL);
+
+        if (letter != UTF8_BAD && IS_XID_START(letter)) {
+            DIALECT_NAME(lexIdent)(self, &tok, off);
+        } else {
+            self->err.kind = letter == UTF8_BAD ? ERR_INVALID_UTF8 : ERR_INVALID_SYMBOL;
+            tok.kind = TK_KEY;
+            tok.data.key = K_INVALID;
+        }
+    } else if (c == '"') {
+        lexString(self, &tok, false);
+    } else if (c == '\'') {
+        lexChar(self, &tok);
+    } else if (isDigit(c)) {
+        lexDigit(self, &tok, c);
+    } else {
+        tok.kind = TK_KEY;
+        tok.data.key = DIALECT_NAME(lexSymbol)(self, c);
+    }
+
+    tok.where.len = lexOff(self) - off;
+
+    if (self->err.kind != ERR_NONE) {
+        self->err.where = tok.where;
+        report(self, &self->err);
+    }
+
+    return tok;
+}
+
+#undef DIALECT_NAME
+#undef DIALECT_SET
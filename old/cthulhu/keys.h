@@ -1,25 +1,128 @@
 #ifndef KEY
-#   define KEY(id, str)
+#   define KEY(id, str, flags)
 #endif
 
+/**
+ * operators carry their binary precedence (OP_ERROR when they
+ * arent binary) and OF_ flags, only cthulhu.c looks at either
+ */
 #ifndef OP
-#   define OP(id, str)
+#   define OP(id, str, prec, flags)
 #endif
 
-KEY(K_DEF, "def")
-KEY(K_VAR, "var")
-KEY(K_LET, "let")
+#ifndef FLAG
+#   define FLAG(name, bit)
+#endif
+
+/* every dialect has its own lexer, built from the keys in its flag set */
+#ifndef DIALECT
+#   define DIALECT(id, name, flags)
+#endif
+
+FLAG(LF_CORE, 1)
+FLAG(LF_ASM, 2)
+
+DIALECT(LD_CORE, Core, LF_CORE)
+DIALECT(LD_ASM, Asm, LF_ASM)
+
+/* declaration keywords */
+KEY(K_IMPORT, "import", LF_CORE)
+KEY(K_DEF, "def", LF_CORE)
+KEY(K_VAR, "var", LF_CORE)
+KEY(K_LET, "let", LF_CORE)
+KEY(K_ALIAS, "alias", LF_CORE)
+KEY(K_STRUCT, "struct", LF_CORE)
+KEY(K_ENUM, "enum", LF_CORE)
+KEY(K_UNION, "union", LF_CORE)
+KEY(K_OBJECT, "object", LF_CORE)
+KEY(K_TRAIT, "trait", LF_CORE)
+
+/* control keywords */
+KEY(K_IF, "if", LF_CORE)
+KEY(K_ELSE, "else", LF_CORE)
+KEY(K_WHILE, "while", LF_CORE)
+KEY(K_FOR, "for", LF_CORE)
+KEY(K_RETURN, "return", LF_CORE)
+KEY(K_BRANCH, "branch", LF_CORE)
+KEY(K_COERCE, "coerce", LF_CORE)
+KEY(K_BREAK, "break", LF_CORE)
+KEY(K_CONTINUE, "continue", LF_CORE)
+
+KEY(K_INT, "int", LF_ASM)
+KEY(K_UD2, "ud2", LF_ASM)
+KEY(K_NOP, "nop", LF_ASM)
+
+/* language operators */
+OP(K_AT, "@", OP_ERROR, 0)
+OP(K_TBEGIN, "!<", OP_ERROR, 0)
+OP(K_TEND, ">", OP_ERROR, 0)
+OP(K_SEMI, ";", OP_ERROR, 0)
+OP(K_COLON, ":", OP_ERROR, 0)
+OP(K_COLON2, "::", OP_ERROR, 0)
+OP(K_PTR, "->", OP_ERROR, 0)
+OP(K_ARROW, "=>", OP_ERROR, 0)
+OP(K_COMMA, ",", OP_ERROR, 0)
+OP(K_DOT, ".", OP_ERROR, 0)
+OP(K_QUESTION, "?", OP_TERNARY, OF_RIGHT)
+OP(K_ASSIGN, "=", OP_ASSIGN, OF_RIGHT)
+
+/* logical operators */
+OP(K_NOT, "!", OP_ERROR, OF_UNARY)
+OP(K_NEQ, "!=", OP_EQUAL, 0)
+OP(K_EQ, "==", OP_EQUAL, 0)
+
+OP(K_LT, "<", OP_COMPARE, 0)
+OP(K_LTE, "<=", OP_COMPARE, 0)
+
+OP(K_GT, ">", OP_COMPARE, 0)
+OP(K_GTE, ">=", OP_COMPARE, 0)
+
+OP(K_AND, "&&", OP_LOGIC, 0)
+OP(K_OR, "||", OP_LOGIC, 0)
+
+/* bitwise operators */
+OP(K_XOR, "^", OP_BITS, 0)
+OP(K_XOREQ, "^=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_BITAND, "&", OP_BITS, OF_UNARY)
+OP(K_BITANDEQ, "&=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_BITOR, "|", OP_BITS, 0)
+OP(K_BITOREQ, "|=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_SHL, "<<", OP_SHIFT, 0)
+OP(K_SHLEQ, "<<=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_SHR, ">>", OP_SHIFT, 0)
+OP(K_SHREQ, ">>=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_BITNOT, "~", OP_ERROR, OF_UNARY)
+
+/* math operators */
+OP(K_ADD, "+", OP_MATH, OF_UNARY)
+OP(K_ADDEQ, "+=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_SUB, "-", OP_MATH, OF_UNARY)
+OP(K_SUBEQ, "-=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_DIV, "/", OP_MUL, 0)
+OP(K_DIVEQ, "/=", OP_ASSIGN, OF_RIGHT)
+
+OP(K_MUL, "*", OP_MUL, OF_UNARY)
+OP(K_MULEQ, "*=", OP_ASSIGN, OF_RIGHT)
 
-OP(K_LPAREN, "(")
-OP(K_RPAREN, ")")
-OP(K_SEMI, ";")
-OP(K_LSQUARE, "[")
-OP(K_RSQUARE, "]")
-OP(K_LBRACE, "{")
-OP(K_RBRACE, "}")
+OP(K_MOD, "%", OP_MUL, 0)
+OP(K_MODEQ, "%=", OP_ASSIGN, OF_RIGHT)
 
-OP(K_NOT, "!")
-OP(K_NEQ, "!=")
+/* extra operators */
+OP(K_LPAREN, "(", OP_ERROR, 0)
+OP(K_RPAREN, ")", OP_ERROR, 0)
+OP(K_LSQUARE, "[", OP_ERROR, 0)
+OP(K_RSQUARE, "]", OP_ERROR, 0)
+OP(K_LBRACE, "{", OP_ERROR, 0)
+OP(K_RBRACE, "}", OP_ERROR, 0)
 
 #undef KEY
 #undef OP
+#undef FLAG
+#undef DIALECT
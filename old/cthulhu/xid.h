@@ -0,0 +1,1429 @@
+/**
+ * non ascii ranges of the unicode 14.0.0 XID_Start and XID_Continue
+ * properties, sorted so they can be binary searched
+ */
+
+#ifndef XID_START
+#   define XID_START(lo, hi)
+#endif
+
+#ifndef XID_CONTINUE
+#   define XID_CONTINUE(lo, hi)
+#endif
+
+XID_START(0x00AA, 0x00AA)
+XID_START(0x00B5, 0x00B5)
+XID_START(0x00BA, 0x00BA)
+XID_START(0x00C0, 0x00D6)
+XID_START(0x00D8, 0x00F6)
+XID_START(0x00F8, 0x02C1)
+XID_START(0x02C6, 0x02D1)
+XID_START(0x02E0, 0x02E4)
+XID_START(0x02EC, 0x02EC)
+XID_START(0x02EE, 0x02EE)
+XID_START(0x0370, 0x0374)
+XID_START(0x0376, 0x0377)
+XID_START(0x037B, 0x037D)
+XID_START(0x037F, 0x037F)
+XID_START(0x0386, 0x0386)
+XID_START(0x0388, 0x038A)
+XID_START(0x038C, 0x038C)
+XID_START(0x038E, 0x03A1)
+XID_START(0x03A3, 0x03F5)
+XID_START(0x03F7, 0x0481)
+XID_START(0x048A, 0x052F)
+XID_START(0x0531, 0x0556)
+XID_START(0x0559, 0x0559)
+XID_START(0x0560, 0x0588)
+XID_START(0x05D0, 0x05EA)
+XID_START(0x05EF, 0x05F2)
+XID_START(0x0620, 0x064A)
+XID_START(0x066E, 0x066F)
+XID_START(0x0671, 0x06D3)
+XID_START(0x06D5, 0x06D5)
+XID_START(0x06E5, 0x06E6)
+XID_START(0x06EE, 0x06EF)
+XID_START(0x06FA, 0x06FC)
+XID_START(0x06FF, 0x06FF)
+XID_START(0x0710, 0x0710)
+XID_START(0x0712, 0x072F)
+XID_START(0x074D, 0x07A5)
+XID_START(0x07B1, 0x07B1)
+XID_START(0x07CA, 0x07EA)
+XID_START(0x07F4, 0x07F5)
+XID_START(0x07FA, 0x07FA)
+XID_START(0x0800, 0x0815)
+XID_START(0x081A, 0x081A)
+XID_START(0x0824, 0x0824)
+XID_START(0x0828, 0x0828)
+XID_START(0x0840, 0x0858)
+XID_START(0x0860, 0x086A)
+XID_START(0x0870, 0x0887)
+XID_START(0x0889, 0x088E)
+XID_START(0x08A0, 0x08C9)
+XID_START(0x0904, 0x0939)
+XID_START(0x093D, 0x093D)
+XID_START(0x0950, 0x0950)
+XID_START(0x0958, 0x0961)
+XID_START(0x0971, 0x0980)
+XID_START(0x0985, 0x098C)
+XID_START(0x098F, 0x0990)
+XID_START(0x0993, 0x09A8)
+XID_START(0x09AA, 0x09B0)
+XID_START(0x09B2, 0x09B2)
+XID_START(0x09B6, 0x09B9)
+XID_START(0x09BD, 0x09BD)
+XID_START(0x09CE, 0x09CE)
+XID_START(0x09DC, 0x09DD)
+XID_START(0x09DF, 0x09E1)
+XID_START(0x09F0, 0x09F1)
+XID_START(0x09FC, 0x09FC)
+XID_START(0x0A05, 0x0A0A)
+XID_START(0x0A0F, 0x0A10)
+XID_START(0x0A13, 0x0A28)
+XID_START(0x0A2A, 0x0A30)
+XID_START(0x0A32, 0x0A33)
+XID_START(0x0A35, 0x0A36)
+XID_START(0x0A38, 0x0A39)
+XID_START(0x0A59, 0x0A5C)
+XID_START(0x0A5E, 0x0A5E)
+XID_START(0x0A72, 0x0A74)
+XID_START(0x0A85, 0x0A8D)
+XID_START(0x0A8F, 0x0A91)
+XID_START(0x0A93, 0x0AA8)
+XID_START(0x0AAA, 0x0AB0)
+XID_START(0x0AB2, 0x0AB3)
+XID_START(0x0AB5, 0x0AB9)
+XID_START(0x0ABD, 0x0ABD)
+XID_START(0x0AD0, 0x0AD0)
+XID_START(0x0AE0, 0x0AE1)
+XID_START(0x0AF9, 0x0AF9)
+XID_START(0x0B05, 0x0B0C)
+XID_START(0x0B0F, 0x0B10)
+XID_START(0x0B13, 0x0B28)
+XID_START(0x0B2A, 0x0B30)
+XID_START(0x0B32, 0x0B33)
+XID_START(0x0B35, 0x0B39)
+XID_START(0x0B3D, 0x0B3D)
+XID_START(0x0B5C, 0x0B5D)
+XID_START(0x0B5F, 0x0B61)
+XID_START(0x0B71, 0x0B71)
+XID_START(0x0B83, 0x0B83)
+XID_START(0x0B85, 0x0B8A)
+XID_START(0x0B8E, 0x0B90)
+XID_START(0x0B92, 0x0B95)
+XID_START(0x0B99, 0x0B9A)
+XID_START(0x0B9C, 0x0B9C)
+XID_START(0x0B9E, 0x0B9F)
+XID_START(0x0BA3, 0x0BA4)
+XID_START(0x0BA8, 0x0BAA)
+XID_START(0x0BAE, 0x0BB9)
+XID_START(0x0BD0, 0x0BD0)
+XID_START(0x0C05, 0x0C0C)
+XID_START(0x0C0E, 0x0C10)
+XID_START(0x0C12, 0x0C28)
+XID_START(0x0C2A, 0x0C39)
+XID_START(0x0C3D, 0x0C3D)
+XID_START(0x0C58, 0x0C5A)
+XID_START(0x0C5D, 0x0C5D)
+XID_START(0x0C60, 0x0C61)
+XID_START(0x0C80, 0x0C80)
+XID_START(0x0C85, 0x0C8C)
+XID_START(0x0C8E, 0x0C90)
+XID_START(0x0C92, 0x0CA8)
+XID_START(0x0CAA, 0x0CB3)
+XID_START(0x0CB5, 0x0CB9)
+XID_START(0x0CBD, 0x0CBD)
+XID_START(0x0CDD, 0x0CDE)
+XID_START(0x0CE0, 0x0CE1)
+XID_START(0x0CF1, 0x0CF2)
+XID_START(0x0D04, 0x0D0C)
+XID_START(0x0D0E, 0x0D10)
+XID_START(0x0D12, 0x0D3A)
+XID_START(0x0D3D, 0x0D3D)
+XID_START(0x0D4E, 0x0D4E)
+XID_START(0x0D54, 0x0D56)
+XID_START(0x0D5F, 0x0D61)
+XID_START(0x0D7A, 0x0D7F)
+XID_START(0x0D85, 0x0D96)
+XID_START(0x0D9A, 0x0DB1)
+XID_START(0x0DB3, 0x0DBB)
+XID_START(0x0DBD, 0x0DBD)
+XID_START(0x0DC0, 0x0DC6)
+XID_START(0x0E01, 0x0E30)
+XID_START(0x0E32, 0x0E32)
+XID_START(0x0E40, 0x0E46)
+XID_START(0x0E81, 0x0E82)
+XID_START(0x0E84, 0x0E84)
+XID_START(0x0E86, 0x0E8A)
+XID_START(0x0E8C, 0x0EA3)
+XID_START(0x0EA5, 0x0EA5)
+XID_START(0x0EA7, 0x0EB0)
+XID_START(0x0EB2, 0x0EB2)
+XID_START(0x0EBD, 0x0EBD)
+XID_START(0x0EC0, 0x0EC4)
+XID_START(0x0EC6, 0x0EC6)
+XID_START(0x0EDC, 0x0EDF)
+XID_START(0x0F00, 0x0F00)
+XID_START(0x0F40, 0x0F47)
+XID_START(0x0F49, 0x0F6C)
+XID_START(0x0F88, 0x0F8C)
+XID_START(0x1000, 0x102A)
+XID_START(0x103F, 0x103F)
+XID_START(0x1050, 0x1055)
+XID_START(0x105A, 0x105D)
+XID_START(0x1061, 0x1061)
+XID_START(0x1065, 0x1066)
+XID_START(0x106E, 0x1070)
+XID_START(0x1075, 0x1081)
+XID_START(0x108E, 0x108E)
+XID_START(0x10A0, 0x10C5)
+XID_START(0x10C7, 0x10C7)
+XID_START(0x10CD, 0x10CD)
+XID_START(0x10D0, 0x10FA)
+XID_START(0x10FC, 0x1248)
+XID_START(0x124A, 0x124D)
+XID_START(0x1250, 0x1256)
+XID_START(0x1258, 0x1258)
+XID_START(0x125A, 0x125D)
+XID_START(0x1260, 0x1288)
+XID_START(0x128A, 0x128D)
+XID_START(0x1290, 0x12B0)
+XID_START(0x12B2, 0x12B5)
+XID_START(0x12B8, 0x12BE)
+XID_START(0x12C0, 0x12C0)
+XID_START(0x12C2, 0x12C5)
+XID_START(0x12C8, 0x12D6)
+XID_START(0x12D8, 0x1310)
+XID_START(0x1312, 0x1315)
+XID_START(0x1318, 0x135A)
+XID_START(0x1380, 0x138F)
+XID_START(0x13A0, 0x13F5)
+XID_START(0x13F8, 0x13FD)
+XID_START(0x1401, 0x166C)
+XID_START(0x166F, 0x167F)
+XID_START(0x1681, 0x169A)
+XID_START(0x16A0, 0x16EA)
+XID_START(0x16EE, 0x16F8)
+XID_START(0x1700, 0x1711)
+XID_START(0x171F, 0x1731)
+XID_START(0x1740, 0x1751)
+XID_START(0x1760, 0x176C)
+XID_START(0x176E, 0x1770)
+XID_START(0x1780, 0x17B3)
+XID_START(0x17D7, 0x17D7)
+XID_START(0x17DC, 0x17DC)
+XID_START(0x1820, 0x1878)
+XID_START(0x1880, 0x18A8)
+XID_START(0x18AA, 0x18AA)
+XID_START(0x18B0, 0x18F5)
+XID_START(0x1900, 0x191E)
+XID_START(0x1950, 0x196D)
+XID_START(0x1970, 0x1974)
+XID_START(0x1980, 0x19AB)
+XID_START(0x19B0, 0x19C9)
+XID_START(0x1A00, 0x1A16)
+XID_START(0x1A20, 0x1A54)
+XID_START(0x1AA7, 0x1AA7)
+XID_START(0x1B05, 0x1B33)
+XID_START(0x1B45, 0x1B4C)
+XID_START(0x1B83, 0x1BA0)
+XID_START(0x1BAE, 0x1BAF)
+XID_START(0x1BBA, 0x1BE5)
+XID_START(0x1C00, 0x1C23)
+XID_START(0x1C4D, 0x1C4F)
+XID_START(0x1C5A, 0x1C7D)
+XID_START(0x1C80, 0x1C88)
+XID_START(0x1C90, 0x1CBA)
+XID_START(0x1CBD, 0x1CBF)
+XID_START(0x1CE9, 0x1CEC)
+XID_START(0x1CEE, 0x1CF3)
+XID_START(0x1CF5, 0x1CF6)
+XID_START(0x1CFA, 0x1CFA)
+XID_START(0x1D00, 0x1DBF)
+XID_START(0x1E00, 0x1F15)
+XID_START(0x1F18, 0x1F1D)
+XID_START(0x1F20, 0x1F45)
+XID_START(0x1F48, 0x1F4D)
+XID_START(0x1F50, 0x1F57)
+XID_START(0x1F59, 0x1F59)
+XID_START(0x1F5B, 0x1F5B)
+XID_START(0x1F5D, 0x1F5D)
+XID_START(0x1F5F, 0x1F7D)
+XID_START(0x1F80, 0x1FB4)
+XID_START(0x1FB6, 0x1FBC)
+XID_START(0x1FBE, 0x1FBE)
+XID_START(0x1FC2, 0x1FC4)
+XID_START(0x1FC6, 0x1FCC)
+XID_START(0x1FD0, 0x1FD3)
+XID_START(0x1FD6, 0x1FDB)
+XID_START(0x1FE0, 0x1FEC)
+XID_START(0x1FF2, 0x1FF4)
+XID_START(0x1FF6, 0x1FFC)
+XID_START(0x2071, 0x2071)
+XID_START(0x207F, 0x207F)
+XID_START(0x2090, 0x209C)
+XID_START(0x2102, 0x2102)
+XID_START(0x2107, 0x2107)
+XID_START(0x210A, 0x2113)
+XID_START(0x2115, 0x2115)
+XID_START(0x2118, 0x211D)
+XID_START(0x2124, 0x2124)
+XID_START(0x2126, 0x2126)
+XID_START(0x2128, 0x2128)
+XID_START(0x212A, 0x2139)
+XID_START(0x213C, 0x213F)
+XID_START(0x2145, 0x2149)
+XID_START(0x214E, 0x214E)
+XID_START(0x2160, 0x2188)
+XID_START(0x2C00, 0x2CE4)
+XID_START(0x2CEB, 0x2CEE)
+XID_START(0x2CF2, 0x2CF3)
+XID_START(0x2D00, 0x2D25)
+XID_START(0x2D27, 0x2D27)
+XID_START(0x2D2D, 0x2D2D)
+XID_START(0x2D30, 0x2D67)
+XID_START(0x2D6F, 0x2D6F)
+XID_START(0x2D80, 0x2D96)
+XID_START(0x2DA0, 0x2DA6)
+XID_START(0x2DA8, 0x2DAE)
+XID_START(0x2DB0, 0x2DB6)
+XID_START(0x2DB8, 0x2DBE)
+XID_START(0x2DC0, 0x2DC6)
+XID_START(0x2DC8, 0x2DCE)
+XID_START(0x2DD0, 0x2DD6)
+XID_START(0x2DD8, 0x2DDE)
+XID_START(0x3005, 0x3007)
+XID_START(0x3021, 0x3029)
+XID_START(0x3031, 0x3035)
+XID_START(0x3038, 0x303C)
+XID_START(0x3041, 0x3096)
+XID_START(0x309D, 0x309F)
+XID_START(0x30A1, 0x30FA)
+XID_START(0x30FC, 0x30FF)
+XID_START(0x3105, 0x312F)
+XID_START(0x3131, 0x318E)
+XID_START(0x31A0, 0x31BF)
+XID_START(0x31F0, 0x31FF)
+XID_START(0x3400, 0x4DBF)
+XID_START(0x4E00, 0xA48C)
+XID_START(0xA4D0, 0xA4FD)
+XID_START(0xA500, 0xA60C)
+XID_START(0xA610, 0xA61F)
+XID_START(0xA62A, 0xA62B)
+XID_START(0xA640, 0xA66E)
+XID_START(0xA67F, 0xA69D)
+XID_START(0xA6A0, 0xA6EF)
+XID_START(0xA717, 0xA71F)
+XID_START(0xA722, 0xA788)
+XID_START(0xA78B, 0xA7CA)
+XID_START(0xA7D0, 0xA7D1)
+XID_START(0xA7D3, 0xA7D3)
+XID_START(0xA7D5, 0xA7D9)
+XID_START(0xA7F2, 0xA801)
+XID_START(0xA803, 0xA805)
+XID_START(0xA807, 0xA80A)
+XID_START(0xA80C, 0xA822)
+XID_START(0xA840, 0xA873)
+XID_START(0xA882, 0xA8B3)
+XID_START(0xA8F2, 0xA8F7)
+XID_START(0xA8FB, 0xA8FB)
+XID_START(0xA8FD, 0xA8FE)
+XID_START(0xA90A, 0xA925)
+XID_START(0xA930, 0xA946)
+XID_START(0xA960, 0xA97C)
+XID_START(0xA984, 0xA9B2)
+XID_START(0xA9CF, 0xA9CF)
+XID_START(0xA9E0, 0xA9E4)
+XID_START(0xA9E6, 0xA9EF)
+XID_START(0xA9FA, 0xA9FE)
+XID_START(0xAA00, 0xAA28)
+XID_START(0xAA40, 0xAA42)
+XID_START(0xAA44, 0xAA4B)
+XID_START(0xAA60, 0xAA76)
+XID_START(0xAA7A, 0xAA7A)
+XID_START(0xAA7E, 0xAAAF)
+XID_START(0xAAB1, 0xAAB1)
+XID_START(0xAAB5, 0xAAB6)
+XID_START(0xAAB9, 0xAABD)
+XID_START(0xAAC0, 0xAAC0)
+XID_START(0xAAC2, 0xAAC2)
+XID_START(0xAADB, 0xAADD)
+XID_START(0xAAE0, 0xAAEA)
+XID_START(0xAAF2, 0xAAF4)
+XID_START(0xAB01, 0xAB06)
+XID_START(0xAB09, 0xAB0E)
+XID_START(0xAB11, 0xAB16)
+XID_START(0xAB20, 0xAB26)
+XID_START(0xAB28, 0xAB2E)
+XID_START(0xAB30, 0xAB5A)
+XID_START(0xAB5C, 0xAB69)
+XID_START(0xAB70, 0xABE2)
+XID_START(0xAC00, 0xD7A3)
+XID_START(0xD7B0, 0xD7C6)
+XID_START(0xD7CB, 0xD7FB)
+XID_START(0xF900, 0xFA6D)
+XID_START(0xFA70, 0xFAD9)
+XID_START(0xFB00, 0xFB06)
+XID_START(0xFB13, 0xFB17)
+XID_START(0xFB1D, 0xFB1D)
+XID_START(0xFB1F, 0xFB28)
+XID_START(0xFB2A, 0xFB36)
+XID_START(0xFB38, 0xFB3C)
+XID_START(0xFB3E, 0xFB3E)
+XID_START(0xFB40, 0xFB41)
+XID_START(0xFB43, 0xFB44)
+XID_START(0xFB46, 0xFBB1)
+XID_START(0xFBD3, 0xFC5D)
+XID_START(0xFC64, 0xFD3D)
+XID_START(0xFD50, 0xFD8F)
+XID_START(0xFD92, 0xFDC7)
+XID_START(0xFDF0, 0xFDF9)
+XID_START(0xFE71, 0xFE71)
+XID_START(0xFE73, 0xFE73)
+XID_START(0xFE77, 0xFE77)
+XID_START(0xFE79, 0xFE79)
+XID_START(0xFE7B, 0xFE7B)
+XID_START(0xFE7D, 0xFE7D)
+XID_START(0xFE7F, 0xFEFC)
+XID_START(0xFF21, 0xFF3A)
+XID_START(0xFF41, 0xFF5A)
+XID_START(0xFF66, 0xFF9D)
+XID_START(0xFFA0, 0xFFBE)
+XID_START(0xFFC2, 0xFFC7)
+XID_START(0xFFCA, 0xFFCF)
+XID_START(0xFFD2, 0xFFD7)
+XID_START(0xFFDA, 0xFFDC)
+XID_START(0x10000, 0x1000B)
+XID_START(0x1000D, 0x10026)
+XID_START(0x10028, 0x1003A)
+XID_START(0x1003C, 0x1003D)
+XID_START(0x1003F, 0x1004D)
+XID_START(0x10050, 0x1005D)
+XID_START(0x10080, 0x100FA)
+XID_START(0x10140, 0x10174)
+XID_START(0x10280, 0x1029C)
+XID_START(0x102A0, 0x102D0)
+XID_START(0x10300, 0x1031F)
+XID_START(0x1032D, 0x1034A)
+XID_START(0x10350, 0x10375)
+XID_START(0x10380, 0x1039D)
+XID_START(0x103A0, 0x103C3)
+XID_START(0x103C8, 0x103CF)
+XID_START(0x103D1, 0x103D5)
+XID_START(0x10400, 0x1049D)
+XID_START(0x104B0, 0x104D3)
+XID_START(0x104D8, 0x104FB)
+XID_START(0x10500, 0x10527)
+XID_START(0x10530, 0x10563)
+XID_START(0x10570, 0x1057A)
+XID_START(0x1057C, 0x1058A)
+XID_START(0x1058C, 0x10592)
+XID_START(0x10594, 0x10595)
+XID_START(0x10597, 0x105A1)
+XID_START(0x105A3, 0x105B1)
+XID_START(0x105B3, 0x105B9)
+XID_START(0x105BB, 0x105BC)
+XID_START(0x10600, 0x10736)
+XID_START(0x10740, 0x10755)
+XID_START(0x10760, 0x10767)
+XID_START(0x10780, 0x10785)
+XID_START(0x10787, 0x107B0)
+XID_START(0x107B2, 0x107BA)
+XID_START(0x10800, 0x10805)
+XID_START(0x10808, 0x10808)
+XID_START(0x1080A, 0x10835)
+XID_START(0x10837, 0x10838)
+XID_START(0x1083C, 0x1083C)
+XID_START(0x1083F, 0x10855)
+XID_START(0x10860, 0x10876)
+XID_START(0x10880, 0x1089E)
+XID_START(0x108E0, 0x108F2)
+XID_START(0x108F4, 0x108F5)
+XID_START(0x10900, 0x10915)
+XID_START(0x10920, 0x10939)
+XID_START(0x10980, 0x109B7)
+XID_START(0x109BE, 0x109BF)
+XID_START(0x10A00, 0x10A00)
+XID_START(0x10A10, 0x10A13)
+XID_START(0x10A15, 0x10A17)
+XID_START(0x10A19, 0x10A35)
+XID_START(0x10A60, 0x10A7C)
+XID_START(0x10A80, 0x10A9C)
+XID_START(0x10AC0, 0x10AC7)
+XID_START(0x10AC9, 0x10AE4)
+XID_START(0x10B00, 0x10B35)
+XID_START(0x10B40, 0x10B55)
+XID_START(0x10B60, 0x10B72)
+XID_START(0x10B80, 0x10B91)
+XID_START(0x10C00, 0x10C48)
+XID_START(0x10C80, 0x10CB2)
+XID_START(0x10CC0, 0x10CF2)
+XID_START(0x10D00, 0x10D23)
+XID_START(0x10E80, 0x10EA9)
+XID_START(0x10EB0, 0x10EB1)
+XID_START(0x10F00, 0x10F1C)
+XID_START(0x10F27, 0x10F27)
+XID_START(0x10F30, 0x10F45)
+XID_START(0x10F70, 0x10F81)
+XID_START(0x10FB0, 0x10FC4)
+XID_START(0x10FE0, 0x10FF6)
+XID_START(0x11003, 0x11037)
+XID_START(0x11071, 0x11072)
+XID_START(0x11075, 0x11075)
+XID_START(0x11083, 0x110AF)
+XID_START(0x110D0, 0x110E8)
+XID_START(0x11103, 0x11126)
+XID_START(0x11144, 0x11144)
+XID_START(0x11147, 0x11147)
+XID_START(0x11150, 0x11172)
+XID_START(0x11176, 0x11176)
+XID_START(0x11183, 0x111B2)
+XID_START(0x111C1, 0x111C4)
+XID_START(0x111DA, 0x111DA)
+XID_START(0x111DC, 0x111DC)
+XID_START(0x11200, 0x11211)
+XID_START(0x11213, 0x1122B)
+XID_START(0x11280, 0x11286)
+XID_START(0x11288, 0x11288)
+XID_START(0x1128A, 0x1128D)
+XID_START(0x1128F, 0x1129D)
+XID_START(0x1129F, 0x112A8)
+XID_START(0x112B0, 0x112DE)
+XID_START(0x11305, 0x1130C)
+XID_START(0x1130F, 0x11310)
+XID_START(0x11313, 0x11328)
+XID_START(0x1132A, 0x11330)
+XID_START(0x11332, 0x11333)
+XID_START(0x11335, 0x11339)
+XID_START(0x1133D, 0x1133D)
+XID_START(0x11350, 0x11350)
+XID_START(0x1135D, 0x11361)
+XID_START(0x11400, 0x11434)
+XID_START(0x11447, 0x1144A)
+XID_START(0x1145F, 0x11461)
+XID_START(0x11480, 0x114AF)
+XID_START(0x114C4, 0x114C5)
+XID_START(0x114C7, 0x114C7)
+XID_START(0x11580, 0x115AE)
+XID_START(0x115D8, 0x115DB)
+XID_START(0x11600, 0x1162F)
+XID_START(0x11644, 0x11644)
+XID_START(0x11680, 0x116AA)
+XID_START(0x116B8, 0x116B8)
+XID_START(0x11700, 0x1171A)
+XID_START(0x11740, 0x11746)
+XID_START(0x11800, 0x1182B)
+XID_START(0x118A0, 0x118DF)
+XID_START(0x118FF, 0x11906)
+XID_START(0x11909, 0x11909)
+XID_START(0x1190C, 0x11913)
+XID_START(0x11915, 0x11916)
+XID_START(0x11918, 0x1192F)
+XID_START(0x1193F, 0x1193F)
+XID_START(0x11941, 0x11941)
+XID_START(0x119A0, 0x119A7)
+XID_START(0x119AA, 0x119D0)
+XID_START(0x119E1, 0x119E1)
+XID_START(0x119E3, 0x119E3)
+XID_START(0x11A00, 0x11A00)
+XID_START(0x11A0B, 0x11A32)
+XID_START(0x11A3A, 0x11A3A)
+XID_START(0x11A50, 0x11A50)
+XID_START(0x11A5C, 0x11A89)
+XID_START(0x11A9D, 0x11A9D)
+XID_START(0x11AB0, 0x11AF8)
+XID_START(0x11C00, 0x11C08)
+XID_START(0x11C0A, 0x11C2E)
+XID_START(0x11C40, 0x11C40)
+XID_START(0x11C72, 0x11C8F)
+XID_START(0x11D00, 0x11D06)
+XID_START(0x11D08, 0x11D09)
+XID_START(0x11D0B, 0x11D30)
+XID_START(0x11D46, 0x11D46)
+XID_START(0x11D60, 0x11D65)
+XID_START(0x11D67, 0x11D68)
+XID_START(0x11D6A, 0x11D89)
+XID_START(0x11D98, 0x11D98)
+XID_START(0x11EE0, 0x11EF2)
+XID_START(0x11FB0, 0x11FB0)
+XID_START(0x12000, 0x12399)
+XID_START(0x12400, 0x1246E)
+XID_START(0x12480, 0x12543)
+XID_START(0x12F90, 0x12FF0)
+XID_START(0x13000, 0x1342E)
+XID_START(0x14400, 0x14646)
+XID_START(0x16800, 0x16A38)
+XID_START(0x16A40, 0x16A5E)
+XID_START(0x16A70, 0x16ABE)
+XID_START(0x16AD0, 0x16AED)
+XID_START(0x16B00, 0x16B2F)
+XID_START(0x16B40, 0x16B43)
+XID_START(0x16B63, 0x16B77)
+XID_START(0x16B7D, 0x16B8F)
+XID_START(0x16E40, 0x16E7F)
+XID_START(0x16F00, 0x16F4A)
+XID_START(0x16F50, 0x16F50)
+XID_START(0x16F93, 0x16F9F)
+XID_START(0x16FE0, 0x16FE1)
+XID_START(0x16FE3, 0x16FE3)
+XID_START(0x17000, 0x187F7)
+XID_START(0x18800, 0x18CD5)
+XID_START(0x18D00, 0x18D08)
+XID_START(0x1AFF0, 0x1AFF3)
+XID_START(0x1AFF5, 0x1AFFB)
+XID_START(0x1AFFD, 0x1AFFE)
+XID_START(0x1B000, 0x1B122)
+XID_START(0x1B150, 0x1B152)
+XID_START(0x1B164, 0x1B167)
+XID_START(0x1B170, 0x1B2FB)
+XID_START(0x1BC00, 0x1BC6A)
+XID_START(0x1BC70, 0x1BC7C)
+XID_START(0x1BC80, 0x1BC88)
+XID_START(0x1BC90, 0x1BC99)
+XID_START(0x1D400, 0x1D454)
+XID_START(0x1D456, 0x1D49C)
+XID_START(0x1D49E, 0x1D49F)
+XID_START(0x1D4A2, 0x1D4A2)
+XID_START(0x1D4A5, 0x1D4A6)
+XID_START(0x1D4A9, 0x1D4AC)
+XID_START(0x1D4AE, 0x1D4B9)
+XID_START(0x1D4BB, 0x1D4BB)
+XID_START(0x1D4BD, 0x1D4C3)
+XID_START(0x1D4C5, 0x1D505)
+XID_START(0x1D507, 0x1D50A)
+XID_START(0x1D50D, 0x1D514)
+XID_START(0x1D516, 0x1D51C)
+XID_START(0x1D51E, 0x1D539)
+XID_START(0x1D53B, 0x1D53E)
+XID_START(0x1D540, 0x1D544)
+XID_START(0x1D546, 0x1D546)
+XID_START(0x1D54A, 0x1D550)
+XID_START(0x1D552, 0x1D6A5)
+XID_START(0x1D6A8, 0x1D6C0)
+XID_START(0x1D6C2, 0x1D6DA)
+XID_START(0x1D6DC, 0x1D6FA)
+XID_START(0x1D6FC, 0x1D714)
+XID_START(0x1D716, 0x1D734)
+XID_START(0x1D736, 0x1D74E)
+XID_START(0x1D750, 0x1D76E)
+XID_START(0x1D770, 0x1D788)
+XID_START(0x1D78A, 0x1D7A8)
+XID_START(0x1D7AA, 0x1D7C2)
+XID_START(0x1D7C4, 0x1D7CB)
+XID_START(0x1DF00, 0x1DF1E)
+XID_START(0x1E100, 0x1E12C)
+XID_START(0x1E137, 0x1E13D)
+XID_START(0x1E14E, 0x1E14E)
+XID_START(0x1E290, 0x1E2AD)
+XID_START(0x1E2C0, 0x1E2EB)
+XID_START(0x1E7E0, 0x1E7E6)
+XID_START(0x1E7E8, 0x1E7EB)
+XID_START(0x1E7ED, 0x1E7EE)
+XID_START(0x1E7F0, 0x1E7FE)
+XID_START(0x1E800, 0x1E8C4)
+XID_START(0x1E900, 0x1E943)
+XID_START(0x1E94B, 0x1E94B)
+XID_START(0x1EE00, 0x1EE03)
+XID_START(0x1EE05, 0x1EE1F)
+XID_START(0x1EE21, 0x1EE22)
+XID_START(0x1EE24, 0x1EE24)
+XID_START(0x1EE27, 0x1EE27)
+XID_START(0x1EE29, 0x1EE32)
+XID_START(0x1EE34, 0x1EE37)
+XID_START(0x1EE39, 0x1EE39)
+XID_START(0x1EE3B, 0x1EE3B)
+XID_START(0x1EE42, 0x1EE42)
+XID_START(0x1EE47, 0x1EE47)
+XID_START(0x1EE49, 0x1EE49)
+XID_START(0x1EE4B, 0x1EE4B)
+XID_START(0x1EE4D, 0x1EE4F)
+XID_START(0x1EE51, 0x1EE52)
+XID_START(0x1EE54, 0x1EE54)
+XID_START(0x1EE57, 0x1EE57)
+XID_START(0x1EE59, 0x1EE59)
+XID_START(0x1EE5B, 0x1EE5B)
+XID_START(0x1EE5D, 0x1EE5D)
+XID_START(0x1EE5F, 0x1EE5F)
+XID_START(0x1EE61, 0x1EE62)
+XID_START(0x1EE64, 0x1EE64)
+XID_START(0x1EE67, 0x1EE6A)
+XID_START(0x1EE6C, 0x1EE72)
+XID_START(0x1EE74, 0x1EE77)
+XID_START(0x1EE79, 0x1EE7C)
+XID_START(0x1EE7E, 0x1EE7E)
+XID_START(0x1EE80, 0x1EE89)
+XID_START(0x1EE8B, 0x1EE9B)
+XID_START(0x1EEA1, 0x1EEA3)
+XID_START(0x1EEA5, 0x1EEA9)
+XID_START(0x1EEAB, 0x1EEBB)
+XID_START(0x20000, 0x2A6DF)
+XID_START(0x2A700, 0x2B738)
+XID_START(0x2B740, 0x2B81D)
+XID_START(0x2B820, 0x2CEA1)
+XID_START(0x2CEB0, 0x2EBE0)
+XID_START(0x2F800, 0x2FA1D)
+XID_START(0x30000, 0x3134A)
+
+XID_CONTINUE(0x00AA, 0x00AA)
+XID_CONTINUE(0x00B5, 0x00B5)
+XID_CONTINUE(0x00B7, 0x00B7)
+XID_CONTINUE(0x00BA, 0x00BA)
+XID_CONTINUE(0x00C0, 0x00D6)
+XID_CONTINUE(0x00D8, 0x00F6)
+XID_CONTINUE(0x00F8, 0x02C1)
+XID_CONTINUE(0x02C6, 0x02D1)
+XID_CONTINUE(0x02E0, 0x02E4)
+XID_CONTINUE(0x02EC, 0x02EC)
+XID_CONTINUE(0x02EE, 0x02EE)
+XID_CONTINUE(0x0300, 0x0374)
+XID_CONTINUE(0x0376, 0x0377)
+XID_CONTINUE(0x037B, 0x037D)
+XID_CONTINUE(0x037F, 0x037F)
+XID_CONTINUE(0x0386, 0x038A)
+XID_CONTINUE(0x038C, 0x038C)
+XID_CONTINUE(0x038E, 0x03A1)
+XID_CONTINUE(0x03A3, 0x03F5)
+XID_CONTINUE(0x03F7, 0x0481)
+XID_CONTINUE(0x0483, 0x0487)
+XID_CONTINUE(0x048A, 0x052F)
+XID_CONTINUE(0x0531, 0x0556)
+XID_CONTINUE(0x0559, 0x0559)
+XID_CONTINUE(0x0560, 0x0588)
+XID_CONTINUE(0x0591, 0x05BD)
+XID_CONTINUE(0x05BF, 0x05BF)
+XID_CONTINUE(0x05C1, 0x05C2)
+XID_CONTINUE(0x05C4, 0x05C5)
+XID_CONTINUE(0x05C7, 0x05C7)
+XID_CONTINUE(0x05D0, 0x05EA)
+XID_CONTINUE(0x05EF, 0x05F2)
+XID_CONTINUE(0x0610, 0x061A)
+XID_CONTINUE(0x0620, 0x0669)
+XID_CONTINUE(0x066E, 0x06D3)
+XID_CONTINUE(0x06D5, 0x06DC)
+XID_CONTINUE(0x06DF, 0x06E8)
+XID_CONTINUE(0x06EA, 0x06FC)
+XID_CONTINUE(0x06FF, 0x06FF)
+XID_CONTINUE(0x0710, 0x074A)
+XID_CONTINUE(0x074D, 0x07B1)
+XID_CONTINUE(0x07C0, 0x07F5)
+XID_CONTINUE(0x07FA, 0x07FA)
+XID_CONTINUE(0x07FD, 0x07FD)
+XID_CONTINUE(0x0800, 0x082D)
+XID_CONTINUE(0x0840, 0x085B)
+XID_CONTINUE(0x0860, 0x086A)
+XID_CONTINUE(0x0870, 0x0887)
+XID_CONTINUE(0x0889, 0x088E)
+XID_CONTINUE(0x0898, 0x08E1)
+XID_CONTINUE(0x08E3, 0x0963)
+XID_CONTINUE(0x0966, 0x096F)
+XID_CONTINUE(0x0971, 0x0983)
+XID_CONTINUE(0x0985, 0x098C)
+XID_CONTINUE(0x098F, 0x0990)
+XID_CONTINUE(0x0993, 0x09A8)
+XID_CONTINUE(0x09AA, 0x09B0)
+XID_CONTINUE(0x09B2, 0x09B2)
+XID_CONTINUE(0x09B6, 0x09B9)
+XID_CONTINUE(0x09BC, 0x09C4)
+XID_CONTINUE(0x09C7, 0x09C8)
+XID_CONTINUE(0x09CB, 0x09CE)
+XID_CONTINUE(0x09D7, 0x09D7)
+XID_CONTINUE(0x09DC, 0x09DD)
+XID_CONTINUE(0x09DF, 0x09E3)
+XID_CONTINUE(0x09E6, 0x09F1)
+XID_CONTINUE(0x09FC, 0x09FC)
+XID_CONTINUE(0x09FE, 0x09FE)
+XID_CONTINUE(0x0A01, 0x0A03)
+XID_CONTINUE(0x0A05, 0x0A0A)
+XID_CONTINUE(0x0A0F, 0x0A10)
+XID_CONTINUE(0x0A13, 0x0A28)
+XID_CONTINUE(0x0A2A, 0x0A30)
+XID_CONTINUE(0x0A32, 0x0A33)
+XID_CONTINUE(0x0A35, 0x0A36)
+XID_CONTINUE(0x0A38, 0x0A39)
+XID_CONTINUE(0x0A3C, 0x0A3C)
+XID_CONTINUE(0x0A3E, 0x0A42)
+XID_CONTINUE(0x0A47, 0x0A48)
+XID_CONTINUE(0x0A4B, 0x0A4D)
+XID_CONTINUE(0x0A51, 0x0A51)
+XID_CONTINUE(0x0A59, 0x0A5C)
+XID_CONTINUE(0x0A5E, 0x0A5E)
+XID_CONTINUE(0x0A66, 0x0A75)
+XID_CONTINUE(0x0A81, 0x0A83)
+XID_CONTINUE(0x0A85, 0x0A8D)
+XID_CONTINUE(0x0A8F, 0x0A91)
+XID_CONTINUE(0x0A93, 0x0AA8)
+XID_CONTINUE(0x0AAA, 0x0AB0)
+XID_CONTINUE(0x0AB2, 0x0AB3)
+XID_CONTINUE(0x0AB5, 0x0AB9)
+XID_CONTINUE(0x0ABC, 0x0AC5)
+XID_CONTINUE(0x0AC7, 0x0AC9)
+XID_CONTINUE(0x0ACB, 0x0ACD)
+XID_CONTINUE(0x0AD0, 0x0AD0)
+XID_CONTINUE(0x0AE0, 0x0AE3)
+XID_CONTINUE(0x0AE6, 0x0AEF)
+XID_CONTINUE(0x0AF9, 0x0AFF)
+XID_CONTINUE(0x0B01, 0x0B03)
+XID_CONTINUE(0x0B05, 0x0B0C)
+XID_CONTINUE(0x0B0F, 0x0B10)
+XID_CONTINUE(0x0B13, 0x0B28)
+XID_CONTINUE(0x0B2A, 0x0B30)
+XID_CONTINUE(0x0B32, 0x0B33)
+XID_CONTINUE(0x0B35, 0x0B39)
+XID_CONTINUE(0x0B3C, 0x0B44)
+XID_CONTINUE(0x0B47, 0x0B48)
+XID_CONTINUE(0x0B4B, 0x0B4D)
+XID_CONTINUE(0x0B55, 0x0B57)
+XID_CONTINUE(0x0B5C, 0x0B5D)
+XID_CONTINUE(0x0B5F, 0x0B63)
+XID_CONTINUE(0x0B66, 0x0B6F)
+XID_CONTINUE(0x0B71, 0x0B71)
+XID_CONTINUE(0x0B82, 0x0B83)
+XID_CONTINUE(0x0B85, 0x0B8A)
+XID_CONTINUE(0x0B8E, 0x0B90)
+XID_CONTINUE(0x0B92, 0x0B95)
+XID_CONTINUE(0x0B99, 0x0B9A)
+XID_CONTINUE(0x0B9C, 0x0B9C)
+XID_CONTINUE(0x0B9E, 0x0B9F)
+XID_CONTINUE(0x0BA3, 0x0BA4)
+XID_CONTINUE(0x0BA8, 0x0BAA)
+XID_CONTINUE(0x0BAE, 0x0BB9)
+XID_CONTINUE(0x0BBE, 0x0BC2)
+XID_CONTINUE(0x0BC6, 0x0BC8)
+XID_CONTINUE(0x0BCA, 0x0BCD)
+XID_CONTINUE(0x0BD0, 0x0BD0)
+XID_CONTINUE(0x0BD7, 0x0BD7)
+XID_CONTINUE(0x0BE6, 0x0BEF)
+XID_CONTINUE(0x0C00, 0x0C0C)
+XID_CONTINUE(0x0C0E, 0x0C10)
+XID_CONTINUE(0x0C12, 0x0C28)
+XID_CONTINUE(0x0C2A, 0x0C39)
+XID_CONTINUE(0x0C3C, 0x0C44)
+XID_CONTINUE(0x0C46, 0x0C48)
+XID_CONTINUE(0x0C4A, 0x0C4D)
+XID_CONTINUE(0x0C55, 0x0C56)
+XID_CONTINUE(0x0C58, 0x0C5A)
+XID_CONTINUE(0x0C5D, 0x0C5D)
+XID_CONTINUE(0x0C60, 0x0C63)
+XID_CONTINUE(0x0C66, 0x0C6F)
+XID_CONTINUE(0x0C80, 0x0C83)
+XID_CONTINUE(0x0C85, 0x0C8C)
+XID_CONTINUE(0x0C8E, 0x0C90)
+XID_CONTINUE(0x0C92, 0x0CA8)
+XID_CONTINUE(0x0CAA, 0x0CB3)
+XID_CONTINUE(0x0CB5, 0x0CB9)
+XID_CONTINUE(0x0CBC, 0x0CC4)
+XID_CONTINUE(0x0CC6, 0x0CC8)
+XID_CONTINUE(0x0CCA, 0x0CCD)
+XID_CONTINUE(0x0CD5, 0x0CD6)
+XID_CONTINUE(0x0CDD, 0x0CDE)
+XID_CONTINUE(0x0CE0, 0x0CE3)
+XID_CONTINUE(0x0CE6, 0x0CEF)
+XID_CONTINUE(0x0CF1, 0x0CF2)
+XID_CONTINUE(0x0D00, 0x0D0C)
+XID_CONTINUE(0x0D0E, 0x0D10)
+XID_CONTINUE(0x0D12, 0x0D44)
+XID_CONTINUE(0x0D46, 0x0D48)
+XID_CONTINUE(0x0D4A, 0x0D4E)
+XID_CONTINUE(0x0D54, 0x0D57)
+XID_CONTINUE(0x0D5F, 0x0D63)
+XID_CONTINUE(0x0D66, 0x0D6F)
+XID_CONTINUE(0x0D7A, 0x0D7F)
+XID_CONTINUE(0x0D81, 0x0D83)
+XID_CONTINUE(0x0D85, 0x0D96)
+XID_CONTINUE(0x0D9A, 0x0DB1)
+XID_CONTINUE(0x0DB3, 0x0DBB)
+XID_CONTINUE(0x0DBD, 0x0DBD)
+XID_CONTINUE(0x0DC0, 0x0DC6)
+XID_CONTINUE(0x0DCA, 0x0DCA)
+XID_CONTINUE(0x0DCF, 0x0DD4)
+XID_CONTINUE(0x0DD6, 0x0DD6)
+XID_CONTINUE(0x0DD8, 0x0DDF)
+XID_CONTINUE(0x0DE6, 0x0DEF)
+XID_CONTINUE(0x0DF2, 0x0DF3)
+XID_CONTINUE(0x0E01, 0x0E3A)
+XID_CONTINUE(0x0E40, 0x0E4E)
+XID_CONTINUE(0x0E50, 0x0E59)
+XID_CONTINUE(0x0E81, 0x0E82)
+XID_CONTINUE(0x0E84, 0x0E84)
+XID_CONTINUE(0x0E86, 0x0E8A)
+XID_CONTINUE(0x0E8C, 0x0EA3)
+XID_CONTINUE(0x0EA5, 0x0EA5)
+XID_CONTINUE(0x0EA7, 0x0EBD)
+XID_CONTINUE(0x0EC0, 0x0EC4)
+XID_CONTINUE(0x0EC6, 0x0EC6)
+XID_CONTINUE(0x0EC8, 0x0ECD)
+XID_CONTINUE(0x0ED0, 0x0ED9)
+XID_CONTINUE(0x0EDC, 0x0EDF)
+XID_CONTINUE(0x0F00, 0x0F00)
+XID_CONTINUE(0x0F18, 0x0F19)
+XID_CONTINUE(0x0F20, 0x0F29)
+XID_CONTINUE(0x0F35, 0x0F35)
+XID_CONTINUE(0x0F37, 0x0F37)
+XID_CONTINUE(0x0F39, 0x0F39)
+XID_CONTINUE(0x0F3E, 0x0F47)
+XID_CONTINUE(0x0F49, 0x0F6C)
+XID_CONTINUE(0x0F71, 0x0F84)
+XID_CONTINUE(0x0F86, 0x0F97)
+XID_CONTINUE(0x0F99, 0x0FBC)
+XID_CONTINUE(0x0FC6, 0x0FC6)
+XID_CONTINUE(0x1000, 0x1049)
+XID_CONTINUE(0x1050, 0x109D)
+XID_CONTINUE(0x10A0, 0x10C5)
+XID_CONTINUE(0x10C7, 0x10C7)
+XID_CONTINUE(0x10CD, 0x10CD)
+XID_CONTINUE(0x10D0, 0x10FA)
+XID_CONTINUE(0x10FC, 0x1248)
+XID_CONTINUE(0x124A, 0x124D)
+XID_CONTINUE(0x1250, 0x1256)
+XID_CONTINUE(0x1258, 0x1258)
+XID_CONTINUE(0x125A, 0x125D)
+XID_CONTINUE(0x1260, 0x1288)
+XID_CONTINUE(0x128A, 0x128D)
+XID_CONTINUE(0x1290, 0x12B0)
+XID_CONTINUE(0x12B2, 0x12B5)
+XID_CONTINUE(0x12B8, 0x12BE)
+XID_CONTINUE(0x12C0, 0x12C0)
+XID_CONTINUE(0x12C2, 0x12C5)
+XID_CONTINUE(0x12C8, 0x12D6)
+XID_CONTINUE(0x12D8, 0x1310)
+XID_CONTINUE(0x1312, 0x1315)
+XID_CONTINUE(0x1318, 0x135A)
+XID_CONTINUE(0x135D, 0x135F)
+XID_CONTINUE(0x1369, 0x1371)
+XID_CONTINUE(0x1380, 0x138F)
+XID_CONTINUE(0x13A0, 0x13F5)
+XID_CONTINUE(0x13F8, 0x13FD)
+XID_CONTINUE(0x1401, 0x166C)
+XID_CONTINUE(0x166F, 0x167F)
+XID_CONTINUE(0x1681, 0x169A)
+XID_CONTINUE(0x16A0, 0x16EA)
+XID_CONTINUE(0x16EE, 0x16F8)
+XID_CONTINUE(0x1700, 0x1715)
+XID_CONTINUE(0x171F, 0x1734)
+XID_CONTINUE(0x1740, 0x1753)
+XID_CONTINUE(0x1760, 0x176C)
+XID_CONTINUE(0x176E, 0x1770)
+XID_CONTINUE(0x1772, 0x1773)
+XID_CONTINUE(0x1780, 0x17D3)
+XID_CONTINUE(0x17D7, 0x17D7)
+XID_CONTINUE(0x17DC, 0x17DD)
+XID_CONTINUE(0x17E0, 0x17E9)
+XID_CONTINUE(0x180B, 0x180D)
+XID_CONTINUE(0x180F, 0x1819)
+XID_CONTINUE(0x1820, 0x1878)
+XID_CONTINUE(0x1880, 0x18AA)
+XID_CONTINUE(0x18B0, 0x18F5)
+XID_CONTINUE(0x1900, 0x191E)
+XID_CONTINUE(0x1920, 0x192B)
+XID_CONTINUE(0x1930, 0x193B)
+XID_CONTINUE(0x1946, 0x196D)
+XID_CONTINUE(0x1970, 0x1974)
+XID_CONTINUE(0x1980, 0x19AB)
+XID_CONTINUE(0x19B0, 0x19C9)
+XID_CONTINUE(0x19D0, 0x19DA)
+XID_CONTINUE(0x1A00, 0x1A1B)
+XID_CONTINUE(0x1A20, 0x1A5E)
+XID_CONTINUE(0x1A60, 0x1A7C)
+XID_CONTINUE(0x1A7F, 0x1A89)
+XID_CONTINUE(0x1A90, 0x1A99)
+XID_CONTINUE(0x1AA7, 0x1AA7)
+XID_CONTINUE(0x1AB0, 0x1ABD)
+XID_CONTINUE(0x1ABF, 0x1ACE)
+XID_CONTINUE(0x1B00, 0x1B4C)
+XID_CONTINUE(0x1B50, 0x1B59)
+XID_CONTINUE(0x1B6B, 0x1B73)
+XID_CONTINUE(0x1B80, 0x1BF3)
+XID_CONTINUE(0x1C00, 0x1C37)
+XID_CONTINUE(0x1C40, 0x1C49)
+XID_CONTINUE(0x1C4D, 0x1C7D)
+XID_CONTINUE(0x1C80, 0x1C88)
+XID_CONTINUE(0x1C90, 0x1CBA)
+XID_CONTINUE(0x1CBD, 0x1CBF)
+XID_CONTINUE(0x1CD0, 0x1CD2)
+XID_CONTINUE(0x1CD4, 0x1CFA)
+XID_CONTINUE(0x1D00, 0x1F15)
+XID_CONTINUE(0x1F18, 0x1F1D)
+XID_CONTINUE(0x1F20, 0x1F45)
+XID_CONTINUE(0x1F48, 0x1F4D)
+XID_CONTINUE(0x1F50, 0x1F57)
+XID_CONTINUE(0x1F59, 0x1F59)
+XID_CONTINUE(0x1F5B, 0x1F5B)
+XID_CONTINUE(0x1F5D, 0x1F5D)
+XID_CONTINUE(0x1F5F, 0x1F7D)
+XID_CONTINUE(0x1F80, 0x1FB4)
+XID_CONTINUE(0x1FB6, 0x1FBC)
+XID_CONTINUE(0x1FBE, 0x1FBE)
+XID_CONTINUE(0x1FC2, 0x1FC4)
+XID_CONTINUE(0x1FC6, 0x1FCC)
+XID_CONTINUE(0x1FD0, 0x1FD3)
+XID_CONTINUE(0x1FD6, 0x1FDB)
+XID_CONTINUE(0x1FE0, 0x1FEC)
+XID_CONTINUE(0x1FF2, 0x1FF4)
+XID_CONTINUE(0x1FF6, 0x1FFC)
+XID_CONTINUE(0x203F, 0x2040)
+XID_CONTINUE(0x2054, 0x2054)
+XID_CONTINUE(0x2071, 0x2071)
+XID_CONTINUE(0x207F, 0x207F)
+XID_CONTINUE(0x2090, 0x209C)
+XID_CONTINUE(0x20D0, 0x20DC)
+XID_CONTINUE(0x20E1, 0x20E1)
+XID_CONTINUE(0x20E5, 0x20F0)
+XID_CONTINUE(0x2102, 0x2102)
+XID_CONTINUE(0x2107, 0x2107)
+XID_CONTINUE(0x210A, 0x2113)
+XID_CONTINUE(0x2115, 0x2115)
+XID_CONTINUE(0x2118, 0x211D)
+XID_CONTINUE(0x2124, 0x2124)
+XID_CONTINUE(0x2126, 0x2126)
+XID_CONTINUE(0x2128, 0x2128)
+XID_CONTINUE(0x212A, 0x2139)
+XID_CONTINUE(0x213C, 0x213F)
+XID_CONTINUE(0x2145, 0x2149)
+XID_CONTINUE(0x214E, 0x214E)
+XID_CONTINUE(0x2160, 0x2188)
+XID_CONTINUE(0x2C00, 0x2CE4)
+XID_CONTINUE(0x2CEB, 0x2CF3)
+XID_CONTINUE(0x2D00, 0x2D25)
+XID_CONTINUE(0x2D27, 0x2D27)
+XID_CONTINUE(0x2D2D, 0x2D2D)
+XID_CONTINUE(0x2D30, 0x2D67)
+XID_CONTINUE(0x2D6F, 0x2D6F)
+XID_CONTINUE(0x2D7F, 0x2D96)
+XID_CONTINUE(0x2DA0, 0x2DA6)
+XID_CONTINUE(0x2DA8, 0x2DAE)
+XID_CONTINUE(0x2DB0, 0x2DB6)
+XID_CONTINUE(0x2DB8, 0x2DBE)
+XID_CONTINUE(0x2DC0, 0x2DC6)
+XID_CONTINUE(0x2DC8, 0x2DCE)
+XID_CONTINUE(0x2DD0, 0x2DD6)
+XID_CONTINUE(0x2DD8, 0x2DDE)
+XID_CONTINUE(0x2DE0, 0x2DFF)
+XID_CONTINUE(0x3005, 0x3007)
+XID_CONTINUE(0x3021, 0x302F)
+XID_CONTINUE(0x3031, 0x3035)
+XID_CONTINUE(0x3038, 0x303C)
+XID_CONTINUE(0x3041, 0x3096)
+XID_CONTINUE(0x3099, 0x309A)
+XID_CONTINUE(0x309D, 0x309F)
+XID_CONTINUE(0x30A1, 0x30FA)
+XID_CONTINUE(0x30FC, 0x30FF)
+XID_CONTINUE(0x3105, 0x312F)
+XID_CONTINUE(0x3131, 0x318E)
+XID_CONTINUE(0x31A0, 0x31BF)
+XID_CONTINUE(0x31F0, 0x31FF)
+XID_CONTINUE(0x3400, 0x4DBF)
+XID_CONTINUE(0x4E00, 0xA48C)
+XID_CONTINUE(0xA4D0, 0xA4FD)
+XID_CONTINUE(0xA500, 0xA60C)
+XID_CONTINUE(0xA610, 0xA62B)
+XID_CONTINUE(0xA640, 0xA66F)
+XID_CONTINUE(0xA674, 0xA67D)
+XID_CONTINUE(0xA67F, 0xA6F1)
+XID_CONTINUE(0xA717, 0xA71F)
+XID_CONTINUE(0xA722, 0xA788)
+XID_CONTINUE(0xA78B, 0xA7CA)
+XID_CONTINUE(0xA7D0, 0xA7D1)
+XID_CONTINUE(0xA7D3, 0xA7D3)
+XID_CONTINUE(0xA7D5, 0xA7D9)
+XID_CONTINUE(0xA7F2, 0xA827)
+XID_CONTINUE(0xA82C, 0xA82C)
+XID_CONTINUE(0xA840, 0xA873)
+XID_CONTINUE(0xA880, 0xA8C5)
+XID_CONTINUE(0xA8D0, 0xA8D9)
+XID_CONTINUE(0xA8E0, 0xA8F7)
+XID_CONTINUE(0xA8FB, 0xA8FB)
+XID_CONTINUE(0xA8FD, 0xA92D)
+XID_CONTINUE(0xA930, 0xA953)
+XID_CONTINUE(0xA960, 0xA97C)
+XID_CONTINUE(0xA980, 0xA9C0)
+XID_CONTINUE(0xA9CF, 0xA9D9)
+XID_CONTINUE(0xA9E0, 0xA9FE)
+XID_CONTINUE(0xAA00, 0xAA36)
+XID_CONTINUE(0xAA40, 0xAA4D)
+XID_CONTINUE(0xAA50, 0xAA59)
+XID_CONTINUE(0xAA60, 0xAA76)
+XID_CONTINUE(0xAA7A, 0xAAC2)
+XID_CONTINUE(0xAADB, 0xAADD)
+XID_CONTINUE(0xAAE0, 0xAAEF)
+XID_CONTINUE(0xAAF2, 0xAAF6)
+XID_CONTINUE(0xAB01, 0xAB06)
+XID_CONTINUE(0xAB09, 0xAB0E)
+XID_CONTINUE(0xAB11, 0xAB16)
+XID_CONTINUE(0xAB20, 0xAB26)
+XID_CONTINUE(0xAB28, 0xAB2E)
+XID_CONTINUE(0xAB30, 0xAB5A)
+XID_CONTINUE(0xAB5C, 0xAB69)
+XID_CONTINUE(0xAB70, 0xABEA)
+XID_CONTINUE(0xABEC, 0xABED)
+XID_CONTINUE(0xABF0, 0xABF9)
+XID_CONTINUE(0xAC00, 0xD7A3)
+XID_CONTINUE(0xD7B0, 0xD7C6)
+XID_CONTINUE(0xD7CB, 0xD7FB)
+XID_CONTINUE(0xF900, 0xFA6D)
+XID_CONTINUE(0xFA70, 0xFAD9)
+XID_CONTINUE(0xFB00, 0xFB06)
+XID_CONTINUE(0xFB13, 0xFB17)
+XID_CONTINUE(0xFB1D, 0xFB28)
+XID_CONTINUE(0xFB2A, 0xFB36)
+XID_CONTINUE(0xFB38, 0xFB3C)
+XID_CONTINUE(0xFB3E, 0xFB3E)
+XID_CONTINUE(0xFB40, 0xFB41)
+XID_CONTINUE(0xFB43, 0xFB44)
+XID_CONTINUE(0xFB46, 0xFBB1)
+XID_CONTINUE(0xFBD3, 0xFC5D)
+XID_CONTINUE(0xFC64, 0xFD3D)
+XID_CONTINUE(0xFD50, 0xFD8F)
+XID_CONTINUE(0xFD92, 0xFDC7)
+XID_CONTINUE(0xFDF0, 0xFDF9)
+XID_CONTINUE(0xFE00, 0xFE0F)
+XID_CONTINUE(0xFE20, 0xFE2F)
+XID_CONTINUE(0xFE33, 0xFE34)
+XID_CONTINUE(0xFE4D, 0xFE4F)
+XID_CONTINUE(0xFE71, 0xFE71)
+XID_CONTINUE(0xFE73, 0xFE73)
+XID_CONTINUE(0xFE77, 0xFE77)
+XID_CONTINUE(0xFE79, 0xFE79)
+XID_CONTINUE(0xFE7B, 0xFE7B)
+XID_CONTINUE(0xFE7D, 0xFE7D)
+XID_CONTINUE(0xFE7F, 0xFEFC)
+XID_CONTINUE(0xFF10, 0xFF19)
+XID_CONTINUE(0xFF21, 0xFF3A)
+XID_CONTINUE(0xFF3F, 0xFF3F)
+XID_CONTINUE(0xFF41, 0xFF5A)
+XID_CONTINUE(0xFF66, 0xFFBE)
+XID_CONTINUE(0xFFC2, 0xFFC7)
+XID_CONTINUE(0xFFCA, 0xFFCF)
+XID_CONTINUE(0xFFD2, 0xFFD7)
+XID_CONTINUE(0xFFDA, 0xFFDC)
+XID_CONTINUE(0x10000, 0x1000B)
+XID_CONTINUE(0x1000D, 0x10026)
+XID_CONTINUE(0x10028, 0x1003A)
+XID_CONTINUE(0x1003C, 0x1003D)
+XID_CONTINUE(0x1003F, 0x1004D)
+XID_CONTINUE(0x10050, 0x1005D)
+XID_CONTINUE(0x10080, 0x100FA)
+XID_CONTINUE(0x10140, 0x10174)
+XID_CONTINUE(0x101FD, 0x101FD)
+XID_CONTINUE(0x10280, 0x1029C)
+XID_CONTINUE(0x102A0, 0x102D0)
+XID_CONTINUE(0x102E0, 0x102E0)
+XID_CONTINUE(0x10300, 0x1031F)
+XID_CONTINUE(0x1032D, 0x1034A)
+XID_CONTINUE(0x10350, 0x1037A)
+XID_CONTINUE(0x10380, 0x1039D)
+XID_CONTINUE(0x103A0, 0x103C3)
+XID_CONTINUE(0x103C8, 0x103CF)
+XID_CONTINUE(0x103D1, 0x103D5)
+XID_CONTINUE(0x10400, 0x1049D)
+XID_CONTINUE(0x104A0, 0x104A9)
+XID_CONTINUE(0x104B0, 0x104D3)
+XID_CONTINUE(0x104D8, 0x104FB)
+XID_CONTINUE(0x10500, 0x10527)
+XID_CONTINUE(0x10530, 0x10563)
+XID_CONTINUE(0x10570, 0x1057A)
+XID_CONTINUE(0x1057C, 0x1058A)
+XID_CONTINUE(0x1058C, 0x10592)
+XID_CONTINUE(0x10594, 0x10595)
+XID_CONTINUE(0x10597, 0x105A1)
+XID_CONTINUE(0x105A3, 0x105B1)
+XID_CONTINUE(0x105B3, 0x105B9)
+XID_CONTINUE(0x105BB, 0x105BC)
+XID_CONTINUE(0x10600, 0x10736)
+XID_CONTINUE(0x10740, 0x10755)
+XID_CONTINUE(0x10760, 0x10767)
+XID_CONTINUE(0x10780, 0x10785)
+XID_CONTINUE(0x10787, 0x107B0)
+XID_CONTINUE(0x107B2, 0x107BA)
+XID_CONTINUE(0x10800, 0x10805)
+XID_CONTINUE(0x10808, 0x10808)
+XID_CONTINUE(0x1080A, 0x10835)
+XID_CONTINUE(0x10837, 0x10838)
+XID_CONTINUE(0x1083C, 0x1083C)
+XID_CONTINUE(0x1083F, 0x10855)
+XID_CONTINUE(0x10860, 0x10876)
+XID_CONTINUE(0x10880, 0x1089E)
+XID_CONTINUE(0x108E0, 0x108F2)
+XID_CONTINUE(0x108F4, 0x108F5)
+XID_CONTINUE(0x10900, 0x10915)
+XID_CONTINUE(0x10920, 0x10939)
+XID_CONTINUE(0x10980, 0x109B7)
+XID_CONTINUE(0x109BE, 0x109BF)
+XID_CONTINUE(0x10A00, 0x10A03)
+XID_CONTINUE(0x10A05, 0x10A06)
+XID_CONTINUE(0x10A0C, 0x10A13)
+XID_CONTINUE(0x10A15, 0x10A17)
+XID_CONTINUE(0x10A19, 0x10A35)
+XID_CONTINUE(0x10A38, 0x10A3A)
+XID_CONTINUE(0x10A3F, 0x10A3F)
+XID_CONTINUE(0x10A60, 0x10A7C)
+XID_CONTINUE(0x10A80, 0x10A9C)
+XID_CONTINUE(0x10AC0, 0x10AC7)
+XID_CONTINUE(0x10AC9, 0x10AE6)
+XID_CONTINUE(0x10B00, 0x10B35)
+XID_CONTINUE(0x10B40, 0x10B55)
+XID_CONTINUE(0x10B60, 0x10B72)
+XID_CONTINUE(0x10B80, 0x10B91)
+XID_CONTINUE(0x10C00, 0x10C48)
+XID_CONTINUE(0x10C80, 0x10CB2)
+XID_CONTINUE(0x10CC0, 0x10CF2)
+XID_CONTINUE(0x10D00, 0x10D27)
+XID_CONTINUE(0x10D30, 0x10D39)
+XID_CONTINUE(0x10E80, 0x10EA9)
+XID_CONTINUE(0x10EAB, 0x10EAC)
+XID_CONTINUE(0x10EB0, 0x10EB1)
+XID_CONTINUE(0x10F00, 0x10F1C)
+XID_CONTINUE(0x10F27, 0x10F27)
+XID_CONTINUE(0x10F30, 0x10F50)
+XID_CONTINUE(0x10F70, 0x10F85)
+XID_CONTINUE(0x10FB0, 0x10FC4)
+XID_CONTINUE(0x10FE0, 0x10FF6)
+XID_CONTINUE(0x11000, 0x11046)
+XID_CONTINUE(0x11066, 0x11075)
+XID_CONTINUE(0x1107F, 0x110BA)
+XID_CONTINUE(0x110C2, 0x110C2)
+XID_CONTINUE(0x110D0, 0x110E8)
+XID_CONTINUE(0x110F0, 0x110F9)
+XID_CONTINUE(0x11100, 0x11134)
+XID_CONTINUE(0x11136, 0x1113F)
+XID_CONTINUE(0x11144, 0x11147)
+XID_CONTINUE(0x11150, 0x11173)
+XID_CONTINUE(0x11176, 0x11176)
+XID_CONTINUE(0x11180, 0x111C4)
+XID_CONTINUE(0x111C9, 0x111CC)
+XID_CONTINUE(0x111CE, 0x111DA)
+XID_CONTINUE(0x111DC, 0x111DC)
+XID_CONTINUE(0x11200, 0x11211)
+XID_CONTINUE(0x11213, 0x11237)
+XID_CONTINUE(0x1123E, 0x1123E)
+XID_CONTINUE(0x11280, 0x11286)
+XID_CONTINUE(0x11288, 0x11288)
+XID_CONTINUE(0x1128A, 0x1128D)
+XID_CONTINUE(0x1128F, 0x1129D)
+XID_CONTINUE(0x1129F, 0x112A8)
+XID_CONTINUE(0x112B0, 0x112EA)
+XID_CONTINUE(0x112F0, 0x112F9)
+XID_CONTINUE(0x11300, 0x11303)
+XID_CONTINUE(0x11305, 0x1130C)
+XID_CONTINUE(0x1130F, 0x11310)
+XID_CONTINUE(0x11313, 0x11328)
+XID_CONTINUE(0x1132A, 0x11330)
+XID_CONTINUE(0x11332, 0x11333)
+XID_CONTINUE(0x11335, 0x11339)
+XID_CONTINUE(0x1133B, 0x11344)
+XID_CONTINUE(0x11347, 0x11348)
+XID_CONTINUE(0x1134B, 0x1134D)
+XID_CONTINUE(0x11350, 0x11350)
+XID_CONTINUE(0x11357, 0x11357)
+XID_CONTINUE(0x1135D, 0x11363)
+XID_CONTINUE(0x11366, 0x1136C)
+XID_CONTINUE(0x11370, 0x11374)
+XID_CONTINUE(0x11400, 0x1144A)
+XID_CONTINUE(0x11450, 0x11459)
+XID_CONTINUE(0x1145E, 0x11461)
+XID_CONTINUE(0x11480, 0x114C5)
+XID_CONTINUE(0x114C7, 0x114C7)
+XID_CONTINUE(0x114D0, 0x114D9)
+XID_CONTINUE(0x11580, 0x115B5)
+XID_CONTINUE(0x115B8, 0x115C0)
+XID_CONTINUE(0x115D8, 0x115DD)
+XID_CONTINUE(0x11600, 0x11640)
+XID_CONTINUE(0x11644, 0x11644)
+XID_CONTINUE(0x11650, 0x11659)
+XID_CONTINUE(0x11680, 0x116B8)
+XID_CONTINUE(0x116C0, 0x116C9)
+XID_CONTINUE(0x11700, 0x1171A)
+XID_CONTINUE(0x1171D, 0x1172B)
+XID_CONTINUE(0x11730, 0x11739)
+XID_CONTINUE(0x11740, 0x11746)
+XID_CONTINUE(0x11800, 0x1183A)
+XID_CONTINUE(0x118A0, 0x118E9)
+XID_CONTINUE(0x118FF, 0x11906)
+XID_CONTINUE(0x11909, 0x11909)
+XID_CONTINUE(0x1190C, 0x11913)
+XID_CONTINUE(0x11915, 0x11916)
+XID_CONTINUE(0x11918, 0x11935)
+XID_CONTINUE(0x11937, 0x11938)
+XID_CONTINUE(0x1193B, 0x11943)
+XID_CONTINUE(0x11950, 0x11959)
+XID_CONTINUE(0x119A0, 0x119A7)
+XID_CONTINUE(0x119AA, 0x119D7)
+XID_CONTINUE(0x119DA, 0x119E1)
+XID_CONTINUE(0x119E3, 0x119E4)
+XID_CONTINUE(0x11A00, 0x11A3E)
+XID_CONTINUE(0x11A47, 0x11A47)
+XID_CONTINUE(0x11A50, 0x11A99)
+XID_CONTINUE(0x11A9D, 0x11A9D)
+XID_CONTINUE(0x11AB0, 0x11AF8)
+XID_CONTINUE(0x11C00, 0x11C08)
+XID_CONTINUE(0x11C0A, 0x11C36)
+XID_CONTINUE(0x11C38, 0x11C40)
+XID_CONTINUE(0x11C50, 0x11C59)
+XID_CONTINUE(0x11C72, 0x11C8F)
+XID_CONTINUE(0x11C92, 0x11CA7)
+XID_CONTINUE(0x11CA9, 0x11CB6)
+XID_CONTINUE(0x11D00, 0x11D06)
+XID_CONTINUE(0x11D08, 0x11D09)
+XID_CONTINUE(0x11D0B, 0x11D36)
+XID_CONTINUE(0x11D3A, 0x11D3A)
+XID_CONTINUE(0x11D3C, 0x11D3D)
+XID_CONTINUE(0x11D3F, 0x11D47)
+XID_CONTINUE(0x11D50, 0x11D59)
+XID_CONTINUE(0x11D60, 0x11D65)
+XID_CONTINUE(0x11D67, 0x11D68)
+XID_CONTINUE(0x11D6A, 0x11D8E)
+XID_CONTINUE(0x11D90, 0x11D91)
+XID_CONTINUE(0x11D93, 0x11D98)
+XID_CONTINUE(0x11DA0, 0x11DA9)
+XID_CONTINUE(0x11EE0, 0x11EF6)
+XID_CONTINUE(0x11FB0, 0x11FB0)
+XID_CONTINUE(0x12000, 0x12399)
+XID_CONTINUE(0x12400, 0x1246E)
+XID_CONTINUE(0x12480, 0x12543)
+XID_CONTINUE(0x12F90, 0x12FF0)
+XID_CONTINUE(0x13000, 0x1342E)
+XID_CONTINUE(0x14400, 0x14646)
+XID_CONTINUE(0x16800, 0x16A38)
+XID_CONTINUE(0x16A40, 0x16A5E)
+XID_CONTINUE(0x16A60, 0x16A69)
+XID_CONTINUE(0x16A70, 0x16ABE)
+XID_CONTINUE(0x16AC0, 0x16AC9)
+XID_CONTINUE(0x16AD0, 0x16AED)
+XID_CONTINUE(0x16AF0, 0x16AF4)
+XID_CONTINUE(0x16B00, 0x16B36)
+XID_CONTINUE(0x16B40, 0x16B43)
+XID_CONTINUE(0x16B50, 0x16B59)
+XID_CONTINUE(0x16B63, 0x16B77)
+XID_CONTINUE(0x16B7D, 0x16B8F)
+XID_CONTINUE(0x16E40, 0x16E7F)
+XID_CONTINUE(0x16F00, 0x16F4A)
+XID_CONTINUE(0x16F4F, 0x16F87)
+XID_CONTINUE(0x16F8F, 0x16F9F)
+XID_CONTINUE(0x16FE0, 0x16FE1)
+XID_CONTINUE(0x16FE3, 0x16FE4)
+XID_CONTINUE(0x16FF0, 0x16FF1)
+XID_CONTINUE(0x17000, 0x187F7)
+XID_CONTINUE(0x18800, 0x18CD5)
+XID_CONTINUE(0x18D00, 0x18D08)
+XID_CONTINUE(0x1AFF0, 0x1AFF3)
+XID_CONTINUE(0x1AFF5, 0x1AFFB)
+XID_CONTINUE(0x1AFFD, 0x1AFFE)
+XID_CONTINUE(0x1B000, 0x1B122)
+XID_CONTINUE(0x1B150, 0x1B152)
+XID_CONTINUE(0x1B164, 0x1B167)
+XID_CONTINUE(0x1B170, 0x1B2FB)
+XID_CONTINUE(0x1BC00, 0x1BC6A)
+XID_CONTINUE(0x1BC70, 0x1BC7C)
+XID_CONTINUE(0x1BC80, 0x1BC88)
+XID_CONTINUE(0x1BC90, 0x1BC99)
+XID_CONTINUE(0x1BC9D, 0x1BC9E)
+XID_CONTINUE(0x1CF00, 0x1CF2D)
+XID_CONTINUE(0x1CF30, 0x1CF46)
+XID_CONTINUE(0x1D165, 0x1D169)
+XID_CONTINUE(0x1D16D, 0x1D172)
+XID_CONTINUE(0x1D17B, 0x1D182)
+XID_CONTINUE(0x1D185, 0x1D18B)
+XID_CONTINUE(0x1D1AA, 0x1D1AD)
+XID_CONTINUE(0x1D242, 0x1D244)
+XID_CONTINUE(0x1D400, 0x1D454)
+XID_CONTINUE(0x1D456, 0x1D49C)
+XID_CONTINUE(0x1D49E, 0x1D49F)
+XID_CONTINUE(0x1D4A2, 0x1D4A2)
+XID_CONTINUE(0x1D4A5, 0x1D4A6)
+XID_CONTINUE(0x1D4A9, 0x1D4AC)
+XID_CONTINUE(0x1D4AE, 0x1D4B9)
+XID_CONTINUE(0x1D4BB, 0x1D4BB)
+XID_CONTINUE(0x1D4BD, 0x1D4C3)
+XID_CONTINUE(0x1D4C5, 0x1D505)
+XID_CONTINUE(0x1D507, 0x1D50A)
+XID_CONTINUE(0x1D50D, 0x1D514)
+XID_CONTINUE(0x1D516, 0x1D51C)
+XID_CONTINUE(0x1D51E, 0x1D539)
+XID_CONTINUE(0x1D53B, 0x1D53E)
+XID_CONTINUE(0x1D540, 0x1D544)
+XID_CONTINUE(0x1D546, 0x1D546)
+XID_CONTINUE(0x1D54A, 0x1D550)
+XID_CONTINUE(0x1D552, 0x1D6A5)
+XID_CONTINUE(0x1D6A8, 0x1D6C0)
+XID_CONTINUE(0x1D6C2, 0x1D6DA)
+XID_CONTINUE(0x1D6DC, 0x1D6FA)
+XID_CONTINUE(0x1D6FC, 0x1D714)
+XID_CONTINUE(0x1D716, 0x1D734)
+XID_CONTINUE(0x1D736, 0x1D74E)
+XID_CONTINUE(0x1D750, 0x1D76E)
+XID_CONTINUE(0x1D770, 0x1D788)
+XID_CONTINUE(0x1D78A, 0x1D7A8)
+XID_CONTINUE(0x1D7AA, 0x1D7C2)
+XID_CONTINUE(0x1D7C4, 0x1D7CB)
+XID_CONTINUE(0x1D7CE, 0x1D7FF)
+XID_CONTINUE(0x1DA00, 0x1DA36)
+XID_CONTINUE(0x1DA3B, 0x1DA6C)
+XID_CONTINUE(0x1DA75, 0x1DA75)
+XID_CONTINUE(0x1DA84, 0x1DA84)
+XID_CONTINUE(0x1DA9B, 0x1DA9F)
+XID_CONTINUE(0x1DAA1, 0x1DAAF)
+XID_CONTINUE(0x1DF00, 0x1DF1E)
+XID_CONTINUE(0x1E000, 0x1E006)
+XID_CONTINUE(0x1E008, 0x1E018)
+XID_CONTINUE(0x1E01B, 0x1E021)
+XID_CONTINUE(0x1E023, 0x1E024)
+XID_CONTINUE(0x1E026, 0x1E02A)
+XID_CONTINUE(0x1E100, 0x1E12C)
+XID_CONTINUE(0x1E130, 0x1E13D)
+XID_CONTINUE(0x1E140, 0x1E149)
+XID_CONTINUE(0x1E14E, 0x1E14E)
+XID_CONTINUE(0x1E290, 0x1E2AE)
+XID_CONTINUE(0x1E2C0, 0x1E2F9)
+XID_CONTINUE(0x1E7E0, 0x1E7E6)
+XID_CONTINUE(0x1E7E8, 0x1E7EB)
+XID_CONTINUE(0x1E7ED, 0x1E7EE)
+XID_CONTINUE(0x1E7F0, 0x1E7FE)
+XID_CONTINUE(0x1E800, 0x1E8C4)
+XID_CONTINUE(0x1E8D0, 0x1E8D6)
+XID_CONTINUE(0x1E900, 0x1E94B)
+XID_CONTINUE(0x1E950, 0x1E959)
+XID_CONTINUE(0x1EE00, 0x1EE03)
+XID_CONTINUE(0x1EE05, 0x1EE1F)
+XID_CONTINUE(0x1EE21, 0x1EE22)
+XID_CONTINUE(0x1EE24, 0x1EE24)
+XID_CONTINUE(0x1EE27, 0x1EE27)
+XID_CONTINUE(0x1EE29, 0x1EE32)
+XID_CONTINUE(0x1EE34, 0x1EE37)
+XID_CONTINUE(0x1EE39, 0x1EE39)
+XID_CONTINUE(0x1EE3B, 0x1EE3B)
+XID_CONTINUE(0x1EE42, 0x1EE42)
+XID_CONTINUE(0x1EE47, 0x1EE47)
+XID_CONTINUE(0x1EE49, 0x1EE49)
+XID_CONTINUE(0x1EE4B, 0x1EE4B)
+XID_CONTINUE(0x1EE4D, 0x1EE4F)
+XID_CONTINUE(0x1EE51, 0x1EE52)
+XID_CONTINUE(0x1EE54, 0x1EE54)
+XID_CONTINUE(0x1EE57, 0x1EE57)
+XID_CONTINUE(0x1EE59, 0x1EE59)
+XID_CONTINUE(0x1EE5B, 0x1EE5B)
+XID_CONTINUE(0x1EE5D, 0x1EE5D)
+XID_CONTINUE(0x1EE5F, 0x1EE5F)
+XID_CONTINUE(0x1EE61, 0x1EE62)
+XID_CONTINUE(0x1EE64, 0x1EE64)
+XID_CONTINUE(0x1EE67, 0x1EE6A)
+XID_CONTINUE(0x1EE6C, 0x1EE72)
+XID_CONTINUE(0x1EE74, 0x1EE77)
+XID_CONTINUE(0x1EE79, 0x1EE7C)
+XID_CONTINUE(0x1EE7E, 0x1EE7E)
+XID_CONTINUE(0x1EE80, 0x1EE89)
+XID_CONTINUE(0x1EE8B, 0x1EE9B)
+XID_CONTINUE(0x1EEA1, 0x1EEA3)
+XID_CONTINUE(0x1EEA5, 0x1EEA9)
+XID_CONTINUE(0x1EEAB, 0x1EEBB)
+XID_CONTINUE(0x1FBF0, 0x1FBF9)
+XID_CONTINUE(0x20000, 0x2A6DF)
+XID_CONTINUE(0x2A700, 0x2B738)
+XID_CONTINUE(0x2B740, 0x2B81D)
+XID_CONTINUE(0x2B820, 0x2CEA1)
+XID_CONTINUE(0x2CEB0, 0x2EBE0)
+XID_CONTINUE(0x2F800, 0x2FA1D)
+XID_CONTINUE(0x30000, 0x3134A)
+XID_CONTINUE(0xE0100, 0xE01EF)
+
+#undef XID_START
+#undef XID_CONTINUE
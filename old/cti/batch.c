@@ -0,0 +1,332 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cti.h"
+
+/* errors kept per stage, a window with more than this stops everything */
+#define MAX_ERRS 0x10000
+
+/* tokens lexed before the statements so far are parsed and evaluated */
+#define WINDOW 0x100000
+
+/* a run of expressions and what evaluating them produced */
+typedef struct {
+    /* doesnt own */
+    CtAST **nodes;
+    size_t len;
+
+    /* owns */
+    CtBuffer out;
+    CtBuffer errs;
+
+    pthread_t thread;
+    bool started;
+} Worker;
+
+static void addErrors(CtBuffer *out, const CtError *errs, size_t len) {
+    ctAppend(out, (const char*)errs, sizeof(CtError) * len);
+}
+
+static void *evalWorker(void *arg) {
+    Worker *self = arg;
+    CtArena bigs = ctArenaAlloc(ctSystem(), 0x1000);
+    CtArenaMark mark = ctArenaMark(&bigs);
+    size_t i;
+
+    for (i = 0; i < self->len; i++) {
+        CtNum value;
+        CtError err;
+
+        if (ctEvalNum(self->nodes[i], &bigs.base, &value, &err)) {
+            ctNumDecimal(value, &self->out);
+            ctPush(&self->out, '\n');
+        } else {
+            addErrors(&self->errs, &err, 1);
+        }
+
+        ctArenaRewind(&bigs, mark);
+    }
+
+    ctArenaFree(&bigs);
+    return NULL;
+}
+
+/* evaluate nodes on a pool of workers, results go to stdout in order */
+static void evalAll(CtAST **nodes, size_t len, size_t workers, CtBuffer *errs) {
+    Worker *pool = ctAlloc(ctSystem(), sizeof(Worker) * workers);
+    size_t per = (len + workers - 1) / workers;
+    size_t i;
+
+    for (i = 0; i < workers; i++) {
+        Worker *it = &pool[i];
+        size_t begin = i * per < len ? i * per : len;
+
+        it->nodes = nodes + begin;
+        it->len = len - begin < per ? len - begin : per;
+        it->out = ctBufferAlloc(ctSystem(), 0x10000);
+        it->errs = ctBufferAlloc(ctSystem(), 0);
+        it->started = false;
+    }
+
+    /* the first run is evaluated here, as is any that couldnt get a thread */
+    for (i = 1; i < workers; i++)
+        pool[i].started = pthread_create(&pool[i].thread, NULL, evalWorker, &pool[i]) == 0;
+
+    evalWorker(&pool[0]);
+
+    for (i = 0; i < workers; i++) {
+        Worker *it = &pool[i];
+
+        if (it->started)
+            pthread_join(it->thread, NULL);
+        else if (i)
+            evalWorker(it);
+
+        fwrite(ctAt(&it->out, 0), 1, ctOffset(&it->out), stdout);
+        ctAppend(errs, ctAt(&it->errs, 0), ctOffset(&it->errs));
+
+        ctBufferFree(it->out);
+        ctBufferFree(it->errs);
+    }
+
+    ctRelease(ctSystem(), pool, sizeof(Worker) * workers);
+}
+
+/* the leftmost token of an expression, or the name of a declaration */
+static CtLoc nodeStart(CtAST *node) {
+    while (1) {
+        if (node->kind == AK_BINARY)
+            node = node->data.binary.lhs;
+        else if (node->kind == AK_TERNARY)
+            node = node->data.ternary.cond;
+        else
+            return node->tok.where.loc;
+    }
+}
+
+/* index of the statement containing loc, starts is sorted */
+static size_t stmtAt(const CtLoc *starts, size_t len, CtLoc loc) {
+    size_t lo = 0;
+    size_t hi = len;
+
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (starts[mid] <= loc)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+static void markFailed(uint8_t *failed, const CtLoc *starts, size_t len, const CtError *errs, size_t count) {
+    size_t i;
+
+    for (i = 0; i < count; i++)
+        failed[stmtAt(starts, len, errs[i].where.loc)] = 1;
+}
+
+static int byLocation(const void *lhs, const void *rhs) {
+    CtLoc a = ((const CtError*)lhs)->where.loc;
+    CtLoc b = ((const CtError*)rhs)->where.loc;
+
+    return a < b ? -1 : a > b;
+}
+
+/* every error of every stage in source order, written out in one go */
+static void printErrors(CtSources *sources, CtBuffer *errs) {
+    CtError *all = (CtError*)ctAt(errs, 0);
+    size_t len = ctOffset(errs) / sizeof(CtError);
+    CtBuffer out = ctBufferAlloc(ctSystem(), 0);
+    size_t i;
+
+    qsort(all, len, sizeof(CtError), byLocation);
+
+    for (i = 0; i < len; i++) {
+        CtPosition pos = ctDecode(sources, all[i].where.loc);
+        const char *text = ctiErrors[all[i].kind];
+        char line[64];
+
+        ctAppend(&out, pos.name, strlen(pos.name));
+        sprintf(line, ":%lu:%lu: ", (unsigned long)pos.line + 1, (unsigned long)pos.col + 1);
+        ctAppend(&out, line, strlen(line));
+        ctAppend(&out, text, strlen(text));
+        ctPush(&out, '\n');
+    }
+
+    fwrite(ctAt(&out, 0), 1, ctOffset(&out), stderr);
+    ctBufferFree(out);
+}
+
+/* resolve each statement on its own in source order, expressions from statements without errors end up in todo */
+static void resolveAll(CtResolver *resolver, CtLexer *lex, CtSplit *split, CtBuffer *starts, CtBuffer *errs, CtBuffer *todo) {
+    const CtLoc *first = (const CtLoc*)ctAt(starts, 0);
+    size_t stmts = ctOffset(starts) / sizeof(CtLoc);
+    uint8_t *failed = ctAlloc(ctSystem(), stmts);
+    size_t i;
+
+    memset(failed, 0, stmts);
+    markFailed(failed, first, stmts, lex->errs, lex->err_idx);
+    markFailed(failed, first, stmts, split->errs, split->err_idx);
+
+    for (i = 0; i < split->len; i++) {
+        CtAST *node = split->nodes[i];
+        size_t stmt = stmtAt(first, stmts, nodeStart(node));
+
+        if (failed[stmt])
+            continue;
+
+        ctResolve(resolver, &node, 1);
+
+        if (resolver->err_idx) {
+            addErrors(errs, resolver->errs, resolver->err_idx);
+            resolver->err_idx = 0;
+            failed[stmt] = 1;
+            continue;
+        }
+
+        /* declarations dont have a value */
+        if (!(node->kind >= AK_DEF && node->kind <= AK_TRAIT))
+            ctAppend(todo, (const char*)&node, sizeof(CtAST*));
+    }
+
+    ctRelease(ctSystem(), failed, stmts);
+}
+
+/**
+ * lex about WINDOW tokens worth of whole statements and note where
+ * each one starts, so every error whichever stage it comes from can
+ * be pinned on its statement. returns false once the file is done
+ */
+static bool lexWindow(CtLexer *lex, CtBuffer *tokens, CtBuffer *starts) {
+    size_t depth = 0;
+    bool open = true;
+    CtToken tok;
+
+    ctRewind(tokens, 0);
+    ctRewind(starts, 0);
+
+    while (1) {
+        tok = ctLex(lex);
+
+        if (open)
+            ctAppend(starts, (const char*)&tok.where.loc, sizeof(CtLoc));
+
+        ctAppend(tokens, (const char*)&tok, sizeof(CtToken));
+
+        if (tok.kind == TK_END)
+            return false;
+
+        open = ctStmtEnds(tok, &depth);
+
+        /* split parsing wants an end token, this one goes right after the ; */
+        if (open && ctOffset(tokens) >= sizeof(CtToken) * WINDOW) {
+            tok.kind = TK_END;
+            tok.where.loc += tok.where.len;
+            tok.where.len = 0;
+
+            ctAppend(tokens, (const char*)&tok, sizeof(CtToken));
+            return true;
+        }
+    }
+}
+
+/**
+ * like the repl nothing in a broken statement is resolved or
+ * evaluated, and every statement is resolved in a scope of its own
+ * so it only sees what it declares itself. unlike it every window of
+ * statements is parsed in parallel, names are resolved serially
+ * through the one resolver, then the expressions left are evaluated
+ * in parallel and written out before the next window
+ */
+int ctiBatch(const char *path, size_t workers) {
+    CtLoader loader;
+    CtLoad load;
+    CtMemory memory;
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex;
+    CtResolver resolver;
+    CtBuffer tokens = ctBufferAlloc(ctSystem(), sizeof(CtToken) * (WINDOW + 64));
+    CtBuffer starts = ctBufferAlloc(ctSystem(), 0);
+    CtBuffer errs = ctBufferAlloc(ctSystem(), 0);
+    CtBuffer todo = ctBufferAlloc(ctSystem(), 0);
+    size_t reported = 0;
+    bool more = true;
+    int status = 0;
+
+    load.path = path;
+
+    if (!ctLoaderStart(&loader, ctSystem(), &load, 1, 1, 1)) {
+        fprintf(stderr, "cti: couldnt start loading %s\n", path);
+        status = 1;
+    } else if (ctLoaderWait(&loader, 0)->error) {
+        fprintf(stderr, "cti: cant read %s: %s\n", path, strerror(load.error));
+        status = 1;
+        more = false;
+    }
+
+    if (status && !more) {
+        ctLoaderDone(&loader, &load);
+        ctLoaderJoin(&loader);
+    }
+
+    if (status) {
+        ctSourcesFree(&sources);
+        return status;
+    }
+
+    memory = ctMemory(load.data, load.size);
+    lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, path, &memory, ctMemoryNext), MAX_ERRS);
+    resolver = ctResolverAlloc(&lex, ctSystem(), MAX_ERRS);
+
+    while (more) {
+        CtSplit split;
+
+        more = lexWindow(&lex, &tokens, &starts);
+        ctSplitParse(&split, ctSystem(), &lex, (const CtToken*)ctAt(&tokens, 0), ctOffset(&tokens) / sizeof(CtToken), workers, MAX_ERRS);
+
+        if (lex.reported - reported > lex.err_idx || split.err_idx == MAX_ERRS) {
+            fprintf(stderr, "cti: too many errors in %s\n", path);
+            ctSplitFree(&split);
+            status = 1;
+            break;
+        }
+
+        addErrors(&errs, lex.errs, lex.err_idx);
+        addErrors(&errs, split.errs, split.err_idx);
+
+        ctRewind(&todo, 0);
+        resolveAll(&resolver, &lex, &split, &starts, &errs, &todo);
+        evalAll((CtAST**)ctAt(&todo, 0), ctOffset(&todo) / sizeof(CtAST*), workers, &errs);
+
+        fflush(stdout);
+        printErrors(&sources, &errs);
+
+        if (ctOffset(&errs))
+            status = 1;
+
+        ctRewind(&errs, 0);
+        reported = lex.reported;
+        lex.err_idx = 0;
+
+        ctSplitFree(&split);
+    }
+
+    ctResolverFree(&resolver);
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+
+    ctLoaderDone(&loader, &load);
+    ctLoaderJoin(&loader);
+
+    ctBufferFree(tokens);
+    ctBufferFree(starts);
+    ctBufferFree(errs);
+    ctBufferFree(todo);
+
+    return status;
+}
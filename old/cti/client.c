@@ -0,0 +1,142 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * thin client for cti --server
+ *   cti-client <socket> <request...>   send one request
+ *   cti-client <socket>                send every line of stdin
+ * prints the replies and fails if any of them was an error.
+ * stdin is sent while replies are read, so a long pipe of requests
+ * never has both ends waiting for the other to read
+ */
+
+static int writeAll(int fd, const char *data, size_t len) {
+    while (len) {
+        ssize_t n = write(fd, data, len);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0)
+            return 0;
+
+        data += n;
+        len -= n;
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    struct sockaddr_un addr;
+    struct pollfd fds[2];
+    char data[4096];
+    char pending[4096];
+    size_t sent = 0;
+    size_t filled = 0;
+    int input = 0;
+    int fd;
+    int status = 0;
+    int start = 1;
+    ssize_t n;
+    int i;
+
+    if (argc < 2 || strlen(argv[1]) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "usage: cti-client <socket> [request...]\n");
+        return 2;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, argv[1]);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "cti-client: %s: %s\n", argv[1], strerror(errno));
+        return 2;
+    }
+
+    /* the server answers everything it got before it sees the end */
+    if (argc > 2) {
+        for (i = 2; i < argc; i++) {
+            writeAll(fd, argv[i], strlen(argv[i]));
+            writeAll(fd, i + 1 < argc ? " " : "\n", 1);
+        }
+
+        shutdown(fd, SHUT_WR);
+        input = -1;
+    }
+
+    /* a server going away is seen as a failed write */
+    signal(SIGPIPE, SIG_IGN);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    while (1) {
+        /* stdin is only read once what came from it before is sent, poll skips a negative fd */
+        fds[0].fd = sent == filled ? input : -1;
+        fds[0].events = POLLIN;
+        fds[1].fd = fd;
+        fds[1].events = sent < filled ? POLLIN | POLLOUT : POLLIN;
+
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[0].revents) {
+            n = read(input, pending, sizeof(pending));
+
+            if (n > 0) {
+                sent = 0;
+                filled = n;
+            } else if (n == 0 || errno != EINTR) {
+                shutdown(fd, SHUT_WR);
+                input = -1;
+            }
+        }
+
+        if (sent < filled && (fds[1].revents & (POLLOUT | POLLHUP | POLLERR))) {
+            n = write(fd, pending + sent, filled - sent);
+
+            if (n > 0) {
+                sent += n;
+            } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                /* the server is gone, whatever it already answered is still read */
+                sent = filled = 0;
+                input = -1;
+            }
+        }
+
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            n = read(fd, data, sizeof(data));
+
+            if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+                continue;
+
+            if (n <= 0)
+                break;
+
+            for (i = 0; i < n; i++) {
+                if (start && data[i] == 'e')
+                    status = 1;
+
+                start = data[i] == '\n';
+            }
+
+            fwrite(data, 1, n, stdout);
+        }
+    }
+
+    close(fd);
+    return status;
+}
@@ -0,0 +1,46 @@
+#ifndef CTI_H
+#define CTI_H
+
+#include "cthulhu/cthulhu.h"
+
+/* text for every CtErrorKind */
+extern const char *ctiErrors[];
+
+/* writes value in decimal without a terminator, returns its length */
+size_t ctiFormat(CtInt value, char *out);
+
+/**
+ * serve compile and evaluate requests on a unix socket until
+ * a client asks it to stop. one request per line:
+ *   eval <expr>   evaluate an expression, repeated ones are cached
+ *   check <path>  parse and resolve a file, cached by mtime and hash
+ *   stats         cache sizes and hit counts
+ *   stop          shut the server down
+ * every request gets one line back starting with ok or error
+ */
+int ctiServe(const char *path);
+
+/**
+ * evaluate every expression in a file as fast as possible.
+ * values are written to stdout in input order like the repl would,
+ * errors go to stderr by line once everything has been evaluated.
+ * workers is how many threads parse and evaluate
+ */
+int ctiBatch(const char *path, size_t workers);
+
+/**
+ * write the tokens of a file, or the tree of every statement in it
+ * when ast is set, to stdout. json lines by default, or the binary
+ * format described in emit.c. errors are written as records too,
+ * and if there were any this returns 1
+ */
+int ctiEmit(const char *path, bool ast, bool binary);
+
+/**
+ * lex, parse, resolve and evaluate one statement runs times on its
+ * own, then print its value and per phase latency percentiles,
+ * bytes and allocations, and how many tokens and nodes it made
+ */
+void ctiProfile(const char *text, size_t len, size_t runs);
+
+#endif
@@ -0,0 +1,507 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cti.h"
+
+/**
+ * the binary format, every number is an unsigned LEB128 varint
+ * unless said otherwise. a file is
+ *   header   "CTX", a version byte, a kind byte (0 tokens, 1 ast)
+ *            and 3 zero bytes
+ *   records  one per token, or one per ast node in pre-order
+ *   strings  varint count then varint length and bytes of each,
+ *            string ids count up from 0 in this order
+ *   trailer  file offset of the strings then the number of
+ *            records, both 8 bytes little endian
+ * so a consumer that maps the file reads the trailer first.
+ *
+ * a token record is kind * 2 + 1 if it had an error, the offset
+ * from the previous token, the length, then by kind
+ *   ident, string  string id
+ *   int            base | 4 if big, then the value or for big ones
+ *                  the number of 32 bit limbs and each limb
+ *   char           the letter
+ *   key            the CtKey
+ *
+ * an ast record is 0 for an error followed by its CtErrorKind,
+ * offset and length, otherwise CtASTKind + 1, the offset, the
+ * length, then by kind
+ *   binary, unary, ternary  the CtKey, then 2, 1 or 3 children
+ *   literal                 a token kind and its payload as above
+ *   name                    string id
+ *   declarations            string id, 1 if there is a body,
+ *                           the item count, the items then the body
+ */
+
+#define VERSION 1
+
+/* bytes buffered before a write */
+#define FLUSH_AT 0x100000
+
+#define MAX_ERRS 0x100
+
+static const char *tokenKinds[] = {
+    "invalid", "end", "ident", "string", "int", "char", "key"
+};
+
+static const char *astKinds[] = {
+    "binary", "unary", "literal", "ternary", "name",
+    "def", "var", "alias", "struct", "union", "enum", "trait",
+    "param", "field", "case"
+};
+
+static const char *keySpellings[] = {
+#define KEY(id, str, flags) str,
+#define OP(id, str, prec, flags) str,
+#include "cthulhu/keys.h"
+    ""
+};
+
+typedef struct {
+    /* doesnt own */
+    CtLexer *lex;
+    CtLoc base;
+
+    /* owns */
+    CtBuffer out;
+    CtNames strings;
+
+    bool binary;
+    size_t written;
+    size_t records;
+    size_t errors;
+    uint32_t last;
+} Emit;
+
+static void flush(Emit *self) {
+    fwrite(ctAt(&self->out, 0), 1, ctOffset(&self->out), stdout);
+    self->written += ctOffset(&self->out);
+    ctRewind(&self->out, 0);
+}
+
+static void text(Emit *self, const char *str) {
+    ctAppend(&self->out, str, strlen(str));
+}
+
+static void varint(Emit *self, uint64_t value) {
+    while (value >= 0x80) {
+        ctPush(&self->out, (char)(value | 0x80));
+        value >>= 7;
+    }
+
+    ctPush(&self->out, (char)value);
+}
+
+static void fixed64(Emit *self, uint64_t value) {
+    int i;
+
+    for (i = 0; i < 8; i++)
+        ctPush(&self->out, (char)(value >> (i * 8)));
+}
+
+static void decimal(Emit *self, uint64_t value) {
+    char digits[24];
+    size_t len = 0;
+
+    do {
+        digits[len++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    while (len)
+        ctPush(&self->out, digits[--len]);
+}
+
+/* a json string, bytes past ascii are passed through as they are */
+static void quoted(Emit *self, const char *str, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    size_t i;
+
+    ctPush(&self->out, '"');
+
+    for (i = 0; i < len; i++) {
+        uint8_t c = str[i];
+
+        if (c == '"' || c == '\\') {
+            ctPush(&self->out, '\\');
+            ctPush(&self->out, (char)c);
+        } else if (c == '\n') {
+            text(self, "\\n");
+        } else if (c < 0x20 || c == 0x7F) {
+            text(self, "\\u00");
+            ctPush(&self->out, hex[c >> 4]);
+            ctPush(&self->out, hex[c & 0xF]);
+        } else {
+            ctPush(&self->out, (char)c);
+        }
+    }
+
+    ctPush(&self->out, '"');
+}
+
+/* a string id in binary, the string itself in json */
+static void string(Emit *self, const char *str, size_t len) {
+    if (self->binary)
+        varint(self, ctIntern(&self->strings, str, len));
+    else
+        quoted(self, str, len);
+}
+
+static void field(Emit *self, const char *name) {
+    ctPush(&self->out, ',');
+    ctPush(&self->out, '"');
+    text(self, name);
+    text(self, "\":");
+}
+
+/* offsets are bytes into the file */
+static void where(Emit *self, CtRange range) {
+    if (self->binary) {
+        varint(self, range.loc - self->base);
+    } else {
+        field(self, "offset");
+        decimal(self, range.loc - self->base);
+    }
+
+    if (self->binary) {
+        varint(self, range.len);
+    } else {
+        field(self, "len");
+        decimal(self, range.len);
+    }
+}
+
+static void value(Emit *self, CtToken tok) {
+    CtDigit digit = tok.data.digit;
+    CtNum num;
+    uint32_t i;
+
+    switch (tok.kind) {
+    case TK_IDENT:
+        if (!self->binary)
+            field(self, "text");
+        string(self, ctIdent(self->lex, tok.data.ident), tok.data.ident.len);
+        break;
+
+    case TK_STRING:
+        if (!self->binary)
+            field(self, "text");
+        string(self, ctString(self->lex, tok.data.str), tok.data.str.len);
+        break;
+
+    case TK_INT:
+        if (!self->binary) {
+            num.value = (CtInt)digit.num;
+            num.big = digit.big;
+
+            field(self, "value");
+            ctNumDecimal(num, &self->out);
+        } else if (!digit.big) {
+            varint(self, digit.enc);
+            varint(self, digit.num);
+        } else {
+            varint(self, digit.enc | 4);
+            varint(self, digit.big->len);
+            for (i = 0; i < digit.big->len; i++)
+                varint(self, digit.big->limbs[i]);
+        }
+        break;
+
+    case TK_CHAR:
+        if (!self->binary)
+            field(self, "value");
+        self->binary ? varint(self, (uint8_t)tok.data.letter) : decimal(self, (uint8_t)tok.data.letter);
+        break;
+
+    case TK_KEY:
+        if (self->binary) {
+            varint(self, tok.data.key);
+        } else {
+            field(self, "key");
+            quoted(self, keySpellings[tok.data.key], strlen(keySpellings[tok.data.key]));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void token(Emit *self, CtToken tok, bool error) {
+    self->records++;
+
+    if (self->binary) {
+        varint(self, tok.kind * 2 + error);
+        varint(self, tok.where.loc - self->base - self->last);
+        varint(self, tok.where.len);
+        self->last = tok.where.loc - self->base;
+    } else {
+        text(self, "{\"kind\":");
+        quoted(self, tokenKinds[tok.kind], strlen(tokenKinds[tok.kind]));
+        where(self, tok.where);
+
+        if (error)
+            text(self, ",\"error\":true");
+    }
+
+    value(self, tok);
+
+    if (!self->binary)
+        text(self, "}\n");
+}
+
+static void node(Emit *self, CtAST *ast);
+
+static void child(Emit *self, const char *name, CtAST *ast) {
+    if (!self->binary)
+        field(self, name);
+
+    node(self, ast);
+}
+
+static void node(Emit *self, CtAST *ast) {
+    size_t i;
+
+    self->records++;
+
+    if (self->binary) {
+        varint(self, ast->kind + 1);
+    } else {
+        text(self, "{\"kind\":");
+        quoted(self, astKinds[ast->kind], strlen(astKinds[ast->kind]));
+    }
+
+    where(self, ast->tok.where);
+
+    switch (ast->kind) {
+    case AK_BINARY: case AK_UNARY: case AK_TERNARY:
+        if (self->binary) {
+            varint(self, ast->tok.data.key);
+        } else {
+            field(self, "op");
+            quoted(self, keySpellings[ast->tok.data.key], strlen(keySpellings[ast->tok.data.key]));
+        }
+
+        if (ast->kind == AK_BINARY) {
+            child(self, "lhs", ast->data.binary.lhs);
+            child(self, "rhs", ast->data.binary.rhs);
+        } else if (ast->kind == AK_UNARY) {
+            child(self, "expr", ast->data.expr);
+        } else {
+            child(self, "cond", ast->data.ternary.cond);
+            child(self, "lhs", ast->data.ternary.lhs);
+            child(self, "rhs", ast->data.ternary.rhs);
+        }
+        break;
+
+    case AK_LITERAL:
+        if (self->binary)
+            varint(self, ast->tok.kind);
+        value(self, ast->tok);
+        break;
+
+    case AK_NAME:
+        if (!self->binary)
+            field(self, "name");
+        string(self, ctIdent(self->lex, ast->tok.data.ident), ast->tok.data.ident.len);
+        break;
+
+    default:
+        if (!self->binary)
+            field(self, "name");
+        string(self, ctIdent(self->lex, ast->tok.data.ident), ast->tok.data.ident.len);
+
+        if (self->binary) {
+            varint(self, ast->data.decl.body != NULL);
+            varint(self, ast->data.decl.len);
+        } else {
+            field(self, "items");
+            ctPush(&self->out, '[');
+        }
+
+        for (i = 0; i < ast->data.decl.len; i++) {
+            if (i && !self->binary)
+                ctPush(&self->out, ',');
+            node(self, ast->data.decl.items[i]);
+        }
+
+        if (!self->binary)
+            ctPush(&self->out, ']');
+
+        if (ast->data.decl.body)
+            child(self, "body", ast->data.decl.body);
+        break;
+    }
+
+    if (!self->binary)
+        ctPush(&self->out, '}');
+}
+
+static void errors(Emit *self, CtError *errs, size_t *len) {
+    size_t i;
+
+    for (i = 0; i < *len; i++) {
+        self->records++;
+        self->errors++;
+
+        if (self->binary) {
+            varint(self, 0);
+            varint(self, errs[i].kind);
+        } else {
+            text(self, "{\"kind\":\"error\",\"error\":");
+            quoted(self, ctiErrors[errs[i].kind], strlen(ctiErrors[errs[i].kind]));
+        }
+
+        where(self, errs[i].where);
+
+        if (!self->binary)
+            text(self, "}\n");
+    }
+
+    *len = 0;
+}
+
+static void emitTokens(Emit *self) {
+    CtToken tok;
+
+    do {
+        size_t reported = self->lex->reported;
+
+        tok = ctLex(self->lex);
+        self->errors += self->lex->reported != reported;
+        token(self, tok, self->lex->reported != reported);
+
+        /* only the flag is kept */
+        self->lex->err_idx = 0;
+
+        if (ctOffset(&self->out) >= FLUSH_AT)
+            flush(self);
+    } while (tok.kind != TK_END);
+}
+
+/* statements are parsed and written one at a time, nodes dont outlive them */
+static void emitTree(Emit *self) {
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x10000);
+    CtArenaMark mark = ctArenaMark(&nodes);
+    CtParser parser = ctParserAlloc(self->lex, &nodes.base, MAX_ERRS);
+
+    while (1) {
+        CtAST *ast = ctParse(&parser);
+        bool fail = self->lex->err_idx || parser.err_idx;
+
+        if (!ast && !fail)
+            break;
+
+        errors(self, self->lex->errs, &self->lex->err_idx);
+        errors(self, parser.errs, &parser.err_idx);
+
+        if (ast && !fail) {
+            node(self, ast);
+
+            if (!self->binary)
+                ctPush(&self->out, '\n');
+        }
+
+        ctArenaRewind(&nodes, mark);
+
+        if (ctOffset(&self->out) >= FLUSH_AT)
+            flush(self);
+    }
+
+    ctParserFree(&parser);
+    ctArenaFree(&nodes);
+}
+
+/* the interned strings then where to find them */
+static void finish(Emit *self) {
+    size_t table = self->written + ctOffset(&self->out);
+    size_t i;
+
+    varint(self, self->strings.len);
+
+    for (i = 0; i < self->strings.len; i++) {
+        CtNameEntry *entry = &self->strings.entries[i];
+
+        varint(self, entry->len);
+        ctAppend(&self->out, ctNameText(&self->strings, (CtName)i), entry->len);
+
+        if (ctOffset(&self->out) >= FLUSH_AT)
+            flush(self);
+    }
+
+    fixed64(self, table);
+    fixed64(self, self->records);
+}
+
+int ctiEmit(const char *path, bool ast, bool binary) {
+    CtLoader loader;
+    CtLoad load;
+    CtMemory memory;
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex;
+    Emit self;
+    int status = 0;
+
+    load.path = path;
+
+    if (!ctLoaderStart(&loader, ctSystem(), &load, 1, 1, 1)) {
+        fprintf(stderr, "cti: couldnt start loading %s\n", path);
+        ctSourcesFree(&sources);
+        return 1;
+    }
+
+    if (ctLoaderWait(&loader, 0)->error) {
+        fprintf(stderr, "cti: cant read %s: %s\n", path, strerror(load.error));
+        status = 1;
+    } else {
+        memory = ctMemory(load.data, load.size);
+        lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, path, &memory, ctMemoryNext), MAX_ERRS);
+
+        self.lex = &lex;
+        self.base = sources.files[lex.stream.file].base;
+        self.out = ctBufferAlloc(ctSystem(), FLUSH_AT + 0x1000);
+        self.strings = ctNamesAlloc(ctSystem());
+        self.binary = binary;
+        self.written = 0;
+        self.records = 0;
+        self.errors = 0;
+        self.last = 0;
+
+        if (binary) {
+            text(&self, "CTX");
+            ctPush(&self.out, VERSION);
+            ctPush(&self.out, ast);
+            ctAppend(&self.out, "\0\0\0", 3);
+        }
+
+        if (ast)
+            emitTree(&self);
+        else
+            emitTokens(&self);
+
+        if (binary)
+            finish(&self);
+
+        flush(&self);
+
+        if (fflush(stdout) != 0) {
+            fprintf(stderr, "cti: couldnt write output\n");
+            status = 1;
+        }
+
+        /* the output is still complete but the file wasnt */
+        if (self.errors)
+            status = 1;
+
+        ctNamesFree(&self.strings);
+        ctBufferFree(self.out);
+        ctLexerFree(&lex);
+    }
+
+    ctLoaderDone(&loader, &load);
+    ctLoaderJoin(&loader);
+    ctSourcesFree(&sources);
+
+    return status;
+}
@@ -0,0 +1,45 @@
+#include <stdlib.h>
+
+/* the library itself, built once for every cti source */
+#include "cthulhu/cthulhu.c"
+
+#include "cti.h"
+
+const char *ctiErrors[] = {
+    "no error",
+    "integer too large",
+    "invalid escape sequence",
+    "linebreak in string",
+    "invalid symbol",
+    "invalid utf8",
+    "end of file in string",
+    "missing closing '",
+    "unexpected keyword",
+    "missing closing brace",
+    "expected a name",
+    "undefined name",
+    "name already defined",
+    "division by zero",
+    "cant evaluate this",
+    "expression nested too deeply"
+};
+
+size_t ctiFormat(CtInt value, char *out) {
+    char digits[24];
+    uint64_t num = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t len = 0;
+    size_t i = 0;
+
+    do {
+        digits[len++] = (char)('0' + num % 10);
+        num /= 10;
+    } while (num);
+
+    if (value < 0)
+        out[i++] = '-';
+
+    while (len)
+        out[i++] = digits[--len];
+
+    return i;
+}
@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cti.h"
+
+/**
+ * cti reads statements from stdin and prints the value of every expression,
+ * cti --server [path] runs the compile server instead.
+ * cti --batch path evaluates a whole file on --jobs n threads, one per core
+ * by default, with no prompt and all output buffered.
+ * cti --emit-tokens path and --emit-ast path write what the front end
+ * makes of a file as json lines, or with --binary in a compact format.
+ * --memory prints how much memory each kind of structure and each phase
+ * used once stdin runs out, --limit bytes stops with an error instead of
+ * going past that much. both only apply to the repl.
+ * in the repl :time expr and :profile n expr time each phase of expr
+ */
+
+static const char *memKinds[] = {
+    "source",
+    "strings",
+    "tokens",
+    "ast",
+    "diagnostics",
+    "names",
+    "other"
+};
+
+static const char *phases[] = {
+    "setup",
+    "lex",
+    "parse",
+    "resolve",
+    "eval"
+};
+
+/* everything the repl allocates is accounted for here */
+static CtLedger ledger;
+
+static void printUsage(const char *name, CtMemUsage usage) {
+    fprintf(stderr, "  %-12s %12lu %12lu %12lu %10lu\n", name,
+        (unsigned long)usage.current, (unsigned long)usage.peak,
+        (unsigned long)usage.total, (unsigned long)usage.allocs
+    );
+}
+
+static void printMemory(void) {
+    size_t i;
+
+    fprintf(stderr, "  %-12s %12s %12s %12s %10s\n", "memory", "current", "peak", "total", "allocs");
+    for (i = 0; i < CT_MEM_TOTAL; i++)
+        printUsage(memKinds[i], ctLedgerUsage(&ledger, (CtMemKind)i));
+    printUsage("all", ctLedgerUsage(&ledger, CT_MEM_TOTAL));
+
+    fprintf(stderr, "  %-12s %12s %12s %12s %10s\n", "phase", "current", "peak", "total", "allocs");
+    for (i = 0; i < CT_PHASE_TOTAL; i++)
+        printUsage(phases[i], ledger.phases[i]);
+}
+
+static void outOfMemory(CtLedger *self, CtMemKind kind, size_t size) {
+    fprintf(stderr, "cti: %lu bytes of %s would go past the limit of %lu bytes\n",
+        (unsigned long)size, memKinds[kind], (unsigned long)self->limit
+    );
+
+    printMemory();
+    exit(1);
+}
+
+/* stdin as the lexer sees it, with commands taken out */
+typedef struct {
+    FILE *file;
+    bool line_start;
+} Input;
+
+/**
+ * :time expr runs expr once, :profile n expr runs it n times.
+ * either prints its value then how long each phase took and how
+ * much it allocated. expr can leave off the ; and only sees names
+ * it declares itself
+ */
+static void command(FILE *file) {
+    CtBuffer line = ctBufferAlloc(ctSystem(), 64);
+    const char *text;
+    char *end;
+    size_t len;
+    size_t runs = 1;
+    int c;
+
+    while ((c = getc(file)) != EOF && c != '\n')
+        ctPush(&line, (char)c);
+
+    while (ctOffset(&line) && strchr(" \t\r", *ctAt(&line, ctOffset(&line) - 1)))
+        ctRewind(&line, ctOffset(&line) - 1);
+
+    if (ctOffset(&line) && *ctAt(&line, ctOffset(&line) - 1) != ';')
+        ctPush(&line, ';');
+
+    ctPush(&line, '\0');
+    text = ctAt(&line, 0);
+
+    if (strncmp(text, "time ", 5) == 0) {
+        text += 5;
+    } else if (strncmp(text, "profile ", 8) == 0) {
+        runs = strtoul(text + 8, &end, 10);
+        text = end == text + 8 ? "" : end;
+    } else {
+        fprintf(stderr, "usage: :time expr or :profile n expr\n");
+        text = NULL;
+    }
+
+    len = text ? strlen(text) : 0;
+
+    if (text && len <= 1)
+        fprintf(stderr, "usage: :time expr or :profile n expr\n");
+    else if (text)
+        ctiProfile(text, len, runs);
+
+    ctBufferFree(line);
+}
+
+/* a : and a letter at the start of a line is a command */
+static bool isCommand(FILE *file) {
+    int c = getc(file);
+
+    ungetc(c, file);
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/* the lexer sees an empty line in place of a command so lines still add up */
+static char nextChar(void *ptr) {
+    Input *self = ptr;
+    int c = getc(self->file);
+
+    if (c == ':' && self->line_start && isCommand(self->file)) {
+        command(self->file);
+        c = '\n';
+    }
+
+    self->line_start = c == '\n';
+    return c == EOF ? '\0' : (char)c;
+}
+
+static void printNum(CtNum value, CtBuffer *text) {
+    ctRewind(text, 0);
+    ctNumDecimal(value, text);
+    ctPush(text, '\n');
+
+    fwrite(ctAt(text, 0), 1, ctOffset(text), stdout);
+}
+
+static void printErrors(CtSources *sources, CtError *errs, size_t *len) {
+    size_t i;
+
+    for (i = 0; i < *len; i++) {
+        CtPosition pos = ctDecode(sources, errs[i].where.loc);
+        fprintf(stderr, "%s:%lu:%lu: %s\n", pos.name,
+            (unsigned long)pos.line + 1, (unsigned long)pos.col + 1,
+            ctiErrors[errs[i].kind]
+        );
+    }
+
+    *len = 0;
+}
+
+static int repl(bool memory, Input *input) {
+    CtSources sources = ctSourcesAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE));
+    CtArena nodes = ctArenaAlloc(ctLedgerTag(&ledger, CT_MEM_AST), 0x10000);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE), &sources, "<stdin>", input, nextChar), 16);
+    CtParser parser = ctParserAlloc(&lex, &nodes.base, 16);
+    CtResolver resolver = ctResolverAlloc(&lex, ctLedgerTag(&ledger, CT_MEM_NAMES), 16);
+    CtArenaMark mark = ctArenaMark(&nodes);
+    CtBuffer text = ctBufferAlloc(ctLedgerTag(&ledger, CT_MEM_OTHER), 64);
+    int status = 0;
+
+    while (1) {
+        CtAST *node;
+        CtNum value;
+        CtError err;
+        size_t one = 1;
+        bool fail;
+
+        /* the lexer runs on demand so lexing counts towards parsing */
+        ctLedgerPhase(&ledger, CT_PHASE_PARSE);
+        node = ctParse(&parser);
+        fail = lex.err_idx || parser.err_idx;
+
+        if (!node && !fail)
+            break;
+
+        printErrors(&sources, lex.errs, &lex.err_idx);
+        printErrors(&sources, parser.errs, &parser.err_idx);
+
+        if (!fail) {
+            ctLedgerPhase(&ledger, CT_PHASE_RESOLVE);
+            ctResolve(&resolver, &node, 1);
+            fail = resolver.err_idx != 0;
+            printErrors(&sources, resolver.errs, &resolver.err_idx);
+        }
+
+        /* declarations dont have a value */
+        if (!fail && !(node->kind >= AK_DEF && node->kind <= AK_TRAIT)) {
+            ctLedgerPhase(&ledger, CT_PHASE_EVAL);
+
+            /* big values live with the nodes until the rewind */
+            if (ctEvalNum(node, &nodes.base, &value, &err)) {
+                printNum(value, &text);
+            } else {
+                fail = true;
+                printErrors(&sources, &err, &one);
+            }
+        }
+
+        if (fail)
+            status = 1;
+
+        ctArenaRewind(&nodes, mark);
+    }
+
+    printErrors(&sources, lex.errs, &lex.err_idx);
+    printErrors(&sources, parser.errs, &parser.err_idx);
+
+    if (memory)
+        printMemory();
+
+    ctBufferFree(text);
+    ctResolverFree(&resolver);
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+
+    return status;
+}
+
+int main(int argc, char **argv) {
+    const char *batch = NULL;
+    const char *emit = NULL;
+    bool ast = false;
+    bool binary = false;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    bool memory = false;
+    Input input;
+    int i;
+
+    ctLedgerAlloc(&ledger, ctSystem());
+    ledger.over = outOfMemory;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--server") == 0) {
+            return ctiServe(i + 1 < argc ? argv[i + 1] : "cti.sock");
+        } else if (strcmp(argv[i], "--memory") == 0) {
+            memory = true;
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            ledger.limit = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch = argv[++i];
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobs = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--emit-tokens") == 0 && i + 1 < argc) {
+            emit = argv[++i];
+            ast = false;
+        } else if (strcmp(argv[i], "--emit-ast") == 0 && i + 1 < argc) {
+            emit = argv[++i];
+            ast = true;
+        } else if (strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        } else {
+            fprintf(stderr, "usage: cti [--memory] [--limit bytes] [--batch path [--jobs n]] [--emit-tokens|--emit-ast path [--binary]] [--server [path]]\n");
+            return 2;
+        }
+    }
+
+    if (emit)
+        return ctiEmit(emit, ast, binary);
+
+    if (batch)
+        return ctiBatch(batch, jobs > 0 ? (size_t)jobs : 1);
+
+    input.file = stdin;
+    input.line_start = true;
+
+    return repl(memory, &input);
+}
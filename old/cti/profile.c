@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cti.h"
+
+/* runs one :profile can ask for */
+#define MAX_RUNS 10000000
+
+static const char *phases[] = {
+    "setup",
+    "lex",
+    "parse",
+    "resolve",
+    "eval"
+};
+
+/* what one run of every phase cost, memory is the same every run */
+typedef struct {
+    uint64_t *times[CT_PHASE_TOTAL];
+    CtMemUsage usage[CT_PHASE_TOTAL];
+
+    size_t tokens;
+    size_t nodes;
+} Profile;
+
+static uint64_t now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static size_t countNodes(CtAST *node) {
+    size_t out = 1;
+    size_t i;
+
+    if (!node)
+        return 0;
+
+    switch (node->kind) {
+    case AK_BINARY:
+        return out + countNodes(node->data.binary.lhs) + countNodes(node->data.binary.rhs);
+    case AK_UNARY:
+        return out + countNodes(node->data.expr);
+    case AK_TERNARY:
+        return out + countNodes(node->data.ternary.cond) + countNodes(node->data.ternary.lhs) + countNodes(node->data.ternary.rhs);
+    case AK_LITERAL: case AK_NAME:
+        return out;
+    default:
+        for (i = 0; i < node->data.decl.len; i++)
+            out += countNodes(node->data.decl.items[i]);
+        return out + countNodes(node->data.decl.body);
+    }
+}
+
+static bool printErrors(CtSources *sources, CtError *errs, size_t len) {
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        CtPosition pos = ctDecode(sources, errs[i].where.loc);
+        fprintf(stderr, "%s:%lu:%lu: %s\n", pos.name,
+            (unsigned long)pos.line + 1, (unsigned long)pos.col + 1,
+            ctiErrors[errs[i].kind]
+        );
+    }
+
+    return len != 0;
+}
+
+/**
+ * lex, parse, resolve and evaluate text from scratch as run number
+ * idx, each phase is timed on its own and its memory goes to its own
+ * phase of a fresh ledger. errors are only printed for the first run
+ * since every other one would give the same
+ */
+static bool runOnce(const char *text, size_t len, Profile *profile, size_t idx) {
+    CtLedger ledger;
+    CtMemory memory = ctMemory(text, len);
+    CtSources sources;
+    CtArena nodes;
+    CtLexer lex;
+    CtParser parser;
+    CtResolver resolver;
+    CtToken *tokens;
+    size_t count;
+    CtAST *node;
+    CtNum value;
+    CtError err;
+    bool ok = true;
+    uint64_t start = now();
+    uint64_t end;
+    size_t i;
+
+    ctLedgerAlloc(&ledger, ctSystem());
+
+    sources = ctSourcesAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE));
+    nodes = ctArenaAlloc(ctLedgerTag(&ledger, CT_MEM_AST), 0x1000);
+    lex = ctLexerAlloc(ctStreamAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE), &sources, "<profile>", &memory, ctMemoryNext), 16);
+    parser = ctParserAlloc(&lex, &nodes.base, 16);
+    resolver = ctResolverAlloc(&lex, ctLedgerTag(&ledger, CT_MEM_NAMES), 16);
+
+    end = now();
+    profile->times[CT_PHASE_SETUP][idx] = end - start;
+
+    ctLedgerPhase(&ledger, CT_PHASE_LEX);
+    start = end;
+    tokens = ctLexAll(&lex, &count);
+    end = now();
+    profile->times[CT_PHASE_LEX][idx] = end - start;
+
+    parser.tokens = tokens;
+    parser.token_len = count;
+
+    ctLedgerPhase(&ledger, CT_PHASE_PARSE);
+    start = end;
+    node = ctParse(&parser);
+    end = now();
+    profile->times[CT_PHASE_PARSE][idx] = end - start;
+
+    if (idx == 0) {
+        profile->tokens = count;
+        profile->nodes = countNodes(node);
+
+        ok = !printErrors(&sources, lex.errs, lex.err_idx) && ok;
+        ok = !printErrors(&sources, parser.errs, parser.err_idx) && ok;
+
+        if (ok && !node) {
+            fprintf(stderr, "cti: nothing to profile\n");
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        ctLedgerPhase(&ledger, CT_PHASE_RESOLVE);
+        start = now();
+        ctResolve(&resolver, &node, 1);
+        end = now();
+        profile->times[CT_PHASE_RESOLVE][idx] = end - start;
+
+        if (idx == 0)
+            ok = !printErrors(&sources, resolver.errs, resolver.err_idx);
+    }
+
+    /* declarations dont have a value, their eval costs nothing */
+    profile->times[CT_PHASE_EVAL][idx] = 0;
+
+    if (ok && !(node->kind >= AK_DEF && node->kind <= AK_TRAIT)) {
+        ctLedgerPhase(&ledger, CT_PHASE_EVAL);
+        start = now();
+        ok = ctEvalNum(node, &nodes.base, &value, &err);
+        end = now();
+        profile->times[CT_PHASE_EVAL][idx] = end - start;
+
+        if (idx == 0 && !ok) {
+            printErrors(&sources, &err, 1);
+        } else if (idx == 0) {
+            CtBuffer out = ctBufferAlloc(ctSystem(), 64);
+
+            ctNumDecimal(value, &out);
+            ctPush(&out, '\n');
+            fwrite(ctAt(&out, 0), 1, ctOffset(&out), stdout);
+            fflush(stdout);
+
+            ctBufferFree(out);
+        }
+    }
+
+    for (i = 0; i < CT_PHASE_TOTAL; i++)
+        profile->usage[i] = ledger.phases[i];
+
+    ctRelease(ctLedgerTag(&ledger, CT_MEM_TOKENS), tokens, sizeof(CtToken) * count);
+    ctResolverFree(&resolver);
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+
+    return ok;
+}
+
+static int byTime(const void *lhs, const void *rhs) {
+    uint64_t a = *(const uint64_t*)lhs;
+    uint64_t b = *(const uint64_t*)rhs;
+
+    return a < b ? -1 : a > b;
+}
+
+/* nearest rank, times must be sorted */
+static unsigned long percentile(const uint64_t *times, size_t len, size_t pct) {
+    size_t rank = (len * pct + 99) / 100;
+
+    return (unsigned long)times[rank ? rank - 1 : 0];
+}
+
+static void printProfile(Profile *profile, size_t runs) {
+    size_t i;
+
+    fprintf(stderr, "  %lu runs, %lu tokens, %lu nodes\n",
+        (unsigned long)runs, (unsigned long)profile->tokens, (unsigned long)profile->nodes
+    );
+
+    fprintf(stderr, "  %-8s %10s %10s %10s %10s %10s %8s\n", "ns", "p50", "p90", "p99", "max", "bytes", "allocs");
+
+    for (i = 0; i < CT_PHASE_TOTAL; i++) {
+        uint64_t *times = profile->times[i];
+
+        qsort(times, runs, sizeof(uint64_t), byTime);
+
+        fprintf(stderr, "  %-8s %10lu %10lu %10lu %10lu %10lu %8lu\n", phases[i],
+            percentile(times, runs, 50), percentile(times, runs, 90),
+            percentile(times, runs, 99), (unsigned long)times[runs - 1],
+            (unsigned long)profile->usage[i].total, (unsigned long)profile->usage[i].allocs
+        );
+    }
+}
+
+void ctiProfile(const char *text, size_t len, size_t runs) {
+    Profile profile;
+    size_t i;
+
+    if (runs == 0 || runs > MAX_RUNS) {
+        fprintf(stderr, "cti: runs must be between 1 and %lu\n", (unsigned long)MAX_RUNS);
+        return;
+    }
+
+    for (i = 0; i < CT_PHASE_TOTAL; i++)
+        profile.times[i] = ctAlloc(ctSystem(), sizeof(uint64_t) * runs);
+
+    /* a broken expression is reported once and never timed */
+    if (runOnce(text, len, &profile, 0)) {
+        for (i = 1; i < runs; i++)
+            runOnce(text, len, &profile, i);
+
+        printProfile(&profile, runs);
+    }
+
+    for (i = 0; i < CT_PHASE_TOTAL; i++)
+        ctRelease(ctSystem(), profile.times[i], sizeof(uint64_t) * runs);
+}
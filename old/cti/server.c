@@ -0,0 +1,674 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "cti.h"
+
+#define MAX_CLIENTS 256
+#define MAX_ERRS 16
+
+/* distinct expressions cached before the whole eval cache is dropped */
+#define MAX_EVALS 0x10000
+
+/* a client isnt read from while this much of its replies is unsent */
+#define MAX_BACKLOG 0x10000
+
+/* how long replies still get to drain once the server is stopping, in ms */
+#define STOP_WAIT 1000
+
+/* a parsed and resolved piece of source that outlives the request it came from */
+typedef struct {
+    char *name;
+    CtMemory memory;
+    CtSources sources;
+    CtArena nodes;
+    CtLexer lex;
+    CtParser parser;
+    CtBuffer decls;
+
+    size_t errors;
+    CtError first;
+} Unit;
+
+/* an eval has no inputs so its whole reply is cached, the unit isnt kept */
+typedef struct {
+    bool filled;
+    CtBuffer reply;
+} Eval;
+
+typedef struct {
+    Unit *unit;
+    struct timespec mtime;
+    off_t size;
+    uint32_t hash;
+
+    /* when the file was last read, in seconds */
+    time_t stamp;
+} Module;
+
+typedef struct {
+    /* owns */
+    CtBuffer input;
+    CtBuffer output;
+
+    /* the client wont send anything else */
+    bool eof;
+} Client;
+
+typedef struct {
+    /* shared by every unit so names stay interned across requests */
+    CtResolver resolver;
+
+    /* request text and paths to their cache slot */
+    CtNames exprs;
+    Eval *evals;
+    size_t eval_size;
+
+    CtNames paths;
+    Module *modules;
+    size_t module_size;
+
+    size_t hits;
+    size_t misses;
+
+    /* slot 0 is the listener */
+    struct pollfd fds[MAX_CLIENTS + 1];
+    Client clients[MAX_CLIENTS + 1];
+    size_t len;
+
+    bool running;
+} Server;
+
+static uint32_t hashBytes(const char *text, size_t len) {
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+
+    return hash;
+}
+
+/* grow a cache so slot `need` exists, new slots are zeroed */
+static void *growCache(void *ptr, size_t *size, size_t need, size_t item) {
+    size_t next = *size ? *size : 16;
+
+    if (need < *size)
+        return ptr;
+
+    while (next <= need)
+        next *= 2;
+
+    ptr = ctResize(ctSystem(), ptr, *size * item, next * item);
+    memset((char*)ptr + *size * item, 0, (next - *size) * item);
+    *size = next;
+
+    return ptr;
+}
+
+static void unitError(Unit *self, CtError *errs, size_t *len) {
+    if (*len && !self->errors)
+        self->first = errs[0];
+
+    self->errors += *len;
+    *len = 0;
+}
+
+/* the text only has to live until this returns */
+static Unit *unitOpen(Server *server, const char *name, const char *text, size_t len) {
+    Unit *self = ctAlloc(ctSystem(), sizeof(Unit));
+    CtResolver *resolver = &server->resolver;
+    CtAST *node;
+
+    /* the sources keep a pointer to the name */
+    self->name = ctAlloc(ctSystem(), strlen(name) + 1);
+    strcpy(self->name, name);
+
+    self->memory = ctMemory(text, len);
+    self->sources = ctSourcesAlloc(ctSystem());
+    self->nodes = ctArenaAlloc(ctSystem(), 0x1000);
+    self->lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &self->sources, self->name, &self->memory, ctMemoryNext), MAX_ERRS);
+    self->parser = ctParserAlloc(&self->lex, &self->nodes.base, MAX_ERRS);
+    self->decls = ctBufferAlloc(ctSystem(), 0);
+    self->errors = 0;
+
+    while ((node = ctParse(&self->parser)) || self->parser.err_idx) {
+        unitError(self, self->lex.errs, &self->lex.err_idx);
+        unitError(self, self->parser.errs, &self->parser.err_idx);
+
+        if (node)
+            ctAppend(&self->decls, (const char*)&node, sizeof(CtAST*));
+    }
+
+    unitError(self, self->lex.errs, &self->lex.err_idx);
+
+    if (!self->errors) {
+        resolver->lex = &self->lex;
+        ctResolve(resolver, (CtAST**)ctAt(&self->decls, 0), self->decls.len / sizeof(CtAST*));
+        unitError(self, resolver->errs, &resolver->err_idx);
+    }
+
+    /* the source is retained by the lexer, the callers text isnt needed anymore */
+    self->memory = ctMemory(NULL, 0);
+
+    return self;
+}
+
+static void unitClose(Unit *self) {
+    ctBufferFree(self->decls);
+    ctParserFree(&self->parser);
+    ctLexerFree(&self->lex);
+    ctArenaFree(&self->nodes);
+    ctSourcesFree(&self->sources);
+    ctRelease(ctSystem(), self->name, strlen(self->name) + 1);
+    ctRelease(ctSystem(), self, sizeof(Unit));
+}
+
+static size_t unitCount(Unit *self) {
+    return self->decls.len / sizeof(CtAST*);
+}
+
+static CtAST *unitDecl(Unit *self, size_t idx) {
+    return ((CtAST**)ctAt(&self->decls, 0))[idx];
+}
+
+static void reply(CtBuffer *out, const char *text) {
+    ctAppend(out, text, strlen(text));
+}
+
+static void replyError(CtBuffer *out, CtSources *sources, CtError *err) {
+    CtPosition pos = ctDecode(sources, err->where.loc);
+    char line[64];
+
+    reply(out, "error ");
+    reply(out, pos.name);
+    sprintf(line, ":%lu:%lu: ", (unsigned long)pos.line + 1, (unsigned long)pos.col + 1);
+    reply(out, line);
+    reply(out, ctiErrors[err->kind]);
+}
+
+static void replyInt(CtBuffer *out, CtInt value) {
+    char text[24];
+    ctAppend(out, text, ctiFormat(value, text));
+}
+
+/* exactly like the repl, nothing wraps */
+static void replyValue(CtBuffer *out, Unit *unit) {
+    CtAST *node = unitCount(unit) ? unitDecl(unit, 0) : NULL;
+    CtArena bigs;
+    CtNum value;
+    CtError err;
+
+    if (unit->errors) {
+        replyError(out, &unit->sources, &unit->first);
+        return;
+    }
+
+    /* declarations dont have a value */
+    if (unitCount(unit) != 1 || (node->kind >= AK_DEF && node->kind <= AK_TRAIT)) {
+        reply(out, "error expected one expression");
+        return;
+    }
+
+    bigs = ctArenaAlloc(ctSystem(), 0x1000);
+
+    if (ctEvalNum(node, &bigs.base, &value, &err)) {
+        reply(out, "ok ");
+        ctNumDecimal(value, out);
+    } else {
+        replyError(out, &unit->sources, &err);
+    }
+
+    ctArenaFree(&bigs);
+}
+
+static void evalsFree(Server *self) {
+    size_t i;
+
+    for (i = 0; i < self->eval_size; i++)
+        if (self->evals[i].filled)
+            ctBufferFree(self->evals[i].reply);
+
+    if (self->evals)
+        ctRelease(ctSystem(), self->evals, sizeof(Eval) * self->eval_size);
+
+    ctNamesFree(&self->exprs);
+}
+
+static void eval(Server *self, const char *text, size_t len, CtBuffer *out) {
+    CtName id;
+    Eval *entry;
+
+    /* there is no eviction, a full cache just starts over */
+    if (self->exprs.len >= MAX_EVALS) {
+        evalsFree(self);
+
+        self->exprs = ctNamesAlloc(ctSystem());
+        self->evals = NULL;
+        self->eval_size = 0;
+    }
+
+    id = ctIntern(&self->exprs, text, len);
+    self->evals = growCache(self->evals, &self->eval_size, id, sizeof(Eval));
+    entry = self->evals + id;
+
+    if (entry->filled) {
+        self->hits++;
+    } else {
+        size_t end = len;
+        char *source = ctAlloc(ctSystem(), len + 1);
+        Unit *unit;
+
+        while (end && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r'))
+            end--;
+
+        /* parse a copy with its terminator unless it already has one */
+        memcpy(source, text, len);
+        source[len] = ';';
+
+        unit = unitOpen(self, "eval", source, end && text[end - 1] == ';' ? len : len + 1);
+        ctRelease(ctSystem(), source, len + 1);
+
+        entry->reply = ctBufferAlloc(ctSystem(), 0);
+        entry->filled = true;
+        replyValue(&entry->reply, unit);
+        unitClose(unit);
+
+        self->misses++;
+    }
+
+    ctAppend(out, ctAt(&entry->reply, 0), ctOffset(&entry->reply));
+}
+
+/* read a whole file, NULL if it cant be read */
+static char *readFile(const char *path, size_t size) {
+    FILE *file = fopen(path, "rb");
+    char *text;
+
+    if (!file)
+        return NULL;
+
+    text = ctAlloc(ctSystem(), size ? size : 1);
+
+    if (fread(text, 1, size, file) != size) {
+        ctRelease(ctSystem(), text, size ? size : 1);
+        text = NULL;
+    }
+
+    fclose(file);
+    return text;
+}
+
+static void check(Server *self, const char *path, size_t len, CtBuffer *out) {
+    char name[1024];
+    struct stat st;
+    Module *module;
+    CtName id;
+    char *text;
+    uint32_t hash;
+    time_t now;
+
+    if (len >= sizeof(name)) {
+        reply(out, "error path too long");
+        return;
+    }
+
+    memcpy(name, path, len);
+    name[len] = '\0';
+
+    if (stat(name, &st) != 0) {
+        reply(out, "error ");
+        reply(out, strerror(errno));
+        return;
+    }
+
+    now = time(NULL);
+    id = ctIntern(&self->paths, name, len);
+    self->modules = growCache(self->modules, &self->module_size, id, sizeof(Module));
+    module = self->modules + id;
+
+    /**
+     * an unchanged mtime and size is trusted without reading anything,
+     * but only once the file was last modified before the second it
+     * was read in. a write in the same tick can leave the mtime as it
+     * was on filesystems with coarse timestamps, so those are hashed
+     */
+    if (module->unit && module->mtime.tv_sec == st.st_mtim.tv_sec && module->mtime.tv_nsec == st.st_mtim.tv_nsec
+        && module->size == st.st_size && module->mtime.tv_sec < module->stamp) {
+        self->hits++;
+    } else if (!(text = readFile(name, (size_t)st.st_size))) {
+        reply(out, "error ");
+        reply(out, strerror(errno));
+        return;
+    } else {
+        hash = hashBytes(text, (size_t)st.st_size);
+
+        /* touched but not changed */
+        if (module->unit && module->size == st.st_size && module->hash == hash) {
+            self->hits++;
+        } else {
+            if (module->unit)
+                unitClose(module->unit);
+
+            module->unit = unitOpen(self, name, text, (size_t)st.st_size);
+            module->hash = hash;
+            self->misses++;
+        }
+
+        module->mtime = st.st_mtim;
+        module->size = st.st_size;
+        module->stamp = now;
+        ctRelease(ctSystem(), text, st.st_size ? (size_t)st.st_size : 1);
+    }
+
+    if (module->unit->errors) {
+        replyError(out, &module->unit->sources, &module->unit->first);
+    } else {
+        reply(out, "ok ");
+        replyInt(out, (CtInt)unitCount(module->unit));
+    }
+}
+
+static void stats(Server *self, CtBuffer *out) {
+    char text[128];
+
+    sprintf(text, "ok exprs %lu modules %lu hits %lu misses %lu",
+        (unsigned long)self->exprs.len, (unsigned long)self->paths.len,
+        (unsigned long)self->hits, (unsigned long)self->misses
+    );
+
+    reply(out, text);
+}
+
+static bool isCommand(const char *line, size_t len, const char *name, size_t *arg) {
+    size_t size = strlen(name);
+
+    if (len < size || memcmp(line, name, size) != 0 || (len > size && line[size] != ' '))
+        return false;
+
+    *arg = len > size ? size + 1 : size;
+    return true;
+}
+
+static void handle(Server *self, const char *line, size_t len, CtBuffer *out) {
+    size_t arg;
+
+    if (isCommand(line, len, "eval", &arg))
+        eval(self, line + arg, len - arg, out);
+    else if (isCommand(line, len, "check", &arg))
+        check(self, line + arg, len - arg, out);
+    else if (isCommand(line, len, "stats", &arg))
+        stats(self, out);
+    else if (isCommand(line, len, "stop", &arg)) {
+        self->running = false;
+        reply(out, "ok");
+    } else
+        reply(out, "error unknown request");
+
+    ctPush(out, '\n');
+}
+
+/* drop the first len bytes of a buffer */
+static void consume(CtBuffer *buffer, size_t len) {
+    size_t rest = buffer->len - len;
+
+    memmove((char*)ctAt(buffer, 0), ctAt(buffer, len), rest);
+    ctRewind(buffer, rest);
+}
+
+static void dropClient(Server *self, size_t idx) {
+    close(self->fds[idx].fd);
+    ctBufferFree(self->clients[idx].input);
+    ctBufferFree(self->clients[idx].output);
+
+    self->len -= 1;
+    self->fds[idx] = self->fds[self->len];
+    self->clients[idx] = self->clients[self->len];
+}
+
+/* handle every complete line a client has sent, false if it went away */
+static bool readClient(Server *self, size_t idx) {
+    Client *client = self->clients + idx;
+    size_t start = 0;
+    size_t i;
+    char data[4096];
+    ssize_t n = read(self->fds[idx].fd, data, sizeof(data));
+
+    if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+        return true;
+
+    if (n < 0)
+        return false;
+
+    /* it only closed its end, whats left still gets answered */
+    if (n == 0) {
+        client->eof = true;
+        return true;
+    }
+
+    ctAppend(&client->input, data, n);
+
+    for (i = 0; i < client->input.len; i++) {
+        if (*ctAt(&client->input, i) != '\n')
+            continue;
+
+        handle(self, ctAt(&client->input, start), i - start, &client->output);
+        start = i + 1;
+    }
+
+    /* keep a partial line around for the next read */
+    if (start)
+        consume(&client->input, start);
+
+    return true;
+}
+
+/* write as much of the replies as the socket takes, false if the client went away */
+static bool flushClient(Server *self, size_t idx) {
+    Client *client = self->clients + idx;
+    size_t sent = 0;
+
+    while (sent < client->output.len) {
+        ssize_t n = write(self->fds[idx].fd, ctAt(&client->output, sent), client->output.len - sent);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+
+        if (n <= 0)
+            return false;
+
+        sent += n;
+    }
+
+    if (sent)
+        consume(&client->output, sent);
+
+    return true;
+}
+
+/**
+ * a client is only read from while its replies keep up, otherwise
+ * one that sends everything before reading anything would have the
+ * server blocked on it and every other client stalled with them
+ */
+static void watch(Server *self, size_t idx) {
+    Client *client = self->clients + idx;
+    short events = 0;
+
+    if (self->running && !client->eof && client->output.len < MAX_BACKLOG)
+        events |= POLLIN;
+
+    if (client->output.len)
+        events |= POLLOUT;
+
+    self->fds[idx].events = events;
+}
+
+/* false once the client is done or gone */
+static bool serveClient(Server *self, size_t idx) {
+    short revents = self->fds[idx].revents;
+
+    if (revents & POLLNVAL)
+        return false;
+
+    if ((self->fds[idx].events & POLLIN) && (revents & (POLLIN | POLLHUP | POLLERR)) && !readClient(self, idx))
+        return false;
+
+    if (!flushClient(self, idx))
+        return false;
+
+    /* a hangup with nothing to read or write wont go away on its own */
+    if ((revents & (POLLHUP | POLLERR)) && !(self->fds[idx].events & POLLIN) && self->clients[idx].output.len == 0)
+        return false;
+
+    if (self->clients[idx].eof && self->clients[idx].output.len == 0)
+        return false;
+
+    watch(self, idx);
+    return true;
+}
+
+static bool backedUp(Server *self) {
+    size_t i;
+
+    for (i = 1; i < self->len; i++)
+        if (self->clients[i].output.len)
+            return true;
+
+    return false;
+}
+
+static void serverFree(Server *self) {
+    size_t i;
+
+    evalsFree(self);
+
+    for (i = 0; i < self->module_size; i++)
+        if (self->modules[i].unit)
+            unitClose(self->modules[i].unit);
+
+    if (self->modules)
+        ctRelease(ctSystem(), self->modules, sizeof(Module) * self->module_size);
+
+    ctNamesFree(&self->paths);
+    ctResolverFree(&self->resolver);
+}
+
+int ctiServe(const char *path) {
+    static Server self;
+    struct sockaddr_un addr;
+    struct stat st;
+    bool stale;
+    int listener;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "cti: cant serve on %s\n", path);
+        return 1;
+    }
+
+    /* only a stale socket is replaced, anything else at the path is kept */
+    stale = lstat(path, &st) == 0;
+
+    if (stale && !S_ISSOCK(st.st_mode)) {
+        fprintf(stderr, "cti: %s: exists and isnt a socket\n", path);
+        return 1;
+    }
+
+    if ((listener = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        fprintf(stderr, "cti: cant serve on %s\n", path);
+        return 1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    if (stale)
+        unlink(path);
+
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 64) != 0) {
+        fprintf(stderr, "cti: %s: %s\n", path, strerror(errno));
+        close(listener);
+        return 1;
+    }
+
+    /* a client hanging up early shouldnt take the server with it */
+    signal(SIGPIPE, SIG_IGN);
+
+    self.resolver = ctResolverAlloc(NULL, ctSystem(), MAX_ERRS);
+    self.exprs = ctNamesAlloc(ctSystem());
+    self.paths = ctNamesAlloc(ctSystem());
+
+    self.fds[0].fd = listener;
+    self.fds[0].events = POLLIN;
+    self.len = 1;
+    self.running = true;
+
+    /* once stopped nothing new is read, but replies already made still go out */
+    while (self.running || backedUp(&self)) {
+        size_t i;
+        int ready;
+
+        self.fds[0].events = self.running ? POLLIN : 0;
+
+        if ((ready = poll(self.fds, self.len, self.running ? -1 : STOP_WAIT)) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        /* whoever is left isnt reading */
+        if (ready == 0)
+            break;
+
+        for (i = self.len; i-- > 1;) {
+            if (self.fds[i].revents && !serveClient(&self, i))
+                dropClient(&self, i);
+        }
+
+        if (self.running && (self.fds[0].revents & POLLIN)) {
+            int client = accept(listener, NULL, NULL);
+
+            if (client >= 0 && self.len > MAX_CLIENTS) {
+                close(client);
+            } else if (client >= 0) {
+                fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+
+                self.fds[self.len].fd = client;
+                self.fds[self.len].events = POLLIN;
+                self.fds[self.len].revents = 0;
+                self.clients[self.len].input = ctBufferAlloc(ctSystem(), 0);
+                self.clients[self.len].output = ctBufferAlloc(ctSystem(), 0);
+                self.clients[self.len].eof = false;
+                self.len += 1;
+            }
+        }
+
+        /* a stop stops reading from everyone, not just whoever sent it */
+        if (!self.running) {
+            for (i = 1; i < self.len; i++)
+                watch(&self, i);
+        }
+    }
+
+    while (self.len > 1)
+        dropClient(&self, self.len - 1);
+
+    close(listener);
+    unlink(path);
+
+    serverFree(&self);
+    return 0;
+}
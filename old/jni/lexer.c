@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <jni.h>
+
+#include "cthulhu/cthulhu.c"
+
+/**
+ * native half of com.cthulhu.NativeLexer, the java side hands over
+ * a direct buffer of utf8 source and gets CtPacked records back
+ * in batches so crossing the boundary costs one call per batch
+ */
+
+typedef struct {
+    CtMemory memory;
+    CtSources sources;
+    CtLexer lex;
+    bool done;
+} Handle;
+
+static const char *spellings[] = {
+#define KEY(id, str, flags) str,
+#define OP(id, str, prec, flags) str,
+#include "cthulhu/keys.h"
+    ""
+};
+
+JNIEXPORT jint JNICALL Java_com_cthulhu_NativeLexer_record(JNIEnv *env, jclass cls) {
+    CT_UNUSED(env);
+    CT_UNUSED(cls);
+
+    return (jint)sizeof(CtPacked);
+}
+
+/* spellings in CtKey order so the java side can map key ids */
+JNIEXPORT jobjectArray JNICALL Java_com_cthulhu_NativeLexer_keys(JNIEnv *env, jclass cls) {
+    jsize len = (jsize)(sizeof(spellings) / sizeof(const char*));
+    jobjectArray out = (*env)->NewObjectArray(env, len, (*env)->FindClass(env, "java/lang/String"), NULL);
+    jsize i;
+
+    CT_UNUSED(cls);
+
+    for (i = 0; out && i < len; i++)
+        (*env)->SetObjectArrayElement(env, out, i, (*env)->NewStringUTF(env, spellings[i]));
+
+    return out;
+}
+
+/* the source buffer must stay reachable until close */
+JNIEXPORT jlong JNICALL Java_com_cthulhu_NativeLexer_open(JNIEnv *env, jclass cls, jobject source, jint len) {
+    const char *text = (*env)->GetDirectBufferAddress(env, source);
+    Handle *self;
+
+    CT_UNUSED(cls);
+
+    if (!text || len < 0 || (jlong)len > (*env)->GetDirectBufferCapacity(env, source))
+        return 0;
+
+    if (!(self = malloc(sizeof(Handle))))
+        return 0;
+
+    self->memory = ctMemory(text, (size_t)len);
+    self->sources = ctSourcesAlloc(ctSystem());
+    self->lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &self->sources, "<java>", &self->memory, ctMemoryNext), 1);
+    self->done = false;
+
+    return (jlong)(intptr_t)self;
+}
+
+/* fill out with records, 0 once TK_END has been handed out */
+JNIEXPORT jint JNICALL Java_com_cthulhu_NativeLexer_next(JNIEnv *env, jclass cls, jlong handle, jobject out) {
+    Handle *self = (Handle*)(intptr_t)handle;
+    CtPacked *records = (*env)->GetDirectBufferAddress(env, out);
+    size_t len;
+
+    CT_UNUSED(cls);
+
+    if (!self || !records || self->done)
+        return 0;
+
+    len = ctLexBatch(&self->lex, records, (size_t)(*env)->GetDirectBufferCapacity(env, out) / sizeof(CtPacked));
+    self->done = len && records[len - 1].kind == TK_END;
+
+    return (jint)len;
+}
+
+JNIEXPORT void JNICALL Java_com_cthulhu_NativeLexer_close(JNIEnv *env, jclass cls, jlong handle) {
+    Handle *self = (Handle*)(intptr_t)handle;
+
+    CT_UNUSED(env);
+    CT_UNUSED(cls);
+
+    if (!self)
+        return;
+
+    ctLexerFree(&self->lex);
+    ctSourcesFree(&self->sources);
+    free(self);
+}
@@ -1,15 +1,240 @@
 #include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
 
 #include "cthulhu/cthulhu.c"
 
+#define SOURCE_SIZE (4 << 20)
+
+/* throughput is the best of this many runs */
+#define RUNS 3
+
+/**
+ * fast has to parse at least this fast relative to small. optimized
+ * it is about 1.2x, sanitized builds spend their time elsewhere and
+ * come out even, so this leaves room for noise there
+ */
+#define MIN_SPEEDUP 0.85
+
+static void fill(CtAllocator *alloc) {
+    CtBuffer buf = ctBufferAlloc(alloc, 0);
+    size_t i;
+
+    for (i = 0; i < 0x10000; i++)
+        ctPush(&buf, (char)i);
+
+    ctAppend(&buf, "cthulhu", 7);
+    ctBufferFree(buf);
+}
+
+static char *generate(size_t size) {
+    const char *line = "12345 + 678 * (9 - 42) << 0x10;\n";
+    size_t len = strlen(line);
+    char *out = malloc(size + 1);
+    size_t i;
+
+    for (i = 0; i + len <= size; i += len)
+        memcpy(out + i, line, len);
+
+    out[i] = '\0';
+    return out;
+}
+
+/* lex and parse a large file, returns the peak number of bytes in use */
+static size_t workload(const char *text, double *rate) {
+    CtCounter counter = ctCounterAlloc(ctSystem());
+    CtArena arena = ctArenaAlloc(&counter.base, CT_MM_ARENA);
+    CtAllocator *nodes = CT_MM_EAGER ? &counter.base : &arena.base;
+    CtMemory memory = ctMemory(text, strlen(text));
+    CtSources sources = ctSourcesAlloc(&counter.base);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(&counter.base, &sources, "workload", &memory, ctMemoryNext), 4);
+    CtParser parser = ctParserAlloc(&lex, nodes, 4);
+    CtArenaMark mark = ctArenaMark(&arena);
+    clock_t start = clock();
+    double elapsed;
+    CtAST *node;
+
+    /* with eager freeing nodes go back one at a time, otherwise the arena is rewound */
+    while ((node = ctParse(&parser))) {
+        ctASTFree(&parser, node);
+        ctArenaRewind(&arena, mark);
+    }
+
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    *rate = memory.len / (elapsed > 0 ? elapsed : 1e-6) / (1 << 20);
+
+    if (lex.err_idx || parser.err_idx)
+        exit(1);
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+    ctArenaFree(&arena);
+
+    if (counter.current != 0)
+        exit(1);
+
+    return counter.peak;
+}
+
+static size_t overs = 0;
+
+/* counts instead of bailing out so the rest can be checked */
+static void over(CtLedger *self, CtMemKind kind, size_t size) {
+    CT_UNUSED(size);
+
+    if (kind != CT_MEM_TOKENS)
+        exit(1);
+
+    overs++;
+    self->limit = 0;
+}
+
+/* every kind of memory the front end uses lands on its own tag and is given back */
+static void ledger(void) {
+    const char *text = "def f(a, b) = a + b * 2;\nvar s = \"text\";\nvar v = f + 1;\nv * 2;\n";
+    CtMemory memory = ctMemory(text, strlen(text));
+    CtLedger ledger;
+    CtSources sources;
+    CtArena nodes;
+    CtLexer lex;
+    CtParser parser;
+    CtResolver resolver;
+    CtAST *decls[8];
+    CtToken *tokens;
+    size_t len = 0;
+    size_t sum = 0;
+    size_t i;
+
+    ctLedgerAlloc(&ledger, ctSystem());
+
+    sources = ctSourcesAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE));
+    nodes = ctArenaAlloc(ctLedgerTag(&ledger, CT_MEM_AST), 0x1000);
+    lex = ctLexerAlloc(ctStreamAlloc(ctLedgerTag(&ledger, CT_MEM_SOURCE), &sources, "ledger", &memory, ctMemoryNext), 4);
+    parser = ctParserAlloc(&lex, &nodes.base, 4);
+    resolver = ctResolverAlloc(&lex, ctLedgerTag(&ledger, CT_MEM_NAMES), 4);
+
+    ctLedgerPhase(&ledger, CT_PHASE_PARSE);
+    while (len < 8 && (decls[len] = ctParse(&parser)))
+        len++;
+
+    ctLedgerPhase(&ledger, CT_PHASE_RESOLVE);
+    ctResolve(&resolver, decls, len);
+
+    if (len != 4 || lex.err_idx || parser.err_idx || resolver.err_idx)
+        exit(1);
+
+    for (i = 0; i < CT_MEM_TOTAL; i++)
+        sum += ctLedgerUsage(&ledger, (CtMemKind)i).current;
+
+    if (sum != ctLedgerUsage(&ledger, CT_MEM_TOTAL).current)
+        exit(1);
+
+    if (!ledger.kinds[CT_MEM_SOURCE].current || !ledger.kinds[CT_MEM_STRINGS].current
+        || !ledger.kinds[CT_MEM_AST].current || !ledger.kinds[CT_MEM_DIAGNOSTICS].current
+        || !ledger.kinds[CT_MEM_NAMES].current || ledger.kinds[CT_MEM_OTHER].total)
+        exit(1);
+
+    if (!ledger.phases[CT_PHASE_SETUP].allocs || !ledger.phases[CT_PHASE_PARSE].allocs
+        || !ledger.phases[CT_PHASE_RESOLVE].allocs || ledger.phases[CT_PHASE_EVAL].allocs)
+        exit(1);
+
+    if (ledger.phases[CT_PHASE_RESOLVE].peak < ledger.phases[CT_PHASE_PARSE].current)
+        exit(1);
+
+    /* anything past the limit goes through over first */
+    ledger.limit = ledger.all.current;
+    ledger.over = over;
+
+    tokens = ctLexAll(&lex, &len);
+    if (overs != 1 || ledger.kinds[CT_MEM_TOKENS].current != sizeof(CtToken) * len)
+        exit(1);
+
+    ctRelease(ctLedgerTag(&ledger, CT_MEM_TOKENS), tokens, sizeof(CtToken) * len);
+    ctResolverFree(&resolver);
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+
+    for (i = 0; i < CT_MEM_TOTAL; i++)
+        if (ledger.kinds[i].current)
+            exit(1);
+
+    if (ledger.all.current || ledger.all.peak < ledger.phases[CT_PHASE_RESOLVE].peak)
+        exit(1);
+}
+
+#if defined(CT_MM_FAST)
+/* runs the small build and reads back the rate it printed */
+static double smallRate(const char *path) {
+    FILE *small = popen(path, "r");
+    double rate = 0;
+
+    if (!small)
+        exit(1);
+
+    if (fscanf(small, "peak %*d bytes, %lf MB/s", &rate) != 1 || pclose(small) != 0)
+        exit(1);
+
+    return rate;
+}
+#endif
 
 /* simple sanity check to make sure stuff compiles */
 int main(int argc, char **argv) {
+    CtCounter counter = ctCounterAlloc(ctSystem());
+    CtArena arena = ctArenaAlloc(&counter.base, 0x1000);
+    CtPool pool = ctPoolAlloc(&counter.base, 64, 32);
+    char *text = generate(SOURCE_SIZE);
+    size_t peak;
+    double rate;
+    size_t i;
+
     CT_UNUSED(argc);
     CT_UNUSED(argv);
 
-    ctInit();
+    fill(ctSystem());
+    fill(&arena.base);
+    fill(&pool.base);
+    fill(&counter.base);
+
+    ctArenaFree(&arena);
+    ctPoolFree(&pool);
+
+    if (counter.current != 0)
+        return 1;
+
+    ledger();
+
+    peak = workload(text, &rate);
+
+    for (i = 1; i < RUNS; i++) {
+        double again;
+
+        workload(text, &again);
+        if (again > rate)
+            rate = again;
+    }
+
+    free(text);
+
+    printf("peak %lu bytes, %.1f MB/s\n", (unsigned long)peak, rate);
+
+#if defined(CT_MM_SMALL)
+    /* only the line table should grow with the source */
+    if (peak > SOURCE_SIZE / 4)
+        return 1;
+#elif defined(CT_MM_FAST)
+    /* the small build of this test is passed in, fast has to keep up with it */
+    if (argc > 1) {
+        double small = smallRate(argv[1]);
+
+        printf("small %.1f MB/s\n", small);
+        if (rate < small * MIN_SPEEDUP)
+            return 1;
+    }
+#endif
 
-    ctFree();
     return 0;
 }
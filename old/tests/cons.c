@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "cthulhu/cthulhu.c"
+
+typedef struct {
+    const char *text;
+    size_t idx;
+} StringStream;
+
+static char nextChar(void *ptr) {
+    StringStream *stream = ptr;
+    char c = stream->text[stream->idx];
+
+    if (c)
+        stream->idx++;
+
+    return c;
+}
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+#define COUNT 20000
+
+static const char *exprs[] = {
+    "(1 + 2) * (3 << 4) - 5",
+    "((1 + 2) * (3 << 4) - 5) / 7 + (1 + 2)",
+    "~(0x10 | 0x0F) ^ -(1 + 2)",
+    "'a' + (3 << 4) % 6",
+    "(1 + 2) * (1 + 2) * (1 + 2) * (1 + 2)",
+    "(5 - 5) && 1 / (5 - 5)",
+    "1 / (5 - 5) + (1 + 2)"
+};
+
+#define LEN(arr) (sizeof(arr) / sizeof(*arr))
+
+static char *generate(void) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    char *out;
+    size_t i;
+
+    for (i = 0; i < COUNT; i++) {
+        const char *expr = exprs[i % LEN(exprs)];
+        ctAppend(&buf, expr, strlen(expr));
+        ctAppend(&buf, ";\n", 2);
+    }
+
+    out = malloc(buf.len + 1);
+    memcpy(out, ctAt(&buf, 0), buf.len);
+    out[buf.len] = '\0';
+
+    ctBufferFree(buf);
+    return out;
+}
+
+typedef struct {
+    StringStream text;
+    CtSources sources;
+    CtCounter nodes;
+    CtLexer lex;
+    CtParser parser;
+    size_t allocs;
+    CtAST *roots[COUNT];
+} Module;
+
+static void parse(Module *self, const char *text, CtCons *cons) {
+    size_t i;
+
+    self->text.text = text;
+    self->text.idx = 0;
+
+    self->sources = ctSourcesAlloc(ctSystem());
+    self->nodes = ctCounterAlloc(ctSystem());
+    self->lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &self->sources, "cons", &self->text, nextChar), 4);
+    self->parser = ctParserAlloc(&self->lex, &self->nodes.base, 4);
+    self->parser.cons = cons;
+    self->allocs = self->nodes.allocs;
+
+    for (i = 0; i < COUNT; i++)
+        CHECK((self->roots[i] = ctParse(&self->parser)) != NULL);
+
+    CHECK(ctParse(&self->parser) == NULL);
+    self->allocs = self->nodes.allocs - self->allocs;
+    CHECK(self->lex.err_idx == 0 && self->parser.err_idx == 0);
+}
+
+/* evaluates every statement, returns the number of failures */
+static size_t evalAll(Module *self, CtInt *values, double *elapsed) {
+    clock_t start = clock();
+    size_t fails = 0;
+    size_t i;
+
+    for (i = 0; i < COUNT; i++) {
+        CtFunction func = ctFunctionAlloc(self->roots[i], 0);
+
+        if (!ctCall(&func, NULL, &values[i])) {
+            CHECK(func.err.kind == ERR_DIVIDE_BY_ZERO);
+            values[i] = 0;
+            fails++;
+        }
+    }
+
+    *elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return fails;
+}
+
+static void release(Module *self) {
+    size_t i;
+
+    for (i = 0; i < COUNT; i++)
+        ctASTFree(&self->parser, self->roots[i]);
+
+    ctParserFree(&self->parser);
+    ctLexerFree(&self->lex);
+    ctSourcesFree(&self->sources);
+}
+
+static Module plain;
+static Module shared;
+static CtInt plainValues[COUNT];
+static CtInt sharedValues[COUNT];
+
+int main(int argc, char **argv) {
+    char *text = generate();
+    CtCounter consNodes = ctCounterAlloc(ctSystem());
+    CtCons cons = ctConsAlloc(&consNodes.base);
+    double plainTime;
+    double sharedTime;
+    size_t fails;
+    size_t folded;
+    size_t i;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    parse(&plain, text, NULL);
+    parse(&shared, text, &cons);
+
+    /* every statement is constant so nothing is left for the parser to allocate */
+    printf("plain %lu nodes, shared %lu nodes, %lu hits\n",
+        (unsigned long)plain.allocs, (unsigned long)cons.len, (unsigned long)cons.hits
+    );
+
+    CHECK(shared.allocs == 0);
+    CHECK(cons.len * 100 < plain.allocs);
+
+    /* identical statements are the same node */
+    for (i = LEN(exprs); i < COUNT; i++)
+        CHECK(shared.roots[i] == shared.roots[i - LEN(exprs)]);
+
+    CHECK(shared.roots[0] != shared.roots[1]);
+    CHECK(shared.roots[0] == shared.roots[1]->data.binary.lhs->data.binary.lhs);
+
+    fails = evalAll(&plain, plainValues, &plainTime);
+    CHECK(fails == COUNT / LEN(exprs) + (COUNT % LEN(exprs) == LEN(exprs) - 1));
+
+    /* folding evaluates each distinct subtree once and leaves errors for later */
+    folded = ctConsFold(&cons);
+    CHECK(folded > 0 && folded < cons.len);
+
+    CHECK(evalAll(&shared, sharedValues, &sharedTime) == fails);
+    printf("plain %.3fs, folded %.3fs\n", plainTime, sharedTime);
+
+    for (i = 0; i < COUNT; i++)
+        CHECK(plainValues[i] == sharedValues[i]);
+
+    CHECK(shared.roots[0]->kind == AK_LITERAL);
+    CHECK(shared.roots[0]->tok.data.digit.num == 139);
+    CHECK(shared.roots[LEN(exprs) - 1]->kind == AK_BINARY);
+
+    release(&shared);
+    release(&plain);
+
+    CHECK(shared.nodes.current == 0);
+
+    ctConsFree(&cons);
+    CHECK(consNodes.current == 0);
+
+    free(text);
+    return 0;
+}
@@ -0,0 +1,443 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "cthulhu/cthulhu.c"
+
+typedef struct {
+    const char *text;
+    size_t idx;
+} StringStream;
+
+static char nextChar(void *ptr) {
+    StringStream *stream = ptr;
+    char c = stream->text[stream->idx];
+
+    if (c)
+        stream->idx++;
+
+    return c;
+}
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+static const char *ops[] = {
+    "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^",
+    "==", "!=", "<", "<=", ">", ">=", "&&", "||"
+};
+
+static const char *leaves[] = {
+    "a", "b", "c", "0", "1", "7", "63", "64", "0x7FFFFFFFFFFFFFFF", "0x8000000000000000", "'x'"
+};
+
+static const char *unary[] = { "-", "~", "!", "+" };
+
+static const CtInt inputs[] = {
+    0, 1, -1, 2, 63, 64, -65, 1000000007, 0x7FFFFFFF, INT_MIN64, -0x7FFFFFFFFFFFFFFF
+};
+
+#define LEN(arr) (sizeof(arr) / sizeof(*arr))
+
+static void expr(CtBuffer *buf, int depth) {
+    const char *part;
+
+    if (depth == 0 || rand() % 4 == 0) {
+        part = leaves[rand() % LEN(leaves)];
+        ctAppend(buf, part, strlen(part));
+        return;
+    }
+
+    if (rand() % 5 == 0) {
+        part = unary[rand() % LEN(unary)];
+        ctAppend(buf, part, strlen(part));
+        ctPush(buf, '(');
+        expr(buf, depth - 1);
+        ctPush(buf, ')');
+        return;
+    }
+
+    part = ops[rand() % LEN(ops)];
+    ctPush(buf, '(');
+    expr(buf, depth - 1);
+    ctPush(buf, ' ');
+    ctAppend(buf, part, strlen(part));
+    ctPush(buf, ' ');
+    expr(buf, depth - 1);
+    ctPush(buf, ')');
+}
+
+static char *generate(size_t count) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    char *out;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        ctAppend(&buf, "def f(a, b, c) = ", 17);
+        expr(&buf, 6);
+        ctAppend(&buf, ";\n", 2);
+    }
+
+    out = malloc(buf.len + 1);
+    memcpy(out, ctAt(&buf, 0), buf.len);
+    out[buf.len] = '\0';
+
+    ctBufferFree(buf);
+    return out;
+}
+
+#define ROWS (LEN(inputs) * LEN(inputs) * 3)
+
+/* the interpreter, compiled code and column plan must agree on every result and error */
+static void compare(CtAST *def) {
+    CtFunction interp = ctFunctionAlloc(def, 0);
+    CtFunction native = ctFunctionAlloc(def, 0);
+    CtVecPlan plan = ctVecAlloc(ctSystem(), def);
+    CtInt columns[3][ROWS];
+    const CtInt *cols[3];
+    CtInt results[ROWS];
+    uint8_t flags[ROWS];
+    CtInt args[3];
+    size_t i, j, k;
+    size_t row = 0;
+
+    CHECK(ctCompile(&native) == CT_HAS_JIT);
+    CHECK(plan.err.kind == ERR_NONE);
+
+    for (i = 0; i < LEN(inputs); i++) {
+        for (j = 0; j < LEN(inputs); j++) {
+            for (k = 0; k < 3; k++) {
+                columns[0][row] = inputs[i];
+                columns[1][row] = inputs[j];
+                columns[2][row] = inputs[(i + j + k) % LEN(inputs)];
+                row++;
+            }
+        }
+    }
+
+    for (i = 0; i < 3; i++)
+        cols[i] = columns[i];
+
+    ctVecRun(&plan, cols, ROWS, results, flags);
+
+    for (row = 0; row < ROWS; row++) {
+        CtInt lhs = 0, rhs = 0;
+        bool ok;
+
+        for (i = 0; i < 3; i++)
+            args[i] = columns[i][row];
+
+        ok = ctCall(&interp, args, &lhs);
+        CHECK(ctCall(&native, args, &rhs) == ok);
+        CHECK(!(flags[row] & CT_VEC_DIVIDE) == ok);
+
+        if (ok) {
+            CHECK(lhs == rhs);
+            CHECK(lhs == results[row]);
+        } else {
+            CHECK(interp.err.kind == ERR_DIVIDE_BY_ZERO);
+            CHECK(native.err.kind == interp.err.kind);
+            CHECK(native.err.where.loc == interp.err.where.loc);
+        }
+    }
+
+    ctVecFree(&plan);
+    ctFunctionFree(&native);
+    ctFunctionFree(&interp);
+}
+
+typedef struct {
+    StringStream text;
+    CtSources sources;
+    CtLexer lex;
+    CtParser parser;
+    CtResolver resolver;
+} Module;
+
+static CtAST *moduleParse(Module *self, const char *text) {
+    CtAST *node;
+
+    self->text.text = text;
+    self->text.idx = 0;
+
+    self->sources = ctSourcesAlloc(ctSystem());
+    self->lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &self->sources, "eval", &self->text, nextChar), 4);
+    self->parser = ctParserAlloc(&self->lex, ctSystem(), 4);
+    self->resolver = ctResolverAlloc(&self->lex, ctSystem(), 4);
+
+    node = ctParse(&self->parser);
+    ctResolve(&self->resolver, &node, 1);
+
+    CHECK(self->lex.err_idx == 0 && self->parser.err_idx == 0 && self->resolver.err_idx == 0);
+    return node;
+}
+
+static void moduleClose(Module *self, CtAST *node) {
+    ctASTFree(&self->parser, node);
+    ctResolverFree(&self->resolver);
+    ctParserFree(&self->parser);
+    ctLexerFree(&self->lex);
+    ctSourcesFree(&self->sources);
+}
+
+static CtInt run(const char *text, CtInt a, CtInt b, CtErrorKind err) {
+    Module module;
+    CtAST *node = moduleParse(&module, text);
+    CtFunction func = ctFunctionAlloc(node, 0);
+    CtInt args[2];
+    CtInt out = 0;
+
+    args[0] = a;
+    args[1] = b;
+
+    compare(node);
+
+    CHECK(ctCall(&func, args, &out) == (err == ERR_NONE));
+    CHECK(func.err.kind == err);
+
+    ctFunctionFree(&func);
+    moduleClose(&module, node);
+    return out;
+}
+
+/* what an expression evaluates to without wrapping, in decimal */
+static void exactly(const char *text, const char *expect, CtErrorKind err) {
+    Module module;
+    CtAST *node = moduleParse(&module, text);
+    CtArena arena = ctArenaAlloc(ctSystem(), 0x1000);
+    CtBuffer out = ctBufferAlloc(ctSystem(), 64);
+    CtError fail;
+    CtNum num;
+
+    fail.kind = ERR_NONE;
+
+    if (ctEvalNum(node, &arena.base, &num, &fail)) {
+        ctNumDecimal(num, &out);
+        ctPush(&out, '\0');
+        CHECK(strcmp(ctAt(&out, 0), expect) == 0);
+    }
+
+    CHECK(fail.kind == err);
+
+    ctBufferFree(out);
+    ctArenaFree(&arena);
+    moduleClose(&module, node);
+}
+
+/* the flags a plan raises for one row */
+static uint8_t flagged(const char *text, CtInt a, CtInt b) {
+    Module module;
+    CtAST *node = moduleParse(&module, text);
+    CtVecPlan plan = ctVecAlloc(ctSystem(), node);
+    const CtInt *cols[2];
+    CtInt out;
+    uint8_t flags = 0;
+    size_t rows;
+
+    cols[0] = &a;
+    cols[1] = &b;
+
+    rows = ctVecRun(&plan, cols, 1, &out, &flags);
+    CHECK(rows == (flags != 0));
+
+    ctVecFree(&plan);
+    moduleClose(&module, node);
+    return flags;
+}
+
+static double rate(CtFunction *func, size_t count) {
+    clock_t start = clock();
+    CtInt args[3];
+    CtInt sum = 0;
+    CtInt out;
+    double elapsed;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        args[0] = (CtInt)i;
+        args[1] = (CtInt)i * 3 + 1;
+        args[2] = 5;
+        CHECK(ctCall(func, args, &out));
+        sum += out;
+    }
+
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    CHECK(sum != 42);
+
+    return count / (elapsed > 0 ? elapsed : 1e-6) / 1e6;
+}
+
+static double columnRate(CtAST *def, size_t count) {
+    CtVecPlan plan = ctVecAlloc(ctSystem(), def);
+    CtInt *data = malloc(sizeof(CtInt) * count * 4);
+    const CtInt *cols[3];
+    clock_t start;
+    CtInt sum = 0;
+    double elapsed;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        data[i] = (CtInt)i;
+        data[count + i] = (CtInt)i * 3 + 1;
+        data[count * 2 + i] = 5;
+    }
+
+    for (i = 0; i < 3; i++)
+        cols[i] = data + count * i;
+
+    start = clock();
+    CHECK(ctVecRun(&plan, cols, count, data + count * 3, NULL) == 0);
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    for (i = 0; i < count; i++)
+        sum += data[count * 3 + i];
+
+    CHECK(sum != 42);
+
+    ctVecFree(&plan);
+    free(data);
+
+    return count / (elapsed > 0 ? elapsed : 1e-6) / 1e6;
+}
+
+int main(int argc, char **argv) {
+    char *text = generate(300);
+    StringStream stream = { NULL, 0 };
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex;
+    CtParser parser;
+    CtResolver resolver;
+    CtFunction interp;
+    CtFunction tiered;
+    Module module;
+    CtAST *node;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    /* the edges of the integer semantics */
+    CHECK(run("def f(a, b) = a / b;", INT_MIN64, -1, ERR_NONE) == INT_MIN64);
+    CHECK(run("def f(a, b) = a % b;", INT_MIN64, -1, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a / b;", -7, 2, ERR_NONE) == -3);
+    CHECK(run("def f(a, b) = a % b;", -7, 2, ERR_NONE) == -1);
+    CHECK(run("def f(a, b) = a / b;", 1, 0, ERR_DIVIDE_BY_ZERO) == 0);
+    CHECK(run("def f(a, b) = a + b;", 0x7FFFFFFFFFFFFFFF, 1, ERR_NONE) == INT_MIN64);
+    CHECK(run("def f(a, b) = a << b;", 1, 65, ERR_NONE) == 2);
+    CHECK(run("def f(a, b) = a >> b;", -8, 1, ERR_NONE) == -4);
+    CHECK(run("def f(a, b) = b && a / b;", 1, 0, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a || a / b;", 1, 0, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = !a + ~b;", 0, 0, ERR_NONE) == 0);
+
+    /* comparisons mean what they say, compare only checks everything agrees */
+    CHECK(run("def f(a, b) = a > b;", 3, 2, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a > b;", 2, 3, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a < b;", 2, 3, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a < b;", 3, 2, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a <= b;", 2, 3, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a <= b;", 3, 3, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a <= b;", 4, 3, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a >= b;", 3, 2, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a >= b;", 3, 3, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = a >= b;", 2, 3, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a < b;", INT_MIN64, 0, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = 3 > 2 == 1;", 0, 0, ERR_NONE) == 1);
+    CHECK(run("def f(a, b) = 2 <= 3 == 1;", 0, 0, ERR_NONE) == 1);
+
+    /* exactly nothing wraps, small values never leave the int64 */
+    exactly("0x7FFFFFFFFFFFFFFF + 1;", "9223372036854775808", ERR_NONE);
+    exactly("-0x8000000000000000 / -1;", "9223372036854775808", ERR_NONE);
+    exactly("-0x8000000000000000;", "-9223372036854775808", ERR_NONE);
+    exactly("18446744073709551616 * 18446744073709551616;", "340282366920938463463374607431768211456", ERR_NONE);
+    exactly("123456789012345678901234567890 - 123456789012345678901234567889;", "1", ERR_NONE);
+    exactly("(1 << 200) / 3 % 1000;", "125", ERR_NONE);
+    exactly("-(1 << 100) % 7;", "-2", ERR_NONE);
+    exactly("-(1 << 100) >> 98;", "-4", ERR_NONE);
+    exactly("~(1 << 70) & 0xFF;", "255", ERR_NONE);
+    exactly("(1 << 64) - 1 ^ 0xFFFFFFFFFFFFFFFF;", "0", ERR_NONE);
+    exactly("0x10000000000000000 == 18446744073709551616;", "1", ERR_NONE);
+    exactly("1 << 4095 >> 4095;", "1", ERR_NONE);
+    exactly("1 << 4096;", "", ERR_OVERFLOW);
+    exactly("1 << -1;", "", ERR_UNSUPPORTED);
+    exactly("(1 << 80) / 0;", "", ERR_DIVIDE_BY_ZERO);
+    exactly("0 && (1 << 80) / 0;", "0", ERR_NONE);
+    exactly("3 > 2;", "1", ERR_NONE);
+    exactly("2 <= 3;", "1", ERR_NONE);
+    exactly("3 < 2;", "0", ERR_NONE);
+    exactly("2 >= 3;", "0", ERR_NONE);
+    exactly("(1 << 70) > (1 << 69);", "1", ERR_NONE);
+    exactly("(1 << 70) < (1 << 69);", "0", ERR_NONE);
+    exactly("-(1 << 70) <= 1;", "1", ERR_NONE);
+    exactly("-(1 << 70) >= 1;", "0", ERR_NONE);
+
+    /* ?: binds right to left and only runs the side it picks */
+    CHECK(run("def f(a, b) = a ? 0 : b ? 3 : 4;", 1, 0, ERR_NONE) == 0);
+    CHECK(run("def f(a, b) = a ? 0 : b ? 3 : 4;", 0, 1, ERR_NONE) == 3);
+    CHECK(run("def f(a, b) = b ? a / b : a;", 7, 0, ERR_NONE) == 7);
+    CHECK(run("def f(a, b) = a - b ? 1 : 2;", 3, 3, ERR_NONE) == 2);
+
+    /* rows wrap like ctCall but say so, and only where the scalar code would have run */
+    CHECK(flagged("def f(a, b) = a + b;", 0x7FFFFFFFFFFFFFFF, 1) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a - b;", INT_MIN64, 1) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", 0x100000000, 0x80000000) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", -1, INT_MIN64) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", 0x7FFFFFFF, -0x7FFFFFFF) == 0);
+    CHECK(flagged("def f(a, b) = a * b;", 0x4000000000000000, -2) == 0);
+    CHECK(flagged("def f(a, b) = a * b;", 0x4000000000000000, 2) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", INT_MIN64, 1) == 0);
+    CHECK(flagged("def f(a, b) = a * b;", 3037000499, -3037000499) == 0);
+    CHECK(flagged("def f(a, b) = a * b;", -3037000500, -3037000500) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", 0xFFFFFFFF, 0x80000001) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a * b;", 0x1FFFFFFFF, 0x3FFFFFFF) == 0);
+    CHECK(flagged("def f(a, b) = a * b;", 0x1FFFFFFFF, 0x80000000) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = -a;", INT_MIN64, 0) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a / b;", INT_MIN64, -1) == CT_VEC_OVERFLOW);
+    CHECK(flagged("def f(a, b) = a % b + a / b;", 1, 0) == CT_VEC_DIVIDE);
+    CHECK(flagged("def f(a, b) = b && a / b;", 1, 0) == 0);
+    CHECK(flagged("def f(a, b) = b ? a / b : a + 0x7FFFFFFFFFFFFFFF;", 0, 1) == 0);
+    CHECK(flagged("def f(a, b) = b ? a / b : a + 0x7FFFFFFFFFFFFFFF;", 1, 0) == CT_VEC_OVERFLOW);
+
+    /* random expressions */
+    stream.text = text;
+    lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "random", &stream, nextChar), 4);
+    parser = ctParserAlloc(&lex, ctSystem(), 4);
+
+    while ((node = ctParse(&parser))) {
+        resolver = ctResolverAlloc(&lex, ctSystem(), 4);
+        ctResolve(&resolver, &node, 1);
+
+        CHECK(lex.err_idx == 0 && parser.err_idx == 0 && resolver.err_idx == 0);
+        compare(node);
+
+        ctResolverFree(&resolver);
+        ctASTFree(&parser, node);
+    }
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+    free(text);
+
+    /* hot functions get compiled after enough calls */
+    node = moduleParse(&module, "def f(a, b, c) = (a * b + c) % 1000003 - (a >> 3 ^ b) * (c | 1);");
+    interp = ctFunctionAlloc(node, 0);
+    tiered = ctFunctionAlloc(node, 16);
+
+    printf("interpreted %.1f M/s, ", rate(&interp, 2000000));
+    printf("tiered %.1f M/s, ", rate(&tiered, 2000000));
+    printf("columns %.1f M/s\n", columnRate(node, 2000000));
+
+    CHECK((tiered.native != NULL) == CT_HAS_JIT);
+    CHECK(interp.native == NULL);
+
+    ctFunctionFree(&tiered);
+    ctFunctionFree(&interp);
+    moduleClose(&module, node);
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cthulhu/cthulhu.c"
+
+typedef struct {
+    const char *text;
+    size_t idx;
+} StringStream;
+
+static char nextChar(void *ptr) {
+    StringStream *stream = ptr;
+    char c = stream->text[stream->idx];
+
+    if (c)
+        stream->idx++;
+
+    return c;
+}
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+static CtToken expect(CtLexer *lex, CtTokenKind kind) {
+    CtToken tok = ctLex(lex);
+    CHECK(tok.kind == kind);
+    return tok;
+}
+
+static void checkIdent(CtLexer *lex, const char *name) {
+    CtToken tok = expect(lex, TK_IDENT);
+    CHECK(tok.data.ident.len == strlen(name));
+    CHECK(memcmp(ctIdent(lex, tok.data.ident), name, strlen(name)) == 0);
+}
+
+static void utf8(void) {
+    /* caf\u00E9 \u03C0r \u53D8\u91CF a\u0301 then a bad byte, a euro sign, and a bad comment */
+    StringStream text = {
+        "caf\xC3\xA9 \xCF\x80r \xE5\x8F\x98\xE9\x87\x8F a\xCC\x81 \"\xE2\x82\xAC\"\n"
+        "\xC0\xAF \xE2\x82\xAC # \xED\xA0\x80\n x",
+        0
+    };
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "utf8", &text, nextChar), 16);
+    CtToken tok;
+    const char *ascii = "an ascii run long enough for a few vectors ";
+    char buf[128];
+
+    checkIdent(&lex, "caf\xC3\xA9");
+    checkIdent(&lex, "\xCF\x80r");
+    checkIdent(&lex, "\xE5\x8F\x98\xE9\x87\x8F");
+    checkIdent(&lex, "a\xCC\x81");
+
+    tok = expect(&lex, TK_STRING);
+    CHECK(strcmp(ctString(&lex, tok.data.str), "\xE2\x82\xAC") == 0);
+    CHECK(lex.err_idx == 0);
+
+    expect(&lex, TK_KEY);
+    CHECK(lex.err_idx == 1 && lex.errs[0].kind == ERR_INVALID_UTF8);
+
+    expect(&lex, TK_KEY);
+    CHECK(lex.err_idx == 2 && lex.errs[1].kind == ERR_INVALID_SYMBOL);
+
+    /* the comment reports at the bad byte, columns count bytes */
+    checkIdent(&lex, "x");
+    CHECK(lex.err_idx == 3 && lex.errs[2].kind == ERR_INVALID_UTF8);
+    CHECK(ctDecode(&sources, lex.errs[2].where.loc).col == 9);
+
+    expect(&lex, TK_END);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+
+    /* whole buffers, with the bad bytes past the vectorized prefix */
+    CHECK(ctUtf8Check(ascii, strlen(ascii)) == strlen(ascii));
+    CHECK(ctUtf8Check("\xF0\x9F\x90\x99 \xC3\xA9", 7) == 7);
+
+    strcpy(buf, ascii);
+    strcat(buf, "\xE0\x80\x80");
+    CHECK(ctUtf8Check(buf, strlen(buf)) == strlen(ascii));
+
+    strcpy(buf, ascii);
+    strcat(buf, "\xC3\xA9\xED\xA0\x80");
+    CHECK(ctUtf8Check(buf, strlen(buf)) == strlen(ascii) + 2);
+
+    strcpy(buf, ascii);
+    strcat(buf, "\xF4\x90\x80\x80");
+    CHECK(ctUtf8Check(buf, strlen(buf)) == strlen(ascii));
+
+    strcpy(buf, ascii);
+    strcat(buf, "\xE2\x82");
+    CHECK(ctUtf8Check(buf, strlen(buf)) == strlen(ascii));
+
+    CHECK(ctUtf8Check("\x80", 1) == 0);
+    CHECK(ctUtf8Check("", 0) == 0);
+}
+
+static void batch(void) {
+    const char *text = "def x = 0x10;\n'a' \"s\" 99999999999999999999999";
+    CtMemory memory = ctMemory(text, strlen(text));
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "batch", &memory, ctMemoryNext), 16);
+    CtPacked out[4];
+    size_t len;
+
+    /* the java side reads records at fixed offsets */
+    CHECK(sizeof(CtPacked) == 24);
+
+    /* short batches pick up where the last one left off */
+    CHECK(ctLexBatch(&lex, out, 4) == 4);
+    CHECK(out[0].kind == TK_KEY && out[0].key == K_DEF);
+    CHECK(out[1].kind == TK_IDENT && out[1].offset == 4 && out[1].len == 1);
+    CHECK(out[2].kind == TK_KEY && out[2].key == K_ASSIGN);
+    CHECK(out[3].kind == TK_INT && out[3].value == 16);
+    CHECK(CT_PACKED_BASE(out[3].flags) == BASE16 && out[3].len == 4);
+
+    CHECK(ctLexBatch(&lex, out, 4) == 4);
+    CHECK(out[0].kind == TK_KEY && out[0].key == K_SEMI);
+    CHECK(out[1].kind == TK_CHAR && out[1].value == 'a' && out[1].offset == 14);
+    CHECK(out[2].kind == TK_STRING && out[2].len == 3);
+    CHECK(out[3].kind == TK_INT && out[3].flags == (CT_PACKED_BIG | BASE10 << 1));
+    CHECK(out[3].value == ((uint64_t)0x02C7E14A << 32 | 0xF67FFFFF));
+
+    len = ctLexBatch(&lex, out, 4);
+    CHECK(len == 1 && out[0].kind == TK_END);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+}
+
+static void bigs(void) {
+    char text[1400] = "9223372036854775807 9223372036854775808 0x123456789ABCDEF0123456789 0000000000000000000000001 1";
+    CtMemory memory;
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex;
+    CtToken tok;
+
+    /* the last one has more than CT_MAX_BITS */
+    memset(text + strlen(text), '0', 1300);
+    text[sizeof(text) - 1] = '\0';
+
+    memory = ctMemory(text, strlen(text));
+    lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "bigs", &memory, ctMemoryNext), 16);
+
+    tok = expect(&lex, TK_INT);
+    CHECK(tok.data.digit.num == 0x7FFFFFFFFFFFFFFF && tok.data.digit.big == NULL);
+
+    tok = expect(&lex, TK_INT);
+    CHECK(tok.data.digit.num == (size_t)1 << 63 && tok.data.digit.big != NULL);
+    CHECK(tok.data.digit.big->len == 2 && !tok.data.digit.big->negative);
+    CHECK(tok.data.digit.big->limbs[0] == 0 && tok.data.digit.big->limbs[1] == 0x80000000);
+
+    tok = expect(&lex, TK_INT);
+    CHECK(tok.data.digit.enc == BASE16 && tok.data.digit.big->len == 4);
+    CHECK(tok.data.digit.big->limbs[0] == 0x23456789 && tok.data.digit.big->limbs[1] == 0xABCDEF01);
+    CHECK(tok.data.digit.big->limbs[2] == 0x23456789 && tok.data.digit.big->limbs[3] == 0x1);
+
+    /* leading zeros dont make a literal big */
+    tok = expect(&lex, TK_INT);
+    CHECK(tok.data.digit.num == 1 && tok.data.digit.big == NULL);
+    CHECK(lex.err_idx == 0);
+
+    tok = expect(&lex, TK_INT);
+    CHECK(tok.data.digit.big == NULL);
+    CHECK(lex.err_idx == 1 && lex.errs[0].kind == ERR_OVERFLOW);
+
+    expect(&lex, TK_END);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+}
+
+static void dialects(void) {
+    const char *text = "if int !<x> ; nop if int !<x>";
+    CtMemory memory = ctMemory(text, strlen(text));
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "dialects", &memory, ctMemoryNext), 16);
+
+    /* core knows if and type arguments but not instructions */
+    CHECK(expect(&lex, TK_KEY).data.key == K_IF);
+    checkIdent(&lex, "int");
+    CHECK(expect(&lex, TK_KEY).data.key == K_TBEGIN);
+    checkIdent(&lex, "x");
+    CHECK(expect(&lex, TK_KEY).data.key == K_TEND);
+    CHECK(expect(&lex, TK_KEY).data.key == K_SEMI);
+
+    /* switching between tokens, asm is the other way around */
+    lex.dialect = LD_ASM;
+    CHECK(expect(&lex, TK_KEY).data.key == K_NOP);
+    checkIdent(&lex, "if");
+    CHECK(expect(&lex, TK_KEY).data.key == K_INT);
+    CHECK(expect(&lex, TK_KEY).data.key == K_NOT);
+    CHECK(expect(&lex, TK_KEY).data.key == K_LT);
+    checkIdent(&lex, "x");
+    CHECK(expect(&lex, TK_KEY).data.key == K_GT);
+    expect(&lex, TK_END);
+
+    CHECK(lex.err_idx == 0 && lex.depth == 0);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+}
+
+int main(int argc, char **argv) {
+    StringStream text = { "500 0x500 0b1100 0 def\n  name 'a' \"str\" # comment\n!= ;", 0 };
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "lex", &text, nextChar), 16);
+    CtToken tok;
+    CtPosition pos;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    CHECK(expect(&lex, TK_INT).data.digit.num == 500);
+    CHECK(expect(&lex, TK_INT).data.digit.num == 0x500);
+    CHECK(expect(&lex, TK_INT).data.digit.num == 12);
+    CHECK(expect(&lex, TK_INT).data.digit.num == 0);
+    CHECK(expect(&lex, TK_KEY).data.key == K_DEF);
+
+    tok = expect(&lex, TK_IDENT);
+    CHECK(memcmp(ctIdent(&lex, tok.data.ident), "name", 4) == 0);
+
+    pos = ctDecode(&sources, tok.where.loc);
+    CHECK(strcmp(pos.name, "lex") == 0);
+    CHECK(pos.line == 1 && pos.col == 2);
+
+    CHECK(expect(&lex, TK_CHAR).data.letter == 'a');
+
+    tok = expect(&lex, TK_STRING);
+    CHECK(strcmp(ctString(&lex, tok.data.str), "str") == 0);
+
+    tok = expect(&lex, TK_KEY);
+    CHECK(tok.data.key == K_NEQ);
+
+    pos = ctDecode(&sources, tok.where.loc);
+    CHECK(pos.line == 2 && pos.col == 0);
+
+    CHECK(expect(&lex, TK_KEY).data.key == K_SEMI);
+    expect(&lex, TK_END);
+
+    CHECK(lex.err_idx == 0);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+
+    utf8();
+    batch();
+    bigs();
+    dialects();
+
+    return 0;
+}
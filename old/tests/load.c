@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cthulhu/cthulhu.c"
+
+#define FILES 16
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+#define BAD_FILE 5
+
+/* every other file is big enough to be mapped, one ends in a byte that isnt utf8 */
+static size_t writeFile(const char *path, size_t idx) {
+    FILE *file = fopen(path, "w");
+    size_t lines = idx % 2 ? CT_LOAD_MAP_MIN / 8 : idx + 1;
+    size_t i;
+
+    CHECK(file != NULL);
+
+    for (i = 0; i < lines; i++)
+        fprintf(file, "%lu + 1;\n", (unsigned long)(i % 10));
+
+    if (idx == BAD_FILE)
+        fputs("#\xFF\n", file);
+
+    fclose(file);
+    return lines;
+}
+
+int main(int argc, char **argv) {
+    char paths[FILES][64];
+    size_t lines[FILES];
+    CtLoad loads[FILES + 1];
+    CtLoader loader;
+    size_t i;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    for (i = 0; i < FILES; i++) {
+        sprintf(paths[i], "load-%lu.ct", (unsigned long)i);
+        lines[i] = writeFile(paths[i], i);
+        loads[i].path = paths[i];
+    }
+
+    /* a failed load shouldnt leave anything behind from before */
+    loads[FILES].path = "load-missing.ct";
+    loads[FILES].valid = 12345;
+
+    CHECK(ctLoaderStart(&loader, ctSystem(), loads, FILES + 1, 4, 4));
+
+    for (i = 0; i < FILES; i++) {
+        CtLoad *load = ctLoaderWait(&loader, i);
+        CtMemory memory = ctMemory(load->data, load->size);
+        CtSources sources = ctSourcesAlloc(ctSystem());
+        CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, load->path, &memory, ctMemoryNext), 4);
+        size_t semis = 0;
+        CtToken tok;
+
+        CHECK(load->error == 0);
+        CHECK(load->mapped == (load->size >= CT_LOAD_MAP_MIN));
+        CHECK(load->valid == (i == BAD_FILE ? load->size - 2 : load->size));
+
+        while ((tok = ctLex(&lex)).kind != TK_END)
+            semis += tok.kind == TK_KEY && tok.data.key == K_SEMI;
+
+        CHECK(semis == lines[i]);
+
+        ctLexerFree(&lex);
+        ctSourcesFree(&sources);
+        ctLoaderDone(&loader, load);
+
+        remove(paths[i]);
+    }
+
+    CHECK(ctLoaderWait(&loader, FILES)->error != 0);
+    CHECK(loads[FILES].data == NULL && loads[FILES].size == 0 && loads[FILES].valid == 0);
+    ctLoaderDone(&loader, loads + FILES);
+
+    ctLoaderJoin(&loader);
+
+    return 0;
+}
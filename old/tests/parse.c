@@ -0,0 +1,524 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cthulhu/cthulhu.c"
+
+typedef struct {
+    const char *text;
+    size_t idx;
+} StringStream;
+
+static char nextChar(void *ptr) {
+    StringStream *stream = ptr;
+    char c = stream->text[stream->idx];
+
+    if (c)
+        stream->idx++;
+
+    return c;
+}
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+static bool same(CtAST *lhs, CtAST *rhs) {
+    if (!lhs || !rhs)
+        return lhs == rhs;
+
+    if (lhs->kind != rhs->kind || lhs->tok.kind != rhs->tok.kind || lhs->tok.where.loc != rhs->tok.where.loc)
+        return false;
+
+    switch (lhs->kind) {
+    case AK_BINARY:
+        return same(lhs->data.binary.lhs, rhs->data.binary.lhs)
+            && same(lhs->data.binary.rhs, rhs->data.binary.rhs);
+    case AK_UNARY:
+        return same(lhs->data.expr, rhs->data.expr);
+    default:
+        return lhs->tok.kind != TK_INT || lhs->tok.data.digit.num == rhs->tok.data.digit.num;
+    }
+}
+
+static char *generate(size_t count) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    char line[64];
+    char *out;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        sprintf(line, "(%lu + 2) * 3 - ~4 / %lu << 1;\n", (unsigned long)i, (unsigned long)(i % 7 + 1));
+        ctAppend(&buf, line, strlen(line));
+    }
+
+    out = malloc(buf.len + 1);
+    memcpy(out, ctAt(&buf, 0), buf.len);
+    out[buf.len] = '\0';
+
+    ctBufferFree(buf);
+    return out;
+}
+
+/* - is left associative, = and ?: are right associative */
+static void assoc(void) {
+    CtMemory text = ctMemory("a - b - c; a = b = c; a ? b : c ? d : e;", 40);
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x1000);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "assoc", &text, ctMemoryNext), 4);
+    CtParser parser = ctParserAlloc(&lex, &nodes.base, 4);
+    CtAST *node;
+
+    node = ctParse(&parser);
+    CHECK(node->kind == AK_BINARY && node->data.binary.lhs->kind == AK_BINARY);
+    CHECK(node->data.binary.rhs->kind == AK_NAME);
+
+    node = ctParse(&parser);
+    CHECK(node->kind == AK_BINARY && node->tok.data.key == K_ASSIGN);
+    CHECK(node->data.binary.lhs->kind == AK_NAME);
+    CHECK(node->data.binary.rhs->kind == AK_BINARY && node->data.binary.rhs->tok.data.key == K_ASSIGN);
+
+    node = ctParse(&parser);
+    CHECK(node->kind == AK_TERNARY && node->data.ternary.cond->kind == AK_NAME);
+    CHECK(node->data.ternary.lhs->kind == AK_NAME && node->data.ternary.rhs->kind == AK_TERNARY);
+
+    CHECK(ctParse(&parser) == NULL);
+    CHECK(lex.err_idx == 0 && parser.err_idx == 0);
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+}
+
+/* rewinding replays tokens and hands back nodes and errors */
+static void speculate(void) {
+    const char *source = "1 + 2 * 3; 4 + ; 6;";
+    CtMemory text = ctMemory(source, strlen(source));
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x1000);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "speculate", &text, ctMemoryNext), 4);
+    CtParser parser = ctParserAlloc(&lex, &nodes.base, 4);
+    CtArenaMark before;
+    CtParserMark mark;
+    CtAST *node;
+    size_t lexed;
+
+    CHECK(ctParserAhead(&parser, 2).data.digit.num == 2);
+    CHECK(ctParserAhead(&parser, 0).data.digit.num == 1);
+
+    before = ctArenaMark(&nodes);
+    mark = ctParserMark(&parser);
+
+    CHECK(ctParse(&parser)->kind == AK_BINARY);
+    ctParse(&parser);
+    CHECK(parser.err_idx == 1);
+
+    lexed = text.idx;
+    ctParserRewind(&parser, mark);
+
+    CHECK(parser.err_idx == 0);
+    CHECK(nodes.head == before.chunk && nodes.head->used == before.used);
+
+    node = ctParse(&parser);
+    CHECK(node->kind == AK_BINARY && node->tok.data.key == K_ADD);
+
+    /* dropping a mark keeps everything parsed since */
+    mark = ctParserMark(&parser);
+    ctParse(&parser);
+    ctParserDrop(&parser, mark);
+
+    CHECK(parser.err_idx == 1);
+    CHECK(text.idx == lexed);
+
+    node = ctParse(&parser);
+    CHECK(node->kind == AK_LITERAL && node->tok.data.digit.num == 6);
+    CHECK(ctParse(&parser) == NULL);
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+}
+
+/* a statement that doesnt end where it should is dropped whole, not parsed on from the bad token */
+static void recover(void) {
+    const char *source = "1 $ 3; 1 !< 2; 4 5; 6;";
+    CtMemory text = ctMemory(source, strlen(source));
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x1000);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "recover", &text, ctMemoryNext), 4);
+    CtParser parser = ctParserAlloc(&lex, &nodes.base, 4);
+    CtAST *node;
+
+    CHECK(ctParse(&parser) == NULL);
+    CHECK(lex.err_idx == 1 && parser.err_idx == 1);
+
+    CHECK(ctParse(&parser) == NULL);
+    CHECK(parser.err_idx == 2);
+
+    CHECK(ctParse(&parser) == NULL);
+    CHECK(parser.err_idx == 3);
+
+    node = ctParse(&parser);
+    CHECK(node && node->kind == AK_LITERAL && node->tok.data.digit.num == 6);
+
+    CHECK(ctParse(&parser) == NULL);
+    CHECK(parser.err_idx == 3);
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+}
+
+/* nesting past CT_MAX_DEPTH is an error on that statement and the next one still parses */
+static void deep(void) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    CtMemory text;
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x1000);
+    CtLexer lex;
+    CtParser parser;
+    CtAST *node;
+    size_t i;
+
+    for (i = 0; i < CT_MAX_DEPTH * 2; i++)
+        ctAppend(&buf, "-(", 2);
+    ctPush(&buf, '1');
+    for (i = 0; i < CT_MAX_DEPTH * 2; i++)
+        ctPush(&buf, ')');
+    ctAppend(&buf, "; a = b = c;", 12);
+
+    text = ctMemory(ctAt(&buf, 0), buf.len);
+    lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "deep", &text, ctMemoryNext), 4);
+    parser = ctParserAlloc(&lex, &nodes.base, 4);
+
+    ctParse(&parser);
+    CHECK(parser.err_idx == 1 && parser.errs[0].kind == ERR_TOO_DEEP);
+    CHECK(parser.depth == 0);
+
+    node = ctParse(&parser);
+    CHECK(node && node->kind == AK_BINARY && node->tok.data.key == K_ASSIGN);
+    CHECK(parser.err_idx == 1 && parser.depth == 0);
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+    ctBufferFree(buf);
+}
+
+/* every chunk boundary lands somewhere awkward, inside strings, comments, numbers and chars */
+static const char *pushText =
+    "def f(a, b) = a + b * 2;\n"
+    "var s = \"split \\\"string\\\" here\";\n"
+    "var r = r\"raw\nstring\";  # a comment; that runs on\n"
+    "struct point { x: int; y: int; };\n"
+    "0x1F + 0b101 + 12345678901 >> 2;\n"
+    "'a'; '\\n'; 'b';\n"
+    "1;\n"
+    "+ $;\n"
+    "f >> 3 \t\r\n"
+    "# no ; at the end";
+
+#define PUSH_SESSIONS 64
+
+typedef struct {
+    CtToken tokens[128];
+    size_t tokens_len;
+
+    CtAST *nodes[32];
+    size_t len;
+} Pushed;
+
+static void pushedToken(CtPush *self, CtToken tok) {
+    Pushed *out = self->data;
+    if (out->tokens_len < 128)
+        out->tokens[out->tokens_len++] = tok;
+}
+
+static void pushedStmt(CtPush *self, CtAST *node) {
+    Pushed *out = self->data;
+    if (out->len < 32)
+        out->nodes[out->len] = node;
+    out->len++;
+}
+
+static bool sameToken(CtToken lhs, CtToken rhs) {
+    if (lhs.kind != rhs.kind || lhs.where.loc != rhs.where.loc || lhs.where.len != rhs.where.len)
+        return false;
+
+    switch (lhs.kind) {
+    case TK_KEY: return lhs.data.key == rhs.data.key;
+    case TK_INT: return lhs.data.digit.num == rhs.data.digit.num;
+    case TK_CHAR: return lhs.data.letter == rhs.data.letter;
+    default: return true;
+    }
+}
+
+/* feeding any size of chunk finds the same tokens, statements and errors as pulling */
+static void push(void) {
+    size_t len = strlen(pushText);
+    CtMemory tokenText = ctMemory(pushText, len);
+    CtMemory serialText = ctMemory(pushText, len);
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtSources serialSources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x10000);
+    CtLexer tokenLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "push", &tokenText, ctMemoryNext), 16);
+    CtLexer serialLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &serialSources, "push", &serialText, ctMemoryNext), 16);
+    CtParser serial = ctParserAlloc(&serialLex, &nodes.base, 16);
+    CtPush *sessions = malloc(sizeof(CtPush) * PUSH_SESSIONS);
+    CtSources *sessionSources = malloc(sizeof(CtSources) * PUSH_SESSIONS);
+    Pushed *expect = malloc(sizeof(Pushed));
+    Pushed *got = malloc(sizeof(Pushed));
+    CtToken *tokens;
+    size_t tokens_len;
+    size_t chunk;
+    size_t i, j;
+
+    tokens = ctLexAll(&tokenLex, &tokens_len);
+
+    expect->len = 0;
+    while (pPeek(&serial).kind != TK_END) {
+        CtAST *node = ctParse(&serial);
+        if (node)
+            expect->nodes[expect->len++] = node;
+    }
+
+    CHECK(expect->len == 9 && serialLex.err_idx == 1 && serial.err_idx == 2);
+
+    for (chunk = 1; chunk <= len; chunk++) {
+        CtSources pushSources = ctSourcesAlloc(ctSystem());
+        CtPush it;
+
+        ctPushAlloc(&it, ctSystem(), &pushSources, "push", &nodes.base, 16);
+        it.token = pushedToken;
+        it.stmt = pushedStmt;
+        it.data = got;
+        got->tokens_len = 0;
+        got->len = 0;
+
+        for (i = 0; i < len; i += chunk)
+            ctFeed(&it, pushText + i, i + chunk > len ? len - i : chunk);
+
+        /* everything up to the last statement has been parsed already, it has no ; so it only breaks once finished */
+        CHECK(got->len == expect->len && it.parser.err_idx == serial.err_idx - 1);
+        ctFinish(&it);
+
+        CHECK(got->tokens_len == tokens_len);
+        for (i = 0; i < tokens_len; i++)
+            CHECK(sameToken(got->tokens[i], tokens[i]));
+
+        CHECK(got->len == expect->len);
+        for (i = 0; i < expect->len; i++)
+            CHECK(same(got->nodes[i], expect->nodes[i]));
+
+        CHECK(it.lex.err_idx == serialLex.err_idx && it.parser.err_idx == serial.err_idx);
+        for (i = 0; i < serial.err_idx; i++) {
+            CHECK(it.parser.errs[i].kind == serial.errs[i].kind);
+            CHECK(it.parser.errs[i].where.loc == serial.errs[i].where.loc);
+        }
+
+        ctPushFree(&it);
+        ctSourcesFree(&pushSources);
+    }
+
+    /* one thread taking turns between many sessions */
+    for (i = 0; i < PUSH_SESSIONS; i++) {
+        sessionSources[i] = ctSourcesAlloc(ctSystem());
+        ctPushAlloc(&sessions[i], ctSystem(), &sessionSources[i], "session", &nodes.base, 16);
+        sessions[i].stmt = pushedStmt;
+        sessions[i].data = got;
+    }
+
+    got->len = 0;
+    for (i = 0; i < len; i += 7) {
+        for (j = 0; j < PUSH_SESSIONS; j++)
+            ctFeed(&sessions[(i + j) % PUSH_SESSIONS], pushText + i, i + 7 > len ? len - i : 7);
+    }
+
+    /* a nul ends the input and the rest is ignored */
+    ctFeed(&sessions[0], "\0var x = 1;", 11);
+
+    for (i = 0; i < PUSH_SESSIONS; i++) {
+        ctFinish(&sessions[i]);
+        CHECK(sessions[i].lex.err_idx == serialLex.err_idx && sessions[i].parser.err_idx == serial.err_idx);
+
+        ctPushFree(&sessions[i]);
+        ctSourcesFree(&sessionSources[i]);
+    }
+
+    CHECK(got->len == expect->len * PUSH_SESSIONS);
+
+    ctRelease(ctSystem(), tokens, sizeof(CtToken) * tokens_len);
+    free(sessions);
+    free(sessionSources);
+    free(expect);
+    free(got);
+
+    ctParserFree(&serial);
+    ctLexerFree(&serialLex);
+    ctLexerFree(&tokenLex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&sources);
+    ctSourcesFree(&serialSources);
+}
+
+/* split parsing should find the same statements and errors as a serial parse */
+static void split(void) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    CtMemory serialText;
+    CtMemory splitText;
+    CtSources serialSources = ctSourcesAlloc(ctSystem());
+    CtSources splitSources = ctSourcesAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(ctSystem(), 0x10000);
+    CtLexer serialLex;
+    CtLexer splitLex;
+    CtParser serial;
+    CtSplit parts;
+    CtSplit counted;
+    CtLedger ledger;
+    CtToken *tokens;
+    size_t len;
+    size_t count = 0;
+    char line[64];
+    size_t i;
+
+    for (i = 0; i < 10000; i++) {
+        if (i % 10 == 0) {
+            sprintf(line, "struct s%lu { x: t; y: s; };\n", (unsigned long)i);
+        } else if (i == 5001) {
+            sprintf(line, "1 + ;\n");
+        } else {
+            sprintf(line, "(%lu + 2) * 3 - ~4 / %lu << 1;\n", (unsigned long)i, (unsigned long)(i % 7 + 1));
+        }
+        ctAppend(&buf, line, strlen(line));
+    }
+
+    serialText = ctMemory(ctAt(&buf, 0), ctOffset(&buf));
+    splitText = ctMemory(ctAt(&buf, 0), ctOffset(&buf));
+
+    serialLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &serialSources, "serial", &serialText, ctMemoryNext), 16);
+    splitLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &splitSources, "split", &splitText, ctMemoryNext), 16);
+    serial = ctParserAlloc(&serialLex, &nodes.base, 16);
+
+    tokens = ctLexAll(&splitLex, &len);
+    CHECK(tokens[len - 1].kind == TK_END);
+
+    ctSplitParse(&parts, ctSystem(), &splitLex, tokens, len, 4, 16);
+    CHECK(parts.workers == 4);
+
+    while (1) {
+        size_t errs = serial.err_idx;
+        CtAST *node = ctParse(&serial);
+
+        if (!node && serial.err_idx == errs)
+            break;
+
+        if (node) {
+            CHECK(count < parts.len);
+            CHECK(same(node, parts.nodes[count]));
+            count++;
+        }
+    }
+
+    CHECK(count == parts.len && count == 9999);
+    CHECK(serial.err_idx == 1 && parts.err_idx == 1);
+    CHECK(serial.errs[0].where.loc == parts.errs[0].where.loc);
+
+    /* through a ledger every worker counts on its own and it all adds up after the join */
+    ctLedgerAlloc(&ledger, ctSystem());
+    ctLedgerPhase(&ledger, CT_PHASE_PARSE);
+    ctSplitParse(&counted, ctLedgerTag(&ledger, CT_MEM_AST), &splitLex, tokens, len, 4, 16);
+
+    CHECK(counted.ledger == &ledger && counted.len == parts.len);
+    CHECK(ledger.kinds[CT_MEM_AST].current && !ledger.kinds[CT_MEM_DIAGNOSTICS].current);
+    CHECK(ledger.kinds[CT_MEM_DIAGNOSTICS].total && ledger.phases[CT_PHASE_PARSE].allocs);
+    CHECK(ledger.all.peak >= ledger.all.current);
+
+    ctSplitFree(&counted);
+    CHECK(ledger.all.current == 0);
+
+    ctSplitFree(&parts);
+    ctRelease(ctSystem(), tokens, sizeof(CtToken) * len);
+    ctParserFree(&serial);
+    ctLexerFree(&serialLex);
+    ctLexerFree(&splitLex);
+    ctArenaFree(&nodes);
+    ctSourcesFree(&serialSources);
+    ctSourcesFree(&splitSources);
+    ctBufferFree(buf);
+}
+
+int main(int argc, char **argv) {
+    char *text = generate(10000);
+    StringStream serialText = { NULL, 0 };
+    StringStream pipedText = { NULL, 0 };
+    CtSources serialSources = ctSourcesAlloc(ctSystem());
+    CtSources pipedSources = ctSourcesAlloc(ctSystem());
+    CtArena serialNodes = ctArenaAlloc(ctSystem(), 0x10000);
+    CtArena pipedNodes = ctArenaAlloc(ctSystem(), 0x10000);
+    CtLexer serialLex;
+    CtLexer pipedLex;
+    CtParser serial;
+    CtParser piped;
+    CtPipeline pipeline;
+    size_t count = 0;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    serialText.text = text;
+    pipedText.text = text;
+
+    serialLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &serialSources, "serial", &serialText, nextChar), 16);
+    pipedLex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &pipedSources, "piped", &pipedText, nextChar), 16);
+
+    serial = ctParserAlloc(&serialLex, &serialNodes.base, 16);
+    piped = ctParserAlloc(&pipedLex, &pipedNodes.base, 16);
+
+    CHECK(ctPipelineStart(&pipeline, &piped, 256));
+
+    while (1) {
+        CtAST *lhs = ctParse(&serial);
+        CtAST *rhs = ctParse(&piped);
+
+        CHECK(same(lhs, rhs));
+
+        if (!lhs)
+            break;
+
+        CHECK(lhs->kind == AK_BINARY && lhs->tok.data.key == K_SHL);
+        count++;
+    }
+
+    ctPipelineJoin(&pipeline);
+
+    CHECK(count == 10000);
+    CHECK(serial.err_idx == 0 && piped.err_idx == 0);
+    CHECK(serialLex.err_idx == 0 && pipedLex.err_idx == 0);
+
+    ctParserFree(&serial);
+    ctParserFree(&piped);
+    ctLexerFree(&serialLex);
+    ctLexerFree(&pipedLex);
+    ctArenaFree(&serialNodes);
+    ctArenaFree(&pipedNodes);
+    ctSourcesFree(&serialSources);
+    ctSourcesFree(&pipedSources);
+    free(text);
+
+    assoc();
+    speculate();
+    recover();
+    split();
+    deep();
+    push();
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cthulhu/cthulhu.c"
+
+typedef struct {
+    const char *text;
+    size_t idx;
+} StringStream;
+
+static char nextChar(void *ptr) {
+    StringStream *stream = ptr;
+    char c = stream->text[stream->idx];
+
+    if (c)
+        stream->idx++;
+
+    return c;
+}
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+#define DEFS 20000
+
+/* every function calls the next one so every lookup is a forward reference */
+static char *generate(void) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    char line[128];
+    char *out;
+    size_t i;
+
+    for (i = 0; i < DEFS; i++) {
+        sprintf(line, "def f%lu(a, b) = a + f%lu * b;\n", (unsigned long)i, (unsigned long)(i + 1) % DEFS);
+        ctAppend(&buf, line, strlen(line));
+    }
+
+    sprintf(line, "struct s { x: t; y: s; };\nalias t = s;\nenum e { a, b, c };\n");
+    ctAppend(&buf, line, strlen(line));
+    sprintf(line, "trait tr { def m(x); def n; };\nvar v = f0 + 1;\nv * 2;\n");
+    ctAppend(&buf, line, strlen(line));
+
+    out = malloc(buf.len + 1);
+    memcpy(out, ctAt(&buf, 0), buf.len);
+    out[buf.len] = '\0';
+
+    ctBufferFree(buf);
+    return out;
+}
+
+typedef struct {
+    StringStream text;
+    CtSources sources;
+    CtArena nodes;
+    CtLexer lex;
+    CtParser parser;
+    CtResolver resolver;
+    CtBuffer decls;
+} Module;
+
+static void moduleOpen(Module *self, const char *text) {
+    CtAST *node;
+
+    self->text.text = text;
+    self->text.idx = 0;
+
+    self->sources = ctSourcesAlloc(ctSystem());
+    self->nodes = ctArenaAlloc(ctSystem(), 0x10000);
+    self->lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &self->sources, "resolve", &self->text, nextChar), 8);
+    self->parser = ctParserAlloc(&self->lex, &self->nodes.base, 8);
+    self->resolver = ctResolverAlloc(&self->lex, ctSystem(), 8);
+    self->decls = ctBufferAlloc(ctSystem(), 0);
+
+    while ((node = ctParse(&self->parser)))
+        ctAppend(&self->decls, (const char*)&node, sizeof(CtAST*));
+
+    ctResolve(&self->resolver, (CtAST**)ctAt(&self->decls, 0), self->decls.len / sizeof(CtAST*));
+}
+
+static CtAST *moduleDecl(Module *self, size_t idx) {
+    return ((CtAST**)ctAt(&self->decls, 0))[idx];
+}
+
+static void moduleClose(Module *self) {
+    ctBufferFree(self->decls);
+    ctResolverFree(&self->resolver);
+    ctParserFree(&self->parser);
+    ctLexerFree(&self->lex);
+    ctArenaFree(&self->nodes);
+    ctSourcesFree(&self->sources);
+}
+
+int main(int argc, char **argv) {
+    char *text = generate();
+    Module module;
+    CtAST *def;
+    CtAST *body;
+    CtAST *record;
+    size_t i;
+
+    CT_UNUSED(argc);
+    CT_UNUSED(argv);
+
+    moduleOpen(&module, text);
+
+    CHECK(module.lex.err_idx == 0);
+    CHECK(module.parser.err_idx == 0);
+    CHECK(module.resolver.err_idx == 0);
+    CHECK(module.decls.len / sizeof(CtAST*) == DEFS + 6);
+
+    /* a + f(n + 1) * b */
+    for (i = 0; i < DEFS; i++) {
+        def = moduleDecl(&module, i);
+        body = def->data.decl.body;
+
+        CHECK(def->kind == AK_DEF && def->data.decl.len == 2);
+        CHECK(body->data.binary.lhs->data.target == def->data.decl.items[0]);
+        CHECK(body->data.binary.rhs->data.binary.lhs->data.target == moduleDecl(&module, (i + 1) % DEFS));
+        CHECK(body->data.binary.rhs->data.binary.rhs->data.target == def->data.decl.items[1]);
+    }
+
+    /* field types see the enclosing declarations, not the fields */
+    record = moduleDecl(&module, DEFS);
+    CHECK(record->kind == AK_STRUCT && record->data.decl.len == 2);
+    CHECK(record->data.decl.items[0]->data.decl.body->data.target == moduleDecl(&module, DEFS + 1));
+    CHECK(record->data.decl.items[1]->data.decl.body->data.target == record);
+    CHECK(moduleDecl(&module, DEFS + 2)->data.decl.len == 3);
+    CHECK(moduleDecl(&module, DEFS + 3)->data.decl.len == 2);
+    CHECK(moduleDecl(&module, DEFS + 5)->data.binary.lhs->data.target == moduleDecl(&module, DEFS + 4));
+
+    moduleClose(&module);
+    free(text);
+
+    /* params shadow globals, dont leak out of their scope, and cant repeat */
+    moduleOpen(&module, "def a = b;\ndef a = 1;\ndef p(x, x) = y;\ndef q(a) = a + x;\n");
+
+    CHECK(module.parser.err_idx == 0);
+    CHECK(module.resolver.err_idx == 5);
+    CHECK(module.resolver.errs[0].kind == ERR_REDEFINED_NAME);
+    CHECK(module.resolver.errs[1].kind == ERR_UNDEFINED_NAME);
+    CHECK(module.resolver.errs[2].kind == ERR_REDEFINED_NAME);
+    CHECK(module.resolver.errs[3].kind == ERR_UNDEFINED_NAME);
+    CHECK(module.resolver.errs[4].kind == ERR_UNDEFINED_NAME);
+
+    def = moduleDecl(&module, 3);
+    CHECK(def->data.decl.body->data.binary.lhs->data.target == def->data.decl.items[0]);
+
+    moduleClose(&module);
+
+    /* declarations need names */
+    moduleOpen(&module, "def 1 = 2;\n");
+    CHECK(module.parser.err_idx == 1 && module.parser.errs[0].kind == ERR_EXPECTED_NAME);
+    moduleClose(&module);
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "cthulhu/cthulhu.c"
+
+/**
+ * lexes and parses adversarial inputs at 1x, 2x, 4x ... 1024x their
+ * base size and fits how time and peak memory grow against size.
+ * anything growing faster than linear fails, so a quadratic path
+ * shows up here long before it shows up on a real input
+ */
+
+#define STEPS 11
+
+/* the most time and memory may grow per doubling, as log2 */
+#define MAX_TIME 1.35
+#define MAX_MEMORY 1.15
+
+/* only sizes from here up are fitted, below it fixed costs dominate */
+#define FIT_FROM 4
+
+/* memory is counted in arena chunks, so less than a few of them is noise */
+#define ARENA_CHUNK 0x1000
+#define MIN_BYTES (ARENA_CHUNK * 4)
+
+/* a point is timed over at least this many clocks, best of REPEATS */
+#define MIN_CLOCKS (CLOCKS_PER_SEC / 50)
+#define REPEATS 3
+
+typedef struct {
+    const char *name;
+
+    /* units at 1x, a unit is what one call to part writes */
+    size_t base;
+
+    const char *head;
+    const char *part;
+    const char *tail;
+} Shape;
+
+static const Shape shapes[] = {
+    { "statements", 256, "", "a + 1;\n", "" },
+    { "identifier", 1024, "", "x", ";\n" },
+    { "literal", 1024, "1", "0", ";\n" },
+    { "string", 1024, "\"", "a", "\";\n" },
+    { "comment", 1024, "#", "c", "\n1;\n" },
+    { "nesting", 256, "", "(", "1" },
+    { "chain", 256, "a", " + a", ";\n" },
+    { "assign", 256, "a", " = a", ";\n" },
+    { "errors", 256, "", "+ $;\n", "" }
+};
+
+#define LEN(arr) (sizeof(arr) / sizeof(*arr))
+
+/* log2 to a few decimal places, enough to tell n from n log n from n^2 */
+static double log2Of(double x) {
+    double out = 0;
+    double bit = 1;
+
+    if (x <= 0)
+        return 0;
+
+    while (x >= 2) {
+        x /= 2;
+        out += 1;
+    }
+
+    while (x < 1) {
+        x *= 2;
+        out -= 1;
+    }
+
+    while (bit > 1e-6) {
+        x *= x;
+        bit /= 2;
+
+        if (x >= 2) {
+            x /= 2;
+            out += bit;
+        }
+    }
+
+    return out;
+}
+
+/* least squares slope of log2 y against log2 x */
+static double slope(const double *x, const double *y, size_t len) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        double lx = log2Of(x[i]);
+        double ly = log2Of(y[i]);
+
+        sx += lx;
+        sy += ly;
+        sxx += lx * lx;
+        sxy += lx * ly;
+    }
+
+    return (len * sxy - sx * sy) / (len * sxx - sx * sx);
+}
+
+static char *generate(const Shape *shape, size_t units, size_t *len) {
+    CtBuffer buf = ctBufferAlloc(ctSystem(), 0);
+    char *out;
+    size_t i;
+
+    ctAppend(&buf, shape->head, strlen(shape->head));
+
+    for (i = 0; i < units; i++)
+        ctAppend(&buf, shape->part, strlen(shape->part));
+
+    /* nesting closes everything it opened */
+    if (shape->part[0] == '(') {
+        ctAppend(&buf, shape->tail, strlen(shape->tail));
+        for (i = 0; i < units; i++)
+            ctPush(&buf, ')');
+        ctAppend(&buf, ";\n", 2);
+    } else {
+        ctAppend(&buf, shape->tail, strlen(shape->tail));
+    }
+
+    *len = buf.len;
+    out = malloc(buf.len + 1);
+    memcpy(out, ctAt(&buf, 0), buf.len);
+    out[buf.len] = '\0';
+
+    ctBufferFree(buf);
+    return out;
+}
+
+/* lex and parse everything, returns the peak number of bytes in use */
+static size_t frontend(const char *text, size_t len) {
+    CtCounter counter = ctCounterAlloc(ctSystem());
+    CtArena nodes = ctArenaAlloc(&counter.base, ARENA_CHUNK);
+    CtMemory memory = ctMemory(text, len);
+    CtSources sources = ctSourcesAlloc(&counter.base);
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(&counter.base, &sources, "scale", &memory, ctMemoryNext), 4);
+    CtParser parser = ctParserAlloc(&lex, &nodes.base, 4);
+
+    while (1) {
+        size_t errs = parser.err_idx + lex.reported;
+
+        if (!ctParse(&parser) && parser.err_idx + lex.reported == errs)
+            break;
+
+        /* only the newest errors are interesting */
+        parser.err_idx = 0;
+    }
+
+    ctParserFree(&parser);
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+    ctArenaFree(&nodes);
+
+    return counter.peak;
+}
+
+/* best of REPEATS, each repeating the run until it is long enough to time */
+static double measure(const char *text, size_t len) {
+    double best = 0;
+    size_t i;
+
+    for (i = 0; i < REPEATS; i++) {
+        clock_t start = clock();
+        clock_t elapsed;
+        size_t runs = 0;
+        double each;
+
+        do {
+            frontend(text, len);
+            runs++;
+        } while ((elapsed = clock() - start) < MIN_CLOCKS);
+
+        each = (double)elapsed / runs;
+        if (i == 0 || each < best)
+            best = each;
+    }
+
+    return best;
+}
+
+static bool series(const Shape *shape) {
+    double sizes[STEPS];
+    double times[STEPS];
+    double bytes[STEPS];
+    size_t empty = frontend("", 0);
+    double time;
+    double memory = 0;
+    size_t from = STEPS;
+    size_t i;
+
+    for (i = 0; i < STEPS; i++) {
+        size_t len;
+        char *text = generate(shape, shape->base << i, &len);
+
+        sizes[i] = (double)len;
+        times[i] = measure(text, len);
+
+        /* the buffers every run starts with arent part of the growth */
+        bytes[i] = (double)(frontend(text, len) - empty);
+
+        if (i >= FIT_FROM && from == STEPS && bytes[i] >= MIN_BYTES)
+            from = i;
+
+        free(text);
+    }
+
+    time = slope(sizes + FIT_FROM, times + FIT_FROM, STEPS - FIT_FROM);
+
+    /* memory that stays inside a few chunks the whole way is flat */
+    if (STEPS - from >= 3)
+        memory = slope(sizes + from, bytes + from, STEPS - from);
+
+    printf("%-12s %9lu bytes at 1024x, time n^%.2f, memory n^%.2f\n",
+        shape->name, (unsigned long)sizes[STEPS - 1], time, memory);
+
+    return time <= MAX_TIME && memory <= MAX_MEMORY;
+}
+
+int main(int argc, char **argv) {
+    bool ok = true;
+    size_t i;
+
+    for (i = 0; i < LEN(shapes); i++) {
+        /* run one shape by name */
+        if (argc > 1 && strcmp(argv[1], shapes[i].name) != 0)
+            continue;
+
+        if (!series(shapes + i)) {
+            fprintf(stderr, "%s grows faster than linear\n", shapes[i].name);
+            ok = false;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "cti/cti.h"
+
+/**
+ * runs the compile server in a child and talks to it over its
+ * socket the way cti-client does, one request and one reply a line.
+ * built with the cti sources rather than including them
+ */
+
+#define SOCKET "server-test.sock"
+#define MODULE "server-test.ct"
+
+#define PIPELINED 50000
+
+static void check(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "check failed: %s\n", what);
+        exit(1);
+    }
+}
+
+#define CHECK(expr) check(expr, #expr)
+
+/* the server may still be starting up */
+static int connectTo(const char *path) {
+    struct sockaddr_un addr;
+    int tries;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    for (tries = 0; tries < 500; tries++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        CHECK(fd >= 0);
+
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0)
+            return fd;
+
+        close(fd);
+        usleep(10000);
+    }
+
+    CHECK(!"server never came up");
+    return -1;
+}
+
+static void readLine(int fd, char *got, size_t size) {
+    size_t len = 0;
+
+    while (len < size - 1) {
+        CHECK(read(fd, got + len, 1) == 1);
+
+        if (got[len] == '\n')
+            break;
+
+        len++;
+    }
+
+    got[len] = '\0';
+}
+
+static void expect(int fd, const char *line, const char *reply) {
+    char got[256];
+
+    CHECK(write(fd, line, strlen(line)) == (ssize_t)strlen(line) && write(fd, "\n", 1) == 1);
+    readLine(fd, got, sizeof(got));
+
+    if (strcmp(got, reply) != 0) {
+        fprintf(stderr, "%s: expected `%s` got `%s`\n", line, reply, got);
+        exit(1);
+    }
+}
+
+static void writeFile(const char *path, const char *text) {
+    FILE *file = fopen(path, "wb");
+
+    CHECK(file != NULL);
+    CHECK(fwrite(text, 1, strlen(text), file) == strlen(text));
+    CHECK(fclose(file) == 0);
+}
+
+/**
+ * a child sends every request before anything is read back, far
+ * more than both socket buffers hold. the server has to keep
+ * answering everyone else meanwhile, then answer all of them
+ */
+static void pipelined(int fd) {
+    int bulk = connectTo(SOCKET);
+    pid_t writer = fork();
+    char line[64];
+    char got[64];
+    int status;
+    int i;
+
+    CHECK(writer >= 0);
+
+    if (writer == 0) {
+        for (i = 0; i < PIPELINED; i++) {
+            sprintf(line, "eval %d + 1\n", i);
+            CHECK(write(bulk, line, strlen(line)) == (ssize_t)strlen(line));
+        }
+
+        shutdown(bulk, SHUT_WR);
+        exit(0);
+    }
+
+    usleep(100000);
+    expect(fd, "eval 6 * 7", "ok 42");
+
+    for (i = 0; i < PIPELINED; i++) {
+        sprintf(line, "ok %d", i + 1);
+        readLine(bulk, got, sizeof(got));
+        CHECK(strcmp(got, line) == 0);
+    }
+
+    /* everything was answered so the server hangs up */
+    CHECK(read(bulk, got, 1) == 0);
+    close(bulk);
+
+    CHECK(waitpid(writer, &status, 0) == writer);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+int main(void) {
+    pid_t pid;
+    int status;
+    int fd;
+
+    /* only a socket is ever replaced */
+    writeFile(MODULE, "1;\n");
+    CHECK(ctiServe(MODULE) == 1);
+    CHECK(remove(MODULE) == 0);
+
+    pid = fork();
+    CHECK(pid >= 0);
+
+    if (pid == 0)
+        exit(ctiServe(SOCKET));
+
+    fd = connectTo(SOCKET);
+
+    /* values are exact and comparisons mean what they say */
+    expect(fd, "eval 1 + 2", "ok 3");
+    expect(fd, "eval 1 + 2;", "ok 3");
+    expect(fd, "eval 3 > 2", "ok 1");
+    expect(fd, "eval 2 <= 3", "ok 1");
+    expect(fd, "eval 99999999999999999999999 + 1", "ok 100000000000000000000000");
+    expect(fd, "eval 0x7FFFFFFFFFFFFFFF + 1", "ok 9223372036854775808");
+    expect(fd, "eval 1 / 0", "error eval:1:3: division by zero");
+    expect(fd, "eval 1 $ 3", "error eval:1:3: invalid symbol");
+
+    /* only a single expression has a value */
+    expect(fd, "eval def f(a) = a + 1", "error expected one expression");
+    expect(fd, "eval var x = 1", "error expected one expression");
+    expect(fd, "eval 1; 2", "error expected one expression");
+
+    /* repeats come from the cache and answer the same */
+    expect(fd, "eval 1 + 2", "ok 3");
+    expect(fd, "eval def f(a) = a + 1", "error expected one expression");
+
+    /* rewrites inside the same second at the same size are still seen */
+    writeFile(MODULE, "1;\n");
+    expect(fd, "check " MODULE, "ok 1");
+    writeFile(MODULE, "$;\n");
+    expect(fd, "check " MODULE, "error " MODULE ":1:1: invalid symbol");
+    writeFile(MODULE, "2;\n");
+    expect(fd, "check " MODULE, "ok 1");
+
+    expect(fd, "stats", "ok exprs 11 modules 1 hits 2 misses 14");
+
+    pipelined(fd);
+    expect(fd, "bogus", "error unknown request");
+    expect(fd, "stop", "ok");
+
+    close(fd);
+    remove(MODULE);
+
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cthulhu/cthulhu.c"
+
+/**
+ * the C half of com/tests/Conform.java
+ *
+ * tokens <file>            print one normalized token per line
+ * tokens --bench <file> N  lex the file N times and print throughput
+ *
+ * the normalized form is shared with the java side, so only print
+ * what both lexers can agree on
+ */
+
+static const char *spellings[] = {
+#define KEY(id, str, flags) str,
+#define OP(id, str, prec, flags) str,
+#include "cthulhu/keys.h"
+    ""
+};
+
+static char *readFile(const char *path, size_t *len) {
+    FILE *file = fopen(path, "rb");
+    char *text;
+    long size;
+
+    if (!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    text = malloc(size > 0 ? (size_t)size : 1);
+    *len = text ? fread(text, 1, (size_t)size, file) : 0;
+    fclose(file);
+
+    return text;
+}
+
+/* c89 has no long long printf */
+static void printNum(uint64_t num) {
+    char digits[24];
+    size_t len = 0;
+
+    do {
+        digits[len++] = (char)('0' + num % 10);
+        num /= 10;
+    } while (num);
+
+    while (len)
+        putchar(digits[--len]);
+}
+
+static void printBig(CtDigit digit) {
+    CtBuffer text = ctBufferAlloc(ctSystem(), 64);
+    CtNum num;
+
+    num.value = (CtInt)digit.num;
+    num.big = digit.big;
+
+    ctNumDecimal(num, &text);
+    printf("int %.*s\n", (int)ctOffset(&text), (const char*)ctAt(&text, 0));
+
+    ctBufferFree(text);
+}
+
+static void dump(const char *text, size_t len) {
+    CtMemory memory = ctMemory(text, len);
+    CtSources sources = ctSourcesAlloc(ctSystem());
+    CtLexer lex = ctLexerAlloc(ctStreamAlloc(ctSystem(), &sources, "tokens", &memory, ctMemoryNext), 1);
+    CtToken tok;
+
+    do {
+        lex.err_idx = 0;
+        tok = ctLex(&lex);
+
+        switch (tok.kind) {
+        case TK_END:
+            puts("end");
+            break;
+        case TK_IDENT:
+            printf("ident %.*s\n", (int)tok.data.ident.len, ctIdent(&lex, tok.data.ident));
+            break;
+        case TK_STRING:
+            puts("string");
+            break;
+        case TK_INT:
+        case TK_CHAR:
+            if (lex.err_idx && lex.errs[0].kind == ERR_OVERFLOW) {
+                puts("int overflow");
+            } else if (tok.kind == TK_INT && tok.data.digit.big) {
+                printBig(tok.data.digit);
+            } else {
+                fputs("int ", stdout);
+                printNum(tok.kind == TK_INT ? tok.data.digit.num : (uint8_t)tok.data.letter);
+                putchar('\n');
+            }
+            break;
+        case TK_KEY:
+            if (tok.data.key == K_INVALID) {
+                puts("invalid");
+            } else {
+                printf("key %s\n", spellings[tok.data.key]);
+            }
+            break;
+        default:
+            puts("invalid");
+            break;
+        }
+    } while (tok.kind != TK_END);
+
+    ctLexerFree(&lex);
+    ctSourcesFree(&sources);
+}
+
+static void bench(const char *text, size_t len, size_t reps) {
+    CtCounter counter = ctCounterAlloc(ctSystem());
+    size_t tokens = 0;
+    clock_t start = clock();
+    double elapsed;
+    size_t i;
+
+    for (i = 0; i < reps; i++) {
+        CtMemory memory = ctMemory(text, len);
+        CtSources sources = ctSourcesAlloc(&counter.base);
+        CtLexer lex = ctLexerAlloc(ctStreamAlloc(&counter.base, &sources, "tokens", &memory, ctMemoryNext), 1);
+
+        while (ctLex(&lex).kind != TK_END)
+            tokens++;
+
+        ctLexerFree(&lex);
+        ctSourcesFree(&sources);
+    }
+
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("c: %lu tokens, %.1f MB/s, %.4f allocs/token, %.2f bytes/token\n",
+        (unsigned long)tokens,
+        elapsed > 0 ? (double)len * reps / elapsed / 1e6 : 0.0,
+        tokens ? (double)counter.allocs / tokens : 0.0,
+        tokens ? (double)counter.total / tokens : 0.0
+    );
+}
+
+int main(int argc, char **argv) {
+    bool timed = argc > 1 && strcmp(argv[1], "--bench") == 0;
+    const char *path = argv[timed ? 2 : 1];
+    char *text;
+    size_t len;
+
+    if (argc < (timed ? 3 : 2) || !(text = readFile(path, &len))) {
+        fprintf(stderr, "usage: tokens [--bench] <file> [reps]\n");
+        return 1;
+    }
+
+    if (timed) {
+        bench(text, len, argc > 3 ? (size_t)atol(argv[3]) : 1);
+    } else {
+        dump(text, len);
+    }
+
+    free(text);
+    return 0;
+}